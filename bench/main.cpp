@@ -0,0 +1,564 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+//
+//	Include files
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <numeric>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <argparse/argparse.hpp>
+
+#include "fmt/format.h"
+#include "nlohmann/json.hpp"
+
+#include "OtCompiler.h"
+#include "OtConfig.h"
+#include "OtException.h"
+#include "OtFunction.h"
+#include "OtHttpRequest.h"
+#include "OtHttpResponse.h"
+#include "OtLibuv.h"
+#include "OtLog.h"
+#include "OtModule.h"
+#include "OtMpmcQueue.h"
+#include "OtPath.h"
+#include "OtPathObject.h"
+#include "OtSource.h"
+#include "OtSpscQueue.h"
+#include "OtText.h"
+#include "OtVM.h"
+
+
+//
+//	ObjectTalk benchmark runner
+//
+//	Every script in the benchmark directories is a benchmark that is named
+//	after its directory and its stem (e.g. "micro/dispatch"). Scripts set up
+//	their data when they are loaded and define a "run" function that does one
+//	round of work. Scripts can also define "operations" (the number of
+//	operations in a round) to get the time per operation. The runner does one
+//	round to warm up and then times the requested number of rounds.
+//
+//	Names must stay stable as they are used to compare results between releases.
+//
+
+
+//
+//	Benchmark results
+//
+
+struct OtBenchResult {
+	std::string name;
+	int64_t operations = 0;
+	std::vector<double> times; // in milliseconds
+
+	double min() const { return *std::min_element(times.begin(), times.end()); }
+	double mean() const { return std::accumulate(times.begin(), times.end(), 0.0) / static_cast<double>(times.size()); }
+
+	double median() const {
+		auto sorted = times;
+		std::sort(sorted.begin(), sorted.end());
+		auto middle = sorted.size() / 2;
+		return sorted.size() % 2 ? sorted[middle] : (sorted[middle - 1] + sorted[middle]) / 2.0;
+	}
+
+	double stddev() const {
+		auto average = mean();
+		double sum = 0.0;
+
+		for (auto time : times) {
+			sum += (time - average) * (time - average);
+		}
+
+		return std::sqrt(sum / static_cast<double>(times.size()));
+	}
+};
+
+
+//
+//	Helpers for benchmark scripts
+//
+//	The "bench" module creates HTTP requests and responses so routers can be
+//	benchmarked without sockets. Responses are written to a pipe that is
+//	drained between rounds.
+//
+
+static uv_pipe_t responseReader;
+static uv_pipe_t responseWriter;
+static bool responsePipeOpen = false;
+
+static uv_stream_t* getResponseStream() {
+	if (!responsePipeOpen) {
+		uv_file fds[2];
+		auto status = uv_pipe(fds, UV_NONBLOCK_PIPE, UV_NONBLOCK_PIPE);
+		UV_CHECK_ERROR("uv_pipe", status);
+
+		uv_pipe_init(OtLibUv::getLoop(), &responseReader, 0);
+		uv_pipe_open(&responseReader, fds[0]);
+		uv_pipe_init(OtLibUv::getLoop(), &responseWriter, 0);
+		uv_pipe_open(&responseWriter, fds[1]);
+
+		status = uv_read_start(
+			reinterpret_cast<uv_stream_t*>(&responseReader),
+			[]([[maybe_unused]] uv_handle_t* handle, [[maybe_unused]] size_t size, uv_buf_t* buffer) {
+				static char data[65536];
+				*buffer = uv_buf_init(data, sizeof(data));
+			},
+			[]([[maybe_unused]] uv_stream_t* stream, [[maybe_unused]] ssize_t nread, [[maybe_unused]] const uv_buf_t* buffer) {});
+
+		UV_CHECK_ERROR("uv_read_start", status);
+		responsePipeOpen = true;
+	}
+
+	return reinterpret_cast<uv_stream_t*>(&responseWriter);
+}
+
+static void drainResponses() {
+	auto loop = OtLibUv::getLoop();
+
+	// complete all pending I/O (which also runs the cycle collector)
+	uv_run(loop, UV_RUN_NOWAIT);
+
+	while (responsePipeOpen && responseWriter.write_queue_size) {
+		uv_run(loop, UV_RUN_NOWAIT);
+	}
+
+	uv_run(loop, UV_RUN_NOWAIT);
+}
+
+static OtObject createRequest(const std::string& method, const std::string& url) {
+	// feed the request the same events the HTTP parser would
+	static const std::string host = "Host";
+	static const std::string localhost = "localhost";
+
+	auto request = OtHttpRequest::create();
+	request->clear();
+	request->onURL(url.data(), url.size());
+	request->onHeaderField(host.data(), host.size());
+	request->onHeaderValue(localhost.data(), localhost.size());
+	request->onHeadersComplete(method, "HTTP/1.1");
+	request->onMessageComplete();
+	return request;
+}
+
+static OtObject createResponse() {
+	auto response = OtHttpResponse::create();
+	response->setStream(getResponseStream());
+	response->clear();
+	return response;
+}
+
+static OtModuleRegistration registration{"bench", [](OtModule module) {
+	module->set("request", OtFunction::create(&createRequest));
+	module->set("response", OtFunction::create(&createResponse));
+}};
+
+
+//
+//	Measure a benchmark
+//
+
+static OtBenchResult measure(const std::string& name, int64_t operations, size_t rounds, std::function<void()> round) {
+	OtBenchResult result{name, operations, {}};
+
+	// warm up (caches, shapes and allocators)
+	round();
+	drainResponses();
+
+	for (size_t i = 0; i < rounds; i++) {
+		auto start = std::chrono::steady_clock::now();
+		round();
+		auto end = std::chrono::steady_clock::now();
+		result.times.emplace_back(std::chrono::duration<double, std::milli>(end - start).count());
+
+		// I/O is completed outside the timed section
+		drainResponses();
+	}
+
+	return result;
+}
+
+
+//
+//	Measure queue contention
+//
+//	Producers each push their share of the items and consumers pop until all
+//	items are taken. Threads yield when the queue is full or empty.
+//
+
+static constexpr size_t queueItems = 1 << 18;
+static constexpr size_t queueBatch = 64;
+
+template <typename PRODUCE, typename CONSUME>
+static void runQueue(size_t producers, size_t consumers, PRODUCE produce, CONSUME consume) {
+	std::atomic<size_t> consumed{0};
+	std::vector<std::thread> threads;
+
+	for (size_t i = 0; i < producers; i++) {
+		threads.emplace_back([&, i]() {
+			produce(i, queueItems / producers);
+		});
+	}
+
+	for (size_t i = 0; i < consumers; i++) {
+		threads.emplace_back([&]() {
+			while (consumed.load(std::memory_order_relaxed) < queueItems) {
+				if (auto count = consume()) {
+					consumed.fetch_add(count, std::memory_order_relaxed);
+
+				} else {
+					std::this_thread::yield();
+				}
+			}
+		});
+	}
+
+	for (auto& thread : threads) {
+		thread.join();
+	}
+}
+
+static void measureQueues(const std::string& filter, size_t rounds, std::function<void(const OtBenchResult&)> report) {
+	auto operations = static_cast<int64_t>(queueItems);
+
+	if (OtText::contains("micro/queue-spsc", filter)) {
+		OtSpscQueue<size_t> queue(1024);
+
+		report(measure("micro/queue-spsc", operations, rounds, [&]() {
+			runQueue(1, 1,
+				[&](size_t, size_t count) {
+					for (size_t i = 0; i < count; i++) {
+						while (!queue.tryPush(i)) {
+							std::this_thread::yield();
+						}
+					}
+				},
+				[&]() {
+					size_t value;
+					return queue.tryPop(value) ? size_t(1) : size_t(0);
+				});
+		}));
+	}
+
+	if (OtText::contains("micro/queue-spsc-batch", filter)) {
+		OtSpscQueue<size_t> queue(1024);
+
+		report(measure("micro/queue-spsc-batch", operations, rounds, [&]() {
+			runQueue(1, 1,
+				[&](size_t, size_t count) {
+					size_t values[queueBatch];
+
+					for (size_t i = 0; i < count; i += queueBatch) {
+						auto size = std::min(queueBatch, count - i);
+						size_t pushed = 0;
+
+						for (size_t j = 0; j < size; j++) {
+							values[j] = i + j;
+						}
+
+						while ((pushed += queue.pushN(values + pushed, size - pushed)) < size) {
+							std::this_thread::yield();
+						}
+					}
+				},
+				[&]() {
+					size_t values[queueBatch];
+					return queue.popN(values, queueBatch);
+				});
+		}));
+	}
+
+	if (OtText::contains("micro/queue-mpmc", filter)) {
+		OtMpmcQueue<size_t> queue(1024);
+
+		report(measure("micro/queue-mpmc", operations, rounds, [&]() {
+			runQueue(4, 4,
+				[&](size_t, size_t count) {
+					for (size_t i = 0; i < count; i++) {
+						while (!queue.tryPush(i)) {
+							std::this_thread::yield();
+						}
+					}
+				},
+				[&]() {
+					size_t value;
+					return queue.tryPop(value) ? size_t(1) : size_t(0);
+				});
+		}));
+	}
+
+	// the baseline (a queue behind a mutex)
+	if (OtText::contains("micro/queue-mutex", filter)) {
+		std::mutex mutex;
+		std::queue<size_t> queue;
+
+		report(measure("micro/queue-mutex", operations, rounds, [&]() {
+			runQueue(4, 4,
+				[&](size_t, size_t count) {
+					for (size_t i = 0; i < count; i++) {
+						std::lock_guard<std::mutex> lock(mutex);
+						queue.push(i);
+					}
+				},
+				[&]() {
+					std::lock_guard<std::mutex> lock(mutex);
+
+					if (queue.empty()) {
+						return size_t(0);
+					}
+
+					queue.pop();
+					return size_t(1);
+				});
+		}));
+	}
+}
+
+
+//
+//	Find the benchmark scripts
+//
+
+static std::vector<std::string> findScripts(const std::vector<std::string>& paths) {
+	std::vector<std::string> scripts;
+
+	for (auto& path : paths) {
+		if (OtPath::isDirectory(path)) {
+			std::vector<std::string> found;
+
+			for (auto& entry : std::filesystem::directory_iterator(path)) {
+				if (entry.is_regular_file() && entry.path().extension() == ".ot") {
+					found.emplace_back(entry.path().string());
+				}
+			}
+
+			std::sort(found.begin(), found.end());
+			scripts.insert(scripts.end(), found.begin(), found.end());
+
+		} else if (OtPath::isRegularFile(path)) {
+			scripts.emplace_back(path);
+
+		} else {
+			OtLogFatal("Can't find benchmark [{}]", path);
+		}
+	}
+
+	return scripts;
+}
+
+
+//
+//	Get a benchmark's name
+//
+
+static std::string getName(const std::string& script) {
+	auto directory = OtPath::getFilename(OtPath::getParent(OtPath::getCanonical(script)));
+	return directory + "/" + OtPath::getStem(script);
+}
+
+
+//
+//	Write the results
+//
+
+static void writeResults(const std::string& path, size_t rounds, const std::vector<OtBenchResult>& results) {
+	// describe the system (so results from different machines aren't confused)
+	uv_utsname_t uname;
+	uv_os_uname(&uname);
+
+	auto now = std::time(nullptr);
+	char date[32];
+	std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+	auto benchmarks = nlohmann::json::array();
+
+	for (auto& result : results) {
+		nlohmann::json benchmark = {
+			{"name", result.name},
+			{"rounds", result.times.size()},
+			{"min", result.min()},
+			{"median", result.median()},
+			{"mean", result.mean()},
+			{"stddev", result.stddev()}
+		};
+
+		if (result.operations) {
+			benchmark["operations"] = result.operations;
+			benchmark["nsPerOperation"] = result.median() * 1000000.0 / static_cast<double>(result.operations);
+		}
+
+		benchmarks.push_back(benchmark);
+	}
+
+	nlohmann::json data = {
+		{"format", 1},
+		{"date", date},
+		{"unit", "ms"},
+		{"rounds", rounds},
+		{"system", {
+			{"os", uname.sysname},
+			{"release", uname.release},
+			{"machine", uname.machine},
+			{"cores", uv_available_parallelism()}
+		}},
+		{"benchmarks", benchmarks}
+	};
+
+	std::ofstream stream(path);
+
+	if (!stream) {
+		OtLogFatal("Can't write benchmark results to [{}]", path);
+	}
+
+	stream << data.dump(1, '\t') << '\n';
+}
+
+
+//
+//	ObjectTalk benchmark main function
+//
+
+int main(int argc, char* argv[]) {
+	// parse all command line parameters
+	argparse::ArgumentParser program("otbench", "0.4");
+	std::string outputFile;
+	std::string filter;
+	bool jitFlag = false;
+
+	program.add_argument("-o", "--output")
+		.help("file to write the results (in JSON format) to")
+		.metavar("filename")
+		.default_value(std::string("bench.json"))
+		.store_into(outputFile);
+
+	program.add_argument("-r", "--rounds")
+		.help("number of timed rounds per benchmark")
+		.metavar("count")
+		.default_value(10)
+		.scan<'i', int>();
+
+	program.add_argument("-f", "--filter")
+		.help("only run benchmarks whose name contains this text")
+		.metavar("text")
+		.default_value(std::string())
+		.store_into(filter);
+
+	program.add_argument("-j", "--jit")
+		.help("run the benchmarks with the just-in-time compiler")
+		.store_into(jitFlag);
+
+	program.add_argument("paths")
+		.help("benchmark scripts or directories with benchmark scripts")
+		.remaining();
+
+	try {
+		program.parse_args(argc, argv);
+
+	} catch (const std::runtime_error& err) {
+		OtLogFatal(err.what());
+	}
+
+	std::vector<std::string> paths;
+
+	try {
+		paths = program.get<std::vector<std::string>>("paths");
+
+	} catch (std::logic_error& e) {
+		paths = {OtPath::join(OT_BENCH_DIR, "micro"), OtPath::join(OT_BENCH_DIR, "macro")};
+	}
+
+	auto rounds = static_cast<size_t>(std::max(program.get<int>("--rounds"), 1));
+	OtConfig::setJit(jitFlag);
+	auto scripts = findScripts(paths);
+	std::vector<OtBenchResult> results;
+
+	auto report = [&](const OtBenchResult& result) {
+		std::cout << fmt::format(
+			"{:<24} {:>10.3f} {:>10.3f} {:>10.3f} {:>7.1f}%\n",
+			result.name, result.min(), result.median(), result.mean(),
+			100.0 * result.stddev() / result.mean());
+
+		results.emplace_back(result);
+	};
+
+	try {
+		OtLibUv::init(argc, argv);
+		std::cout << fmt::format("{:<24} {:>10} {:>10} {:>10} {:>8}\n", "benchmark", "min (ms)", "median", "mean", "stddev");
+
+		// run the scripts
+		for (auto& script : scripts) {
+			auto name = getName(script);
+
+			if (OtText::contains(name, filter)) {
+				auto module = OtModule::create();
+				module->load(script);
+
+				if (!module->hasByName("run")) {
+					OtLogFatal("Benchmark [{}] doesn't have a [run] function", script);
+				}
+
+				auto run = module->getByName("run");
+				auto operations = module->hasByName("operations") ? module->getByName("operations")->operator int64_t() : 0;
+
+				report(measure(name, operations, rounds, [&]() {
+					OtVM::callMemberFunction(run, "__call__");
+				}));
+
+				module->unsetAll();
+			}
+		}
+
+		// measure the compiler (on the benchmark scripts themselves)
+		if (OtText::contains("micro/compile", filter) && scripts.size()) {
+			std::vector<std::pair<std::string, std::string>> sources;
+
+			for (auto& script : scripts) {
+				std::string text;
+				OtText::load(script, text);
+				sources.emplace_back(script, text);
+			}
+
+			report(measure("micro/compile", static_cast<int64_t>(sources.size()), rounds, [&]() {
+				for (auto& [path, text] : sources) {
+					// scripts can refer to their location (the module loader normally provides it)
+					auto module = OtModule::create();
+					module->set("__FILE__", OtPathObject::create(path));
+					module->set("__DIR__", OtPathObject::create(OtPath::getParent(path)));
+
+					OtCompiler compiler;
+					compiler.compileSource(OtSourceClass::create(path, text), module);
+				}
+			}));
+		}
+
+		// measure the queues
+		measureQueues(filter, rounds, report);
+
+		OtLibUv::end();
+
+	} catch (const OtException& e) {
+		OtLogFatal("Error: {}", e.what());
+	}
+
+	writeResults(outputFile, rounds, results);
+	return 0;
+}
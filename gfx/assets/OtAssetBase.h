@@ -12,6 +12,7 @@
 //	Include files
 //
 
+#include <cstdint>
 #include <functional>
 #include <string>
 
@@ -108,8 +109,9 @@ private:
 	// reference count
 	size_t references = 0;
 
-	// loader event handling
+	// loader event handling (and the trace flow that follows a load)
 	uv_async_t* loaderEventHandle = nullptr;
+	uint64_t loaderTraceFlow = 0;
 
 	// follower to detect file system changes
 	OtPathFollower follower;
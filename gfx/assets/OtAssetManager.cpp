@@ -19,6 +19,7 @@
 
 #include "OtAssetManager.h"
 #include "OtPath.h"
+#include "OtTrace.h"
 
 
 //
@@ -133,6 +134,8 @@ void OtAssetManager::scheduleLoad(OtAssetBase* asset) {
 	auto status = uv_async_init(uv_default_loop(), asset->loaderEventHandle, [](uv_async_t* handle){
 		// were we succesful?
 		auto asset = (OtAssetBase*) handle->data;
+		OtTraceZone("asset loaded", asset->getPath());
+		OtTrace::flowEnd("load asset", asset->loaderTraceFlow);
 
 		if (asset->isReady()) {
 			// yes, notify subscribers
@@ -153,7 +156,13 @@ void OtAssetManager::scheduleLoad(OtAssetBase* asset) {
 	asset->state = OtAssetBase::State::loading;
 	loading++;
 
+	asset->loaderTraceFlow = OtTrace::newFlow();
+	OtTrace::flowStart("load asset", asset->loaderTraceFlow);
+
 	threadpool.detach_task([this, asset]() {
+		OtTrace::setThreadName("asset loader");
+		OtTraceZone("load asset", asset->getPath());
+		OtTrace::flowStep("load asset", asset->loaderTraceFlow);
 		asset->errorMessage.clear();
 		asset->state = asset->load();
 		loading--;
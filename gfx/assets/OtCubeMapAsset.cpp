@@ -68,6 +68,7 @@ OtAssetBase::State OtCubeMapAsset::load() {
 
 	} catch ([[maybe_unused]] const OtException& exception) {
 		errorMessage = exception.what();
+		OtLogCaughtError("Can't load cubemap [{}]: {}", path, errorMessage);
 		return State::invalid;
 	}
 }
@@ -27,6 +27,7 @@ OtAssetBase::State OtFontAsset::load() {
 
 	} catch ([[maybe_unused]] const OtException& exception) {
 		errorMessage = exception.what();
+		OtLogCaughtError("Can't load font [{}]: {}", path, errorMessage);
 		return State::invalid;
 	}
 }
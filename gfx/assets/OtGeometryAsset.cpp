@@ -27,6 +27,7 @@ OtAssetBase::State OtGeometryAsset::load() {
 
 	} catch ([[maybe_unused]] const OtException& exception) {
 		errorMessage = exception.what();
+		OtLogCaughtError("Can't load geometry [{}]: {}", path, errorMessage);
 		return State::invalid;
 	}
 }
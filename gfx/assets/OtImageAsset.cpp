@@ -27,6 +27,7 @@ OtAssetBase::State OtImageAsset::load() {
 
 	} catch ([[maybe_unused]] const OtException& exception) {
 		errorMessage = exception.what();
+		OtLogCaughtError("Can't load image [{}]: {}", path, errorMessage);
 		return State::invalid;
 	}
 }
@@ -27,6 +27,7 @@ OtAssetBase::State OtInstancesAsset::load() {
 
 	} catch ([[maybe_unused]] const OtException& exception) {
 		errorMessage = exception.what();
+		OtLogCaughtError("Can't load instances [{}]: {}", path, errorMessage);
 		return State::invalid;
 	}
 }
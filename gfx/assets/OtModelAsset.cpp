@@ -27,6 +27,7 @@ OtAssetBase::State OtModelAsset::load() {
 
 	} catch (const OtException& exception) {
 		errorMessage = exception.what();
+		OtLogCaughtError("Can't load model [{}]: {}", path, errorMessage);
 		return State::invalid;
 	}
 }
@@ -27,6 +27,7 @@ OtAssetBase::State OtShapeAsset::load() {
 
 	} catch ([[maybe_unused]] const OtException& exception) {
 		errorMessage = exception.what();
+		OtLogCaughtError("Can't load shape [{}]: {}", path, errorMessage);
 		return State::invalid;
 	}
 }
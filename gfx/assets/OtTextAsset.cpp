@@ -29,6 +29,7 @@ OtAssetBase::State OtTextAsset::load() {
 
 	} catch ([[maybe_unused]] const OtException& exception) {
 		errorMessage = exception.what();
+		OtLogCaughtError("Can't load text [{}]: {}", path, errorMessage);
 		return State::invalid;
 	}
 }
@@ -62,6 +62,7 @@ OtAssetBase::State OtTextureAsset::load() {
 
 	} catch ([[maybe_unused]] const OtException& exception) {
 		errorMessage = exception.what();
+		OtLogCaughtError("Can't load texture [{}]: {}", path, errorMessage);
 		return State::invalid;
 	}
 }
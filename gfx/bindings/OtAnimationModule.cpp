@@ -195,7 +195,7 @@ void OtAnimationClass::update() {
 //
 
 OtType OtAnimationClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtAnimationClass>("Animation", OtObjectClass::getMeta());
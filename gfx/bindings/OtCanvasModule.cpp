@@ -24,7 +24,7 @@
 //
 
 OtType OtCanvasClass::getMeta() {
-	static OtType type = nullptr;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtCanvasClass>("Canvas", OtObjectClass::getMeta());
@@ -49,7 +49,7 @@ OtObject OtManifoldClass::compose(OtObject array) {
 //
 
 OtType OtManifoldClass::getMeta() {
-	static OtType type = nullptr;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtManifoldClass>("Manifold", OtObjectClass::getMeta());
@@ -21,7 +21,7 @@
 //
 
 OtType OtVec2Class::getMeta() {
-	static OtType type = nullptr;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtVec2Class>("Vec2", OtObjectClass::getMeta());
@@ -67,7 +67,7 @@ OtType OtVec2Class::getMeta() {
 //
 
 OtType OtVec4Class::getMeta() {
-	static OtType type = nullptr;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtVec4Class>("Vec4", OtObjectClass::getMeta());
@@ -110,7 +110,7 @@ OtType OtVec4Class::getMeta() {
 //
 
 OtType OtVec3Class::getMeta() {
-	static OtType type = nullptr;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtVec3Class>("Vec3", OtObjectClass::getMeta());
@@ -158,7 +158,7 @@ OtType OtVec3Class::getMeta() {
 //
 
 OtType OtMat4Class::getMeta() {
-	static OtType type = nullptr;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtMat4Class>("Mat4", OtObjectClass::getMeta());
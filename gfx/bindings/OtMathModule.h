@@ -82,6 +82,10 @@ public:
 		}
 	}
 
+	inline bool isMemberCacheable(OtID id) override {
+		return id != xID && id != yID;
+	}
+
 	inline OtObject setX(float x) { value.x = x; return OtVec2(this); }
 	inline OtObject setY(float y) { value.y = y; return OtVec2(this); }
 
@@ -214,6 +218,10 @@ public:
 		}
 	}
 
+	inline bool isMemberCacheable(OtID id) override {
+		return id != xID && id != yID && id != zID;
+	}
+
 	inline OtObject setX(float x) { value.x = x; return OtVec3(this); }
 	inline OtObject setY(float y) { value.y = y; return OtVec3(this); }
 	inline OtObject setZ(float z) { value.z = z; return OtVec3(this); }
@@ -359,6 +367,10 @@ public:
 		}
 	}
 
+	inline bool isMemberCacheable(OtID id) override {
+		return id != xID && id != yID && id != zID && id != wID;
+	}
+
 	inline OtObject setX(float x) { value.x = x; return OtVec4(this); }
 	inline OtObject setY(float y) { value.y = y; return OtVec4(this); }
 	inline OtObject setZ(float z) { value.z = z; return OtVec4(this); }
@@ -634,6 +646,12 @@ public:
 		}
 	}
 
+	inline bool isMemberCacheable(OtID id) override {
+		return
+			id != row1ID && id != row2ID && id != row3ID && id != row4ID &&
+			id != column1ID && id != column2ID && id != column3ID && id != column4ID;
+	}
+
 	// matrix arithmetic
 	inline glm::mat4 add(glm::mat4 operand) { return value + operand; }
 	inline glm::mat4 subtract(glm::mat4 operand) { return value - operand; }
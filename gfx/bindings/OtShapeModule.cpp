@@ -22,7 +22,7 @@
 //
 
 OtType OtShapeClass::getMeta() {
-	static OtType type = nullptr;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtShapeClass>("Shape", OtObjectClass::getMeta());
@@ -33,6 +33,7 @@
 #include "OtLog.h"
 #include "OtMeasure.h"
 #include "OtStderrMultiplexer.h"
+#include "OtTrace.h"
 
 #include "OtAnimationModule.h"
 #include "OtAssetManager.h"
@@ -85,17 +86,24 @@ void OtFramework::run(OtFrameworkApp* targetApp) {
 	running = true;
 
 	while (running) {
+		OtTraceZone("frame");
+
 		// process all events
-		eventsSDL();
+		{
+			OtTraceZone("events");
+			eventsSDL();
+		}
 
 		// calculate loop speed
 		loopTime = std::chrono::high_resolution_clock::now();
 		auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(loopTime - lastTime).count();
 		loopDuration = static_cast<float>(microseconds) / 1000.0f;
 		lastTime = loopTime;
+		OtTrace::counter("frame time (ms)", loopDuration);
 
 		// start new frame
 		{
+			OtTraceZone("start frame");
 			OtMeasureStopWatch stopwatch;
 			gpu.startFrame();
 			gpuWaitTime = stopwatch.elapsed();
@@ -104,18 +112,28 @@ void OtFramework::run(OtFrameworkApp* targetApp) {
 		startFrameIMGUI();
 
 		// process all messages on the bus
-		OtMessageBus::process();
+		{
+			OtTraceZone("message bus");
+			OtMessageBus::process();
+		}
 
 		// run all animations
-		OtAnimationClass::update();
+		{
+			OtTraceZone("animations");
+			OtAnimationClass::update();
+		}
 
 		// handle libuv events
 		// this is done at this point so asynchronous callbacks
 		// can take part in the rendering process and use the GPU
-		uv_run(uv_default_loop(), UV_RUN_NOWAIT);
+		{
+			OtTraceZone("libuv events");
+			uv_run(uv_default_loop(), UV_RUN_NOWAIT);
+		}
 
 		// let app render a frame
 		{
+			OtTraceZone("render");
 			OtMeasureStopWatch stopwatch;
 			app->onRender();
 			cpuTime = stopwatch.elapsed();
@@ -123,6 +141,7 @@ void OtFramework::run(OtFrameworkApp* targetApp) {
 
 		// put results on screen
 		{
+			OtTraceZone("end frame");
 			OtMeasureStopWatch stopwatch;
 			endFrameIMGUI();
 			gpu.endFrame();
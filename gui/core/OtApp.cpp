@@ -94,7 +94,7 @@ void OtAppClass::run() {
 //
 
 OtType OtAppClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtAppClass>("App", OtWidgetClass::getMeta());
@@ -19,7 +19,7 @@
 //
 
 OtType OtGuiClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtGuiClass>("GUI", OtObjectClass::getMeta());
@@ -180,7 +180,7 @@ OtCanvasStackClass::Canvas* OtCanvasStackClass::findCanvas(int id) {
 //
 
 OtType OtCanvasStackClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtCanvasStackClass>("CanvasStack", OtWidgetClass::getMeta());
@@ -66,7 +66,7 @@ void OtCheckBoxClass::render() {
 //
 
 OtType OtCheckBoxClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtCheckBoxClass>("CheckBox", OtWidgetClass::getMeta());
@@ -159,7 +159,7 @@ void OtColumnsClass::render() {
 //
 
 OtType OtColumnsClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtColumnsClass>("Columns", OtWidgetClass::getMeta());
@@ -111,7 +111,7 @@ void OtComboBoxClass::render() {
 //
 
 OtType OtComboBoxClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtComboBoxClass>("ComboBox", OtWidgetClass::getMeta());
@@ -118,7 +118,7 @@ void OtDialClass::render() {
 //
 
 OtType OtDialClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtDialClass>("Dial", OtWidgetClass::getMeta());
@@ -130,7 +130,7 @@ void OtFilmStripClass::render() {
 //
 
 OtType OtFilmStripClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtFilmStripClass>("FilmStrip", OtWidgetClass::getMeta());
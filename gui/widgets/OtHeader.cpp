@@ -54,7 +54,7 @@ void OtHeaderClass::render() {
 //
 
 OtType OtHeaderClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtHeaderClass>("Header", OtWidgetClass::getMeta());
@@ -70,7 +70,7 @@ void OtIntegerSliderClass::render() {
 //
 
 OtType OtIntegerSliderClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtIntegerSliderClass>("IntegerSlider", OtWidgetClass::getMeta());
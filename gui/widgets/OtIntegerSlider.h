@@ -59,6 +59,10 @@ public:
 	// render content
 	void render() override;
 
+	// cycle collector support
+	inline void traverse(OtObjectTraverser& traverser) override { OtWidgetClass::traverse(traverser); traverser(callback); }
+	inline void clearReferences() override { OtWidgetClass::clearReferences(); callback = nullptr; }
+
 	// get type definition
 	static OtType getMeta();
 
@@ -68,7 +68,7 @@ void OtLabelClass::render() {
 //
 
 OtType OtLabelClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtLabelClass>("Label", OtWidgetClass::getMeta());
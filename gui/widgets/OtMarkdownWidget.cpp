@@ -50,7 +50,7 @@ void OtMarkdownWidgetClass::render() {
 //
 
 OtType OtMarkdownWidgetClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtMarkdownWidgetClass>("Markdown", OtWidgetClass::getMeta());
@@ -33,7 +33,7 @@ void OtPanelClass::render() {
 //
 
 OtType OtPanelClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtPanelClass>("Panel", OtWidgetClass::getMeta());
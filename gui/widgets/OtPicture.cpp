@@ -75,7 +75,7 @@ void OtPictureClass::render() {
 //
 
 OtType OtPictureClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtPictureClass>("Picture", OtWidgetClass::getMeta());
@@ -56,7 +56,7 @@ void OtPropertiesClass::render() {
 //
 
 OtType OtPropertiesClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtPropertiesClass>("Properties", OtWidgetClass::getMeta());
@@ -70,7 +70,7 @@ void OtRealSliderClass::render() {
 //
 
 OtType OtRealSliderClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtRealSliderClass>("RealSlider", OtWidgetClass::getMeta());
@@ -162,7 +162,7 @@ void OtRowsClass::render() {
 //
 
 OtType OtRowsClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtRowsClass>("rows", OtWidgetClass::getMeta());
@@ -57,7 +57,7 @@ void OtSlippyMapWidgetClass::render() {
 //
 
 OtType OtSlippyMapWidgetClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtSlippyMapWidgetClass>("SlippyMap", OtWidgetClass::getMeta());
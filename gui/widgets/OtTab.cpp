@@ -55,7 +55,7 @@ void OtTabClass::render() {
 //
 
 OtType OtTabClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtTabClass>("Tab", OtWidgetClass::getMeta());
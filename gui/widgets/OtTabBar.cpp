@@ -45,7 +45,7 @@ void OtTabBarClass::render() {
 //
 
 OtType OtTabBarClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtTabBarClass>("TabBar", OtWidgetClass::getMeta());
@@ -100,7 +100,7 @@ void OtTextDiffWidgetClass::render() {
 //
 
 OtType OtTextDiffWidgetClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtTextDiffWidgetClass>("TextDiff", OtWidgetClass::getMeta());
@@ -100,7 +100,7 @@ void OtTextEditorWidgetClass::render() {
 //
 
 OtType OtTextEditorWidgetClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtTextEditorWidgetClass>("TextEditor", OtWidgetClass::getMeta());
@@ -66,7 +66,7 @@ void OtTextFieldClass::render() {
 //
 
 OtType OtTextFieldClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtTextFieldClass>("TextField", OtWidgetClass::getMeta());
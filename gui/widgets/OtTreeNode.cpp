@@ -74,7 +74,7 @@ void OtTreeNodeClass::render() {
 //
 
 OtType OtTreeNodeClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtTreeNodeClass>("TreeNode", OtWidgetClass::getMeta());
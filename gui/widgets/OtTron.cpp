@@ -311,7 +311,7 @@ ImU32 OtTronClass::blend(ImU32 color1, ImU32 color2, float ratio) {
 //
 
 OtType OtTronClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtTronClass>("Tron", OtWidgetClass::getMeta());
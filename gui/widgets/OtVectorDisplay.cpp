@@ -627,7 +627,7 @@ void OtVectorDisplayClass::render() {
 //
 
 OtType OtVectorDisplayClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtVectorDisplayClass>("VectorDisplay", OtWidgetClass::getMeta());
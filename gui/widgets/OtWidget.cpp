@@ -128,12 +128,42 @@ void OtWidgetClass::renderChild(OtWidget child) {
 }
 
 
+//
+//	OtWidgetClass::traverse
+//
+
+void OtWidgetClass::traverse(OtObjectTraverser& traverser) {
+	OtGuiClass::traverse(traverser);
+
+	for (auto& child : children) {
+		traverser(child);
+	}
+}
+
+
+//
+//	OtWidgetClass::clearReferences
+//
+
+void OtWidgetClass::clearReferences() {
+	OtGuiClass::clearReferences();
+
+	// children are released after the list is empty
+	std::vector<OtWidget> old;
+	old.swap(children);
+
+	for (auto& child : old) {
+		child->parent = nullptr;
+	}
+}
+
+
 //
 //	OtWidgetClass::getMeta
 //
 
 OtType OtWidgetClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtWidgetClass>("Widget", OtGuiClass::getMeta());
@@ -62,6 +62,10 @@ public:
 	OtObject setEnabled(bool e) { enabled = e; return OtWidget(this); }
 	bool isEnabled() { return enabled; }
 
+	// cycle collector support
+	void traverse(OtObjectTraverser& traverser) override;
+	void clearReferences() override;
+
 	// render content
 	virtual void render() {}
 
@@ -42,7 +42,7 @@ void OtWidgetStackClass::render() {
 //
 
 OtType OtWidgetStackClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtWidgetStackClass>("WidgetStack", OtWidgetClass::getMeta());
@@ -11,12 +11,18 @@
 
 #include <algorithm>
 #include <sstream>
+#include <string_view>
+#include <utility>
 
 #include "OtArray.h"
 #include "OtArrayReference.h"
 #include "OtArrayIterator.h"
 #include "OtFunction.h"
+#include "OtInteger.h"
 #include "OtLog.h"
+#include "OtParallelSort.h"
+#include "OtReal.h"
+#include "OtString.h"
 #include "OtVM.h"
 
 
@@ -296,14 +302,83 @@ OtObject OtArrayClass::eraseMultiple(size_t index1, size_t index2) {
 }
 
 
+//
+//	Native sorting
+//
+//	Arrays where all keys are Integers, Reals or Strings are sorted on native
+//	values (in parallel for large arrays) instead of through virtual operators.
+//	Keys are paired with their original position which makes the sort stable.
+//
+
+template <typename Key, typename Get>
+static void sortNative(std::vector<OtObject>& array, std::vector<OtObject>& keys, bool reverse, Get get) {
+	std::vector<std::pair<Key, size_t>> entries;
+	entries.reserve(keys.size());
+
+	for (size_t i = 0; i < keys.size(); i++) {
+		entries.emplace_back(get(keys[i]), i);
+	}
+
+	if (reverse) {
+		OtParallelSort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+			return b.first < a.first || (!(a.first < b.first) && a.second < b.second);
+		});
+
+	} else {
+		OtParallelSort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+			return a.first < b.first || (!(b.first < a.first) && a.second < b.second);
+		});
+	}
+
+	std::vector<OtObject> sorted;
+	sorted.reserve(array.size());
+
+	for (auto& entry : entries) {
+		sorted.emplace_back(std::move(array[entry.second]));
+	}
+
+	array.swap(sorted);
+}
+
+static bool sortByKeys(std::vector<OtObject>& array, std::vector<OtObject>& keys, bool reverse) {
+	// determine whether all keys have the same primitive type
+	auto allOf = [&](auto check) {
+		return std::all_of(keys.begin(), keys.end(), check);
+	};
+
+	if (keys.empty()) {
+		return true;
+
+	} else if (allOf([](OtObject& key) { return key.isKindOf<OtIntegerClass>(); })) {
+		sortNative<int64_t>(array, keys, reverse, [](OtObject& key) { return key->operator int64_t(); });
+		return true;
+
+	} else if (allOf([](OtObject& key) { return key.isKindOf<OtRealClass>(); })) {
+		sortNative<double>(array, keys, reverse, [](OtObject& key) { return key->operator double(); });
+		return true;
+
+	} else if (allOf([](OtObject& key) { return key.isKindOf<OtStringClass>(); })) {
+		sortNative<std::string_view>(array, keys, reverse, [](OtObject& key) { return std::string_view(OtString(key)->getValue()); });
+		return true;
+
+	} else {
+		return false;
+	}
+}
+
+
 //
 //	OtArrayClass::sort
 //
 
 OtObject OtArrayClass::sort() {
-	std::sort(array.begin(), array.end(), [](OtObject a, OtObject b) {
-		return *a < *b;
-	});
+	auto keys = array;
+
+	if (!sortByKeys(array, keys, false)) {
+		std::sort(array.begin(), array.end(), [](OtObject& a, OtObject& b) {
+			return *a < *b;
+		});
+	}
 
 	return OtArray(this);
 }
@@ -314,9 +389,13 @@ OtObject OtArrayClass::sort() {
 //
 
 OtObject OtArrayClass::rsort() {
-	std::sort(array.begin(), array.end(), [](OtObject a, OtObject b) {
-		return !(*a < *b);
-	});
+	auto keys = array;
+
+	if (!sortByKeys(array, keys, true)) {
+		std::sort(array.begin(), array.end(), [](OtObject& a, OtObject& b) {
+			return *b < *a;
+		});
+	}
 
 	return OtArray(this);
 }
@@ -327,15 +406,76 @@ OtObject OtArrayClass::rsort() {
 //
 
 OtObject OtArrayClass::csort(OtObject function) {
-	std::sort(array.begin(), array.end(), [&](OtObject a, OtObject b) {
-		auto result = OtVM::callMemberFunction(function, "__call__", a, b);
-		return result->operator bool();
+	// resolve the comparison function once
+	static OtID callID = OtIdentifier::create("__call__");
+	auto call = function->get(callID);
+
+	std::sort(array.begin(), array.end(), [&](OtObject& a, OtObject& b) {
+		OtObject arguments[] = {a, b};
+		return OtVM::callMemberFunction(function, call, size_t(2), arguments)->operator bool();
 	});
 
 	return OtArray(this);
 }
 
 
+//
+//	OtArrayClass::sortBy
+//
+
+static void sortByFunction(std::vector<OtObject>& array, OtObject function, bool reverse) {
+	// get the keys (calling the key function exactly once per entry)
+	static OtID callID = OtIdentifier::create("__call__");
+	auto call = function->get(callID);
+	auto entries = array;
+	std::vector<OtObject> keys;
+	keys.reserve(entries.size());
+
+	for (auto& entry : entries) {
+		keys.emplace_back(OtVM::callMemberFunction(function, call, size_t(1), &entry));
+	}
+
+	// sort on native keys if possible, otherwise compare key objects
+	if (!sortByKeys(entries, keys, reverse)) {
+		std::vector<size_t> order(entries.size());
+
+		for (size_t i = 0; i < order.size(); i++) {
+			order[i] = i;
+		}
+
+		std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+			return reverse ? *keys[b] < *keys[a] : *keys[a] < *keys[b];
+		});
+
+		std::vector<OtObject> sorted;
+		sorted.reserve(entries.size());
+
+		for (auto i : order) {
+			sorted.emplace_back(std::move(entries[i]));
+		}
+
+		entries.swap(sorted);
+	}
+
+	array.swap(entries);
+}
+
+OtObject OtArrayClass::sortBy(OtObject function) {
+	sortByFunction(array, function, false);
+	return OtArray(this);
+}
+
+
+//
+//	OtArrayClass::rsortBy
+//
+
+OtObject OtArrayClass::rsortBy(OtObject function) {
+	sortByFunction(array, function, true);
+	return OtArray(this);
+}
+
+
 //
 //	OtArrayClass::push
 //
@@ -395,12 +535,38 @@ std::string OtArrayClass::join(const std::string& separator) {
 }
 
 
+//
+//	OtArrayClass::traverse
+//
+
+void OtArrayClass::traverse(OtObjectTraverser& traverser) {
+	OtCollectionClass::traverse(traverser);
+
+	for (auto& entry : array) {
+		traverser(entry);
+	}
+}
+
+
+//
+//	OtArrayClass::clearReferences
+//
+
+void OtArrayClass::clearReferences() {
+	OtCollectionClass::clearReferences();
+
+	// entries are released after the array is empty (their destructors could get back here)
+	std::vector<OtObject> entries;
+	entries.swap(array);
+}
+
+
 //
 //	OtArrayClass::getMeta
 //
 
 OtType OtArrayClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtArrayClass>("Array", OtCollectionClass::getMeta());
@@ -431,6 +597,8 @@ OtType OtArrayClass::getMeta() {
 		type->set("sort", OtFunction::create(&OtArrayClass::sort));
 		type->set("rsort", OtFunction::create(&OtArrayClass::rsort));
 		type->set("csort", OtFunction::create(&OtArrayClass::csort));
+		type->set("sortBy", OtFunction::create(&OtArrayClass::sortBy));
+		type->set("rsortBy", OtFunction::create(&OtArrayClass::rsortBy));
 
 		type->set("push", OtFunction::create(&OtArrayClass::push));
 		type->set("pop", OtFunction::create(&OtArrayClass::pop));
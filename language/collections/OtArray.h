@@ -93,6 +93,10 @@ public:
 	OtObject rsort();
 	OtObject csort(OtObject function);
 
+	// sort array in place using keys obtained by calling the function once per entry
+	OtObject sortBy(OtObject function);
+	OtObject rsortBy(OtObject function);
+
 	// push object to end of array
 	OtObject push(OtObject object);
 
@@ -105,6 +109,10 @@ public:
 	// join array entries into a string with separator
 	std::string join(const std::string& separator);
 
+	// cycle collector support
+	void traverse(OtObjectTraverser& traverser) override;
+	void clearReferences() override;
+
 	// get type definition
 	static OtType getMeta();
 
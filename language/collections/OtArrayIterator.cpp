@@ -18,7 +18,7 @@
 //
 
 OtType OtArrayIteratorClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtArrayIteratorClass>("ArrayIterator", OtIteratorClass::getMeta());
@@ -31,6 +31,10 @@ public:
 	inline bool end() { return index == array->size(); }
 	inline OtObject next() { return array->getEntry(index++); }
 
+	// cycle collector support
+	inline void traverse(OtObjectTraverser& traverser) override { OtIteratorClass::traverse(traverser); traverser(array); }
+	inline void clearReferences() override { OtIteratorClass::clearReferences(); array = nullptr; }
+
 	// get type definition
 	static OtType getMeta();
 
@@ -18,7 +18,7 @@
 //
 
 OtType OtArrayReferenceClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtArrayReferenceClass>("ArrayReference", OtReferenceClass::getMeta());
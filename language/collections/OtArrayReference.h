@@ -34,6 +34,10 @@ public:
 	inline OtObject deref() { return array->getEntry(index); }
 	inline OtObject assign(OtObject object) { array->setEntry(index, object); return object; }
 
+	// cycle collector support
+	inline void traverse(OtObjectTraverser& traverser) override { OtReferenceClass::traverse(traverser); traverser(array); }
+	inline void clearReferences() override { OtReferenceClass::clearReferences(); array = nullptr; }
+
 	// get type definition
 	static OtType getMeta();
 
@@ -17,7 +17,7 @@
 //
 
 OtType OtCollectionClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtCollectionClass>("Collection", OtObjectClass::getMeta());
@@ -9,11 +9,14 @@
 //	Include files
 //
 
+#include <algorithm>
+
 #include "OtArray.h"
 #include "OtDict.h"
 #include "OtDictReference.h"
 #include "OtFunction.h"
 #include "OtLog.h"
+#include "OtString.h"
 
 
 //
@@ -21,6 +24,8 @@
 //
 
 OtDictClass::OtDictClass(size_t count, OtObject* objects) {
+	reserve(count / 2);
+
 	for (size_t c = 0; c < count; c += 2) {
 		setEntry((std::string) *objects[c], objects[c + 1]);
 	}
@@ -37,14 +42,16 @@ OtDictClass::operator std::string() {
 
 	o << "{";
 
-	for (auto& entry : dict) {
-		if (first) {
-			first = false;
-		} else {
-			o << ",";
-		}
+	for (auto& entry : entries) {
+		if (entry.live) {
+			if (first) {
+				first = false;
+			} else {
+				o << ",";
+			}
 
-		o << OtText::toJSON(entry.first) << ":" << entry.second->json();
+			o << OtText::toJSON(entry.key) << ":" << entry.value->json();
+		}
 	}
 
 	o <<  "}";
@@ -62,10 +69,17 @@ void OtDictClass::init(size_t count, OtObject* parameters) {
 	}
 
 	// clear dictionary and add all calling parameters
-	dict.clear();
+	clear();
+	reserve(count / 2);
 
 	for (size_t c = 0; c < count; c += 2) {
-		dict.insert(std::make_pair((std::string) *parameters[c], parameters[c + 1]));
+		auto name = (std::string) *parameters[c];
+		auto hash = hashKey(name);
+
+		// the first value for a key wins
+		if (find(name, hash) == OtHashIndex::notFound) {
+			setEntry(name, hash, parameters[c + 1]);
+		}
 	}
 }
 
@@ -81,17 +95,21 @@ bool OtDictClass::operator==(OtObject operand) {
 		return false;
 
 	// ensure they have the same size
-	} else if (dict.size() != op->dict.size()) {
+	} else if (size() != op->size()) {
 		return false;
 	}
 
 	// compare all elements
-	for (auto& it : dict) {
-		if (op->dict.find(it.first) == op->dict.end()) {
-			return false;
+	for (auto& entry : entries) {
+		if (entry.live) {
+			auto other = op->find(entry.key, entry.hash);
 
-		} else if (!it.second->equal(op->dict[it.first])) {
-			return false;
+			if (other == OtHashIndex::notFound) {
+				return false;
+
+			} else if (!entry.value->equal(op->entries[other].value)) {
+				return false;
+			}
 		}
 	}
 
@@ -104,8 +122,7 @@ bool OtDictClass::operator==(OtObject operand) {
 //
 
 OtObject OtDictClass::set(OtID id, OtObject value) {
-	auto index = std::string(OtIdentifier::name(id));
-	setEntry(index, value);
+	setEntry(OtIdentifier::name(id), OtIdentifier::hash(id), value);
 	return value;
 }
 
@@ -115,10 +132,10 @@ OtObject OtDictClass::set(OtID id, OtObject value) {
 //
 
 OtObject OtDictClass::get(OtID id) {
-	auto index = std::string(OtIdentifier::name(id));
+	auto entry = find(OtIdentifier::name(id), OtIdentifier::hash(id));
 
-	if (contains(index)) {
-		return getEntry(index);
+	if (entry != OtHashIndex::notFound) {
+		return entries[entry].value;
 
 	} else {
 		return OtCollectionClass::get(id);
@@ -130,9 +147,19 @@ OtObject OtDictClass::get(OtID id) {
 //	OtDictClass::setEntry
 //
 
-OtObject OtDictClass::setEntry(const std::string& index, OtObject object) {
-	// set entry
-	dict[index] = object;
+OtObject OtDictClass::setEntry(std::string_view name, size_t hash, OtObject object) {
+	auto entry = find(name, hash);
+
+	if (entry == OtHashIndex::notFound) {
+		// add a new entry
+		lookup.insert(hash, entries.size(), entries.size(), [this](size_t i) { return entries[i].hash; });
+		entries.emplace_back(name, hash, object);
+
+	} else {
+		// replace an existing entry
+		entries[entry].value = object;
+	}
+
 	return object;
 }
 
@@ -141,14 +168,16 @@ OtObject OtDictClass::setEntry(const std::string& index, OtObject object) {
 //	OtDictClass::getEntry
 //
 
-OtObject OtDictClass::getEntry(const std::string& index) {
+OtObject OtDictClass::getEntry(std::string_view name, size_t hash) {
+	auto entry = find(name, hash);
+
 	// sanity check
-	if (dict.find(index) == dict.end()) {
-		OtLogError("Unkown dictionary member [{}]", index);
+	if (entry == OtHashIndex::notFound) {
+		OtLogError("Unkown dictionary member [{}]", name);
 	}
 
 	// return entry
-	return dict[index];
+	return entries[entry].value;
 }
 
 
@@ -156,8 +185,16 @@ OtObject OtDictClass::getEntry(const std::string& index) {
 //	OtDictClass::index
 //
 
-OtObject OtDictClass::index(const std::string& index) {
-	return OtDictReference::create(OtDict(this), index);
+OtObject OtDictClass::index(OtObject index) {
+	// strings carry a cached hash
+	if (index.isKindOf<OtStringClass>()) {
+		OtString name = index;
+		return OtDictReference::create(OtDict(this), name->getValue(), name->getHash());
+
+	} else {
+		auto name = index->operator std::string();
+		return OtDictReference::create(OtDict(this), name, hashKey(name));
+	}
 }
 
 
@@ -166,18 +203,7 @@ OtObject OtDictClass::index(const std::string& index) {
 //
 
 OtObject OtDictClass::add(OtObject value) {
-	value.expect<OtDictClass>("Dict");
-	auto result = OtDict::create();
-
-	for (auto& it : dict) {
-		result->setEntry(it.first, it.second);
-	}
-
-	for (auto& it : OtDict(value)->dict) {
-		result->setEntry(it.first, it.second);
-	}
-
-	return result;
+	return merge(value);
 }
 
 
@@ -187,9 +213,12 @@ OtObject OtDictClass::add(OtObject value) {
 
 OtObject OtDictClass::clone() {
 	auto result = OtDict::create();
+	result->reserve(size());
 
-	for (auto& it : dict) {
-		result->setEntry(it.first, it.second);
+	for (auto& entry : entries) {
+		if (entry.live) {
+			result->setEntry(entry.key, entry.hash, entry.value);
+		}
 	}
 
 	return result;
@@ -202,15 +231,14 @@ OtObject OtDictClass::clone() {
 
 OtObject OtDictClass::merge(OtObject value) {
 	value.expect<OtDictClass>("Dict");
-	auto result = OtDict::create();
-
-	for (auto& it : dict) {
-		result->setEntry(it.first, it.second);
-	}
+	OtDict op = value;
+	OtDict result = clone();
+	result->reserve(size() + op->size());
 
-
-	for (auto& it : OtDict(value)->dict) {
-		result->setEntry(it.first, it.second);
+	for (auto& entry : op->entries) {
+		if (entry.live) {
+			result->setEntry(entry.key, entry.hash, entry.value);
+		}
 	}
 
 	return result;
@@ -221,12 +249,24 @@ OtObject OtDictClass::merge(OtObject value) {
 //	OtDictClass::eraseEntry
 //
 
-void OtDictClass::eraseEntry(const std::string& index) {
-	if (dict.find(index) == dict.end()) {
-		OtLogError("Unkown dictionary member [{}]", index);
+void OtDictClass::eraseEntry(const std::string& name) {
+	auto hash = hashKey(name);
+	auto entry = find(name, hash);
+
+	if (entry == OtHashIndex::notFound) {
+		OtLogError("Unkown dictionary member [{}]", name);
 	}
 
-	dict.erase(index);
+	// mark entry as erased (so the insertion order of the others is preserved)
+	lookup.erase(hash, entry, [this](size_t i) { return entries[i].hash; });
+	entries[entry].live = false;
+	entries[entry].value = nullptr;
+	erased++;
+
+	// compact the entries when most of them are erased
+	if (erased > entries.size() / 2) {
+		compact();
+	}
 }
 
 
@@ -237,9 +277,12 @@ void OtDictClass::eraseEntry(const std::string& index) {
 OtObject OtDictClass::keys() {
 	// create array of all keys in dictionary
 	auto array = OtArray::create();
+	array->raw().reserve(size());
 
-	for (auto const& entry : dict) {
-		array->append(OtString::create(entry.first));
+	for (auto& entry : entries) {
+		if (entry.live) {
+			array->append(OtString::create(entry.key));
+		}
 	}
 
 	return array;
@@ -253,21 +296,78 @@ OtObject OtDictClass::keys() {
 OtObject OtDictClass::values() {
 	// create array of all values in dictionary
 	auto array = OtArray::create();
+	array->raw().reserve(size());
 
-	for (auto const& entry : dict) {
-		array->append(entry.second);
+	for (auto& entry : entries) {
+		if (entry.live) {
+			array->append(entry.value);
+		}
 	}
 
 	return array;
 }
 
 
+//
+//	OtDictClass::reserve
+//
+
+void OtDictClass::reserve(size_t count) {
+	entries.reserve(count);
+	lookup.reserve(count, entries.size(), [this](size_t i) { return entries[i].hash; });
+}
+
+
+//
+//	OtDictClass::compact
+//
+
+void OtDictClass::compact() {
+	entries.erase(std::remove_if(entries.begin(), entries.end(), [](Entry& entry) {
+		return !entry.live;
+	}), entries.end());
+
+	erased = 0;
+	lookup.rebuild(entries.size(), [this](size_t i) { return entries[i].hash; });
+}
+
+
+//
+//	OtDictClass::traverse
+//
+
+void OtDictClass::traverse(OtObjectTraverser& traverser) {
+	OtCollectionClass::traverse(traverser);
+
+	for (auto& entry : entries) {
+		if (entry.live) {
+			traverser(entry.value);
+		}
+	}
+}
+
+
+//
+//	OtDictClass::clearReferences
+//
+
+void OtDictClass::clearReferences() {
+	OtCollectionClass::clearReferences();
+
+	// values are released after the dictionary is empty
+	std::vector<Entry> old;
+	old.swap(entries);
+	lookup.clear();
+	erased = 0;
+}
+
+
 //
 //	OtDictClass::getMeta
 //
 
 OtType OtDictClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtDictClass>("Dict", OtCollectionClass::getMeta());
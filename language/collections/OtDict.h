@@ -12,16 +12,25 @@
 //	Include files
 //
 
+#include <functional>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <vector>
 
 #include "OtCollection.h"
+#include "OtHashIndex.h"
 #include "OtIdentifier.h"
 
 
 //
 //	OtDict
 //
+//	Entries are stored in insertion order (which makes iteration and JSON
+//	output deterministic) with a cached hash of their key. Lookups through
+//	member access use the cached hashes of interned identifiers and lookups
+//	through string objects use the hash cached in the string so neither
+//	rehashes the key.
+//
 
 class OtDictClass;
 using OtDict = OtObjectPointer<OtDictClass>;
@@ -38,7 +47,7 @@ public:
 	operator std::string() override;
 
 	// debugging support
-	inline std::string describe() override { return std::to_string(dict.size()) + " entries"; }
+	inline std::string describe() override { return std::to_string(size()) + " entries"; }
 
 	// initializer
 	void init(size_t count, OtObject* parameters);
@@ -49,21 +58,26 @@ public:
 	// access dict members
 	OtObject set(OtID id, OtObject value) override;
 	OtObject get(OtID id) override;
+	inline bool isMemberCacheable(OtID) override { return false; }
+
+	inline OtObject setEntry(const std::string& index, OtObject object) { return setEntry(index, hashKey(index), object); }
+	inline OtObject getEntry(const std::string& index) { return getEntry(index, hashKey(index)); }
 
-	OtObject setEntry(const std::string& index, OtObject object);
-	OtObject getEntry(const std::string& index);
+	// access entries with a precalculated key hash
+	OtObject setEntry(std::string_view index, size_t hash, OtObject object);
+	OtObject getEntry(std::string_view index, size_t hash);
 
 	// support indexing
-	OtObject index(const std::string& index);
+	OtObject index(OtObject index);
 
 	// add two dictionaries
 	OtObject add(OtObject value);
 
 	// does dictionary contains specified object
-	inline bool contains(const std::string& name) { return dict.find(name) != dict.end(); }
+	inline bool contains(const std::string& name) { return find(name, hashKey(name)) != OtHashIndex::notFound; }
 
 	// get dictionary size
-	inline size_t size() { return dict.size(); }
+	inline size_t size() { return entries.size() - erased; }
 
 	// return dictionary clone
 	OtObject clone();
@@ -72,7 +86,7 @@ public:
 	OtObject merge(OtObject object);
 
 	// remove all dictionary entries
-	inline void clear() { dict.clear(); }
+	inline void clear() { entries.clear(); lookup.clear(); erased = 0; }
 
 	// remove dictionary entry
 	void eraseEntry(const std::string& name);
@@ -83,12 +97,28 @@ public:
 	// get array of dictionary values
 	OtObject values();
 
+	// iterate through the entries (in insertion order)
+	inline void each(std::function<void(const std::string&, OtObject&)> callback) {
+		for (auto& entry : entries) {
+			if (entry.live) {
+				callback(entry.key, entry.value);
+			}
+		}
+	}
+
+	// reserve space for the specified number of entries
+	void reserve(size_t count);
+
+	// hash a key (the same function is used for identifiers and strings)
+	static inline size_t hashKey(std::string_view key) { return std::hash<std::string_view>{}(key); }
+
+	// cycle collector support
+	void traverse(OtObjectTraverser& traverser) override;
+	void clearReferences() override;
+
 	// get type definition
 	static OtType getMeta();
 
-	// get access to raw object dictionary
-	std::unordered_map<std::string, OtObject>& raw() { return dict; }
-
 protected:
 	// constructors
 	friend class OtObjectPointer<OtDictClass>;
@@ -96,6 +126,27 @@ protected:
 	OtDictClass(size_t count, OtObject* objects);
 
 private:
-	// data
-	std::unordered_map<std::string, OtObject> dict;
+	// find an entry (returns OtHashIndex::notFound if the key is not in the dictionary)
+	inline size_t find(std::string_view key, size_t hash) {
+		return lookup.find(hash, [&](size_t i) {
+			auto& entry = entries[i];
+			return entry.hash == hash && entry.key == key;
+		});
+	}
+
+	// remove erased entries
+	void compact();
+
+	// entries in insertion order (erased entries stay until they are compacted away)
+	struct Entry {
+		Entry(std::string_view k, size_t h, OtObject v) : key(k), hash(h), value(v) {}
+		std::string key;
+		size_t hash;
+		OtObject value;
+		bool live = true;
+	};
+
+	std::vector<Entry> entries;
+	OtHashIndex lookup;
+	size_t erased = 0;
 };
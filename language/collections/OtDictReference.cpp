@@ -18,7 +18,7 @@
 //
 
 OtType OtDictReferenceClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtDictReferenceClass>("DictReference", OtReferenceClass::getMeta());
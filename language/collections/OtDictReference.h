@@ -13,6 +13,7 @@
 //
 
 #include <string>
+#include <string_view>
 
 #include "OtDict.h"
 #include "OtReference.h"
@@ -31,8 +32,12 @@ public:
 	inline std::string describe() override { return "[\"" + index + "\"]"; }
 
 	// (de)reference functions
-	inline OtObject deref() { return dict->getEntry(index); }
-	inline OtObject assign(OtObject value) { dict->setEntry(index, value); return value; }
+	inline OtObject deref() { return dict->getEntry(index, hash); }
+	inline OtObject assign(OtObject value) { dict->setEntry(index, hash, value); return value; }
+
+	// cycle collector support
+	inline void traverse(OtObjectTraverser& traverser) override { OtReferenceClass::traverse(traverser); traverser(dict); }
+	inline void clearReferences() override { OtReferenceClass::clearReferences(); dict = nullptr; }
 
 	// get type definition
 	static OtType getMeta();
@@ -41,10 +46,11 @@ protected:
 	// constructors
 	friend class OtObjectPointer<OtDictReferenceClass>;
 	OtDictReferenceClass() = default;
-	OtDictReferenceClass(OtDict d, const std::string& i) : dict(d), index(i) {}
+	OtDictReferenceClass(OtDict d, std::string_view i, size_t h) : dict(d), index(i), hash(h) {}
 
 private:
 	// data
 	OtDict dict;
 	std::string index;
+	size_t hash;
 };
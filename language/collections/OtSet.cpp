@@ -9,7 +9,6 @@
 //	Include files
 //
 
-#include <algorithm>
 #include <sstream>
 #include <utility>
 
@@ -25,7 +24,7 @@
 
 OtSetClass::OtSetClass(OtObject* objects, size_t count) {
 	for (size_t c = 0; c < count; c++) {
-		add(objects[c]);
+		addMember(objects[c]);
 	}
 }
 
@@ -40,7 +39,7 @@ OtSetClass::operator std::string() {
 
 	o << "[";
 
-	for (auto entry : set) {
+	for (auto& member : members) {
 		if (first) {
 			first = false;
 
@@ -48,7 +47,7 @@ OtSetClass::operator std::string() {
 			o << ",";
 		}
 
-		o << entry->json();
+		o << member->json();
 	}
 
 	o << "]";
@@ -61,8 +60,10 @@ OtSetClass::operator std::string() {
 //
 
 void OtSetClass::init(size_t count, OtObject* parameters) {
+	clear();
+
 	for (size_t c = 0; c < count; c++) {
-		set.insert(parameters[c]);
+		addMember(parameters[c]);
 	}
 }
 
@@ -79,13 +80,13 @@ bool OtSetClass::operator==(OtObject object) {
 		return false;
 
 	// ensure they have the same size
-	} else if (set.size() != op->set.size()) {
+	} else if (members.size() != op->members.size()) {
 		return false;
 	}
 
-	// compare all elements
-	for (auto const& entry : set) {
-		if (!op->contains(entry)) {
+	// compare all members
+	for (size_t i = 0; i < members.size(); i++) {
+		if (op->find(members[i], hashes[i]) == OtHashIndex::notFound) {
 			return false;
 		}
 	}
@@ -108,16 +109,8 @@ OtObject OtSetClass::iterate() {
 //
 
 OtObject OtSetClass::add(OtObject object) {
-	OtSet result = OtSet::create();
-
-	for (auto& entry : set) {
-		result->set.insert(entry);
-	}
-
-	if (!result->contains(object)) {
-		result->set.insert(std::move(object));
-	}
-
+	OtSet result = clone();
+	result->addMember(object);
 	return result;
 }
 
@@ -127,14 +120,8 @@ OtObject OtSetClass::add(OtObject object) {
 //
 
 OtObject OtSetClass::subtract(OtObject object) {
-	OtSet result = OtSet::create();
-
-	for (auto entry : set) {
-		if (!entry->equal(object)) {
-			result->set.insert(entry);
-		}
-	}
-
+	OtSet result = clone();
+	result->removeMember(object);
 	return result;
 }
 
@@ -144,13 +131,7 @@ OtObject OtSetClass::subtract(OtObject object) {
 //
 
 bool OtSetClass::contains(OtObject object) {
-	for (auto entry : set) {
-		if (entry->equal(object)) {
-			return true;
-		}
-	}
-
-	return false;
+	return find(object, object->hash()) != OtHashIndex::notFound;
 }
 
 
@@ -160,11 +141,9 @@ bool OtSetClass::contains(OtObject object) {
 
 OtObject OtSetClass::clone() {
 	OtSet result = OtSet::create();
-
-	for (auto& entry : set) {
-		result->set.insert(entry);
-	}
-
+	result->members = members;
+	result->hashes = hashes;
+	result->index = index;
 	return result;
 }
 
@@ -174,20 +153,7 @@ OtObject OtSetClass::clone() {
 //
 
 OtObject OtSetClass::merge(OtObject object) {
-	object.expect<OtSetClass>("Set");
-	OtSet result = OtSet::create();
-
-	for (auto& item : set) {
-		result->set.insert(item);
-	}
-
-	for (auto& item : OtSet(object)->set) {
-		if (!result->contains(item)) {
-			result->set.insert(item);
-		}
-	}
-
-	return result;
+	return unionWith(object);
 }
 
 
@@ -196,9 +162,7 @@ OtObject OtSetClass::merge(OtObject object) {
 //
 
 void OtSetClass::insert(OtObject object) {
-	if (!contains(object)) {
-		set.insert(std::move(object));
-	}
+	addMember(object);
 }
 
 
@@ -207,23 +171,12 @@ void OtSetClass::insert(OtObject object) {
 //
 
 void OtSetClass::erase(OtObject object) {
-	bool found = false;
-
-	// use remove_if when we move the C++20
-	for (auto it = set.begin(); !found && it != set.end();) {
-		if (((OtObject) *it)->equal(object)) {
-			it = set.erase(it);
-			found = true;
-
-		} else {
-			it++;
-		}
-	}
+	removeMember(object);
 }
 
 
 //
-//	OtSetClass::intersection
+//	OtSetClass::intersectWith
 //
 
 OtObject OtSetClass::intersectWith(OtObject object) {
@@ -235,9 +188,9 @@ OtObject OtSetClass::intersectWith(OtObject object) {
 
 	OtSet result = OtSet::create();
 
-	for (auto& item : set) {
-		if (op->contains(item)) {
-			result->set.insert(item);
+	for (size_t i = 0; i < members.size(); i++) {
+		if (op->find(members[i], hashes[i]) != OtHashIndex::notFound) {
+			result->addMember(members[i]);
 		}
 	}
 
@@ -246,7 +199,7 @@ OtObject OtSetClass::intersectWith(OtObject object) {
 
 
 //
-//	OtSetClass::difference
+//	OtSetClass::diffFrom
 //
 
 OtObject OtSetClass::diffFrom(OtObject object) {
@@ -258,15 +211,15 @@ OtObject OtSetClass::diffFrom(OtObject object) {
 
 	OtSet result = OtSet::create();
 
-	for (auto& item : set) {
-		if (!op->contains(item)) {
-			result->set.insert(item);
+	for (size_t i = 0; i < members.size(); i++) {
+		if (op->find(members[i], hashes[i]) == OtHashIndex::notFound) {
+			result->addMember(members[i]);
 		}
 	}
 
-	for (auto& item : op->set) {
-		if (!contains(item)) {
-			result->set.insert(item);
+	for (size_t i = 0; i < op->members.size(); i++) {
+		if (find(op->members[i], op->hashes[i]) == OtHashIndex::notFound) {
+			result->addMember(op->members[i]);
 		}
 	}
 
@@ -280,16 +233,11 @@ OtObject OtSetClass::diffFrom(OtObject object) {
 
 OtObject OtSetClass::unionWith(OtObject object) {
 	object.expect<OtSetClass>("Set");
-	OtSet result = OtSet::create();
-
-	for (auto& item : set) {
-		result->set.insert(item);
-	}
+	OtSet op = object;
+	OtSet result = clone();
 
-	for (auto& item : OtSet(object)->set) {
-		if (!result->contains(item)) {
-			result->set.insert(item);
-		}
+	for (auto& member : op->members) {
+		result->addMember(member);
 	}
 
 	return result;
@@ -309,9 +257,9 @@ OtObject OtSetClass::subtractFrom(OtObject object) {
 
 	OtSet result = OtSet::create();
 
-	for (auto& item : set) {
-		if (!op->contains(item)) {
-			result->set.insert(item);
+	for (size_t i = 0; i < members.size(); i++) {
+		if (op->find(members[i], hashes[i]) == OtHashIndex::notFound) {
+			result->addMember(members[i]);
 		}
 	}
 
@@ -319,12 +267,91 @@ OtObject OtSetClass::subtractFrom(OtObject object) {
 }
 
 
+//
+//	OtSetClass::find
+//
+
+size_t OtSetClass::find(OtObject& object, size_t hash) {
+	return index.find(hash, [&](size_t i) {
+		return hashes[i] == hash && isSame(members[i], object);
+	});
+}
+
+
+//
+//	OtSetClass::addMember
+//
+
+void OtSetClass::addMember(OtObject object) {
+	auto hash = object->hash();
+
+	if (find(object, hash) == OtHashIndex::notFound) {
+		index.insert(hash, members.size(), members.size(), [this](size_t i) { return hashes[i]; });
+		members.emplace_back(std::move(object));
+		hashes.emplace_back(hash);
+	}
+}
+
+
+//
+//	OtSetClass::removeMember
+//
+
+void OtSetClass::removeMember(OtObject& object) {
+	auto hash = object->hash();
+	auto position = find(object, hash);
+
+	if (position != OtHashIndex::notFound) {
+		index.erase(hash, position, [this](size_t i) { return hashes[i]; });
+		auto last = members.size() - 1;
+
+		// move the last member into the hole
+		if (position != last) {
+			index.move(hashes[last], last, position);
+			members[position] = std::move(members[last]);
+			hashes[position] = hashes[last];
+		}
+
+		members.pop_back();
+		hashes.pop_back();
+	}
+}
+
+
+//
+//	OtSetClass::traverse
+//
+
+void OtSetClass::traverse(OtObjectTraverser& traverser) {
+	OtCollectionClass::traverse(traverser);
+
+	for (auto& member : members) {
+		traverser(member);
+	}
+}
+
+
+//
+//	OtSetClass::clearReferences
+//
+
+void OtSetClass::clearReferences() {
+	OtCollectionClass::clearReferences();
+
+	// members are released after the set is empty
+	std::vector<OtObject> old;
+	old.swap(members);
+	hashes.clear();
+	index.clear();
+}
+
+
 //
 //	OtSetClass::getMeta
 //
 
 OtType OtSetClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtSetClass>("Set", OtCollectionClass::getMeta());
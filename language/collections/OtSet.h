@@ -12,14 +12,19 @@
 //	Include files
 //
 
-#include <set>
+#include <vector>
 
 #include "OtCollection.h"
+#include "OtHashIndex.h"
 
 
 //
 //	OtSet
 //
+//	Members are unique by value (as determined by hash and operator==) and
+//	are kept in insertion order (removing a member moves the last member into
+//	its place). Objects without value semantics are unique by identity.
+//
 
 class OtSetClass;
 using OtSet = OtObjectPointer<OtSetClass>;
@@ -38,7 +43,7 @@ public:
 	operator std::string() override;
 
 	// debugging support
-	inline std::string describe() override { return std::to_string(set.size()) + " entries"; }
+	inline std::string describe() override { return std::to_string(members.size()) + " entries"; }
 
 	// clear array and add all parameters
 	void init(size_t count, OtObject* parameters);
@@ -53,7 +58,7 @@ public:
 	OtObject subtract(OtObject object);
 
 	// return number of set members
-	inline size_t size() { return set.size(); }
+	inline size_t size() { return members.size(); }
 
 	// see if object is in set
 	bool contains(OtObject object);
@@ -65,7 +70,7 @@ public:
 	OtObject merge(OtObject object);
 
 	// empty a set
-	inline void clear() { set.clear(); }
+	inline void clear() { members.clear(); hashes.clear(); index.clear(); }
 
 	// insert a new member in the set
 	void insert(OtObject object);
@@ -79,11 +84,15 @@ public:
 	OtObject unionWith(OtObject object);
 	OtObject subtractFrom(OtObject object);
 
+	// cycle collector support
+	void traverse(OtObjectTraverser& traverser) override;
+	void clearReferences() override;
+
 	// get type definition
 	static OtType getMeta();
 
-	// get access to raw object set
-	std::set<OtObject>& raw() { return set; }
+	// get access to raw set members
+	std::vector<OtObject>& raw() { return members; }
 
 protected:
 	// constructors
@@ -92,6 +101,20 @@ protected:
 	OtSetClass(OtObject* objects, size_t count);
 
 private:
+	// find a member (returns OtHashIndex::notFound if it's not in the set)
+	size_t find(OtObject& object, size_t hash);
+
+	// add a member (if it's not in the set yet) or remove one (if it is)
+	void addMember(OtObject object);
+	void removeMember(OtObject& object);
+
+	// see if two objects are the same member
+	static inline bool isSame(OtObject& a, OtObject& b) {
+		return a.raw() == b.raw() || (a->getType() == b->getType() && a->equal(b));
+	}
+
 	// data
-	std::set<OtObject> set;
+	std::vector<OtObject> members;
+	std::vector<size_t> hashes;
+	OtHashIndex index;
 };
@@ -18,7 +18,7 @@
 //
 
 OtType OtSetIteratorClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtSetIteratorClass>("SetIterator", OtIteratorClass::getMeta());
@@ -28,8 +28,12 @@ using OtSetIterator = OtObjectPointer<OtSetIteratorClass>;
 class OtSetIteratorClass : public OtIteratorClass {
 public:
 	// iteration operations
-	inline bool end() { return iterator == set->set.end(); }
-	inline OtObject next() { return *iterator++; }
+	inline bool end() { return position >= set->members.size(); }
+	inline OtObject next() { return set->members[position++]; }
+
+	// cycle collector support
+	inline void traverse(OtObjectTraverser& traverser) override { OtIteratorClass::traverse(traverser); traverser(set); }
+	inline void clearReferences() override { OtIteratorClass::clearReferences(); set = nullptr; }
 
 	// get type definition
 	static OtType getMeta();
@@ -38,10 +42,10 @@ protected:
 	// constructors
 	friend class OtObjectPointer<OtSetIteratorClass>;
 	OtSetIteratorClass() = default;
-	inline OtSetIteratorClass(OtSet s) : set(s) { iterator = set->set.begin(); }
+	inline OtSetIteratorClass(OtSet s) : set(s) {}
 
 private:
 	// data
 	OtSet set;
-	std::set<OtObject>::iterator iterator;
+	size_t position = 0;
 };
@@ -0,0 +1,1012 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+//
+//	Include files
+//
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#include "OtArray.h"
+#include "OtFunction.h"
+#include "OtIdentifier.h"
+#include "OtInteger.h"
+#include "OtReal.h"
+#include "OtString.h"
+#include "OtTypedArray.h"
+#include "OtTypedArrayIterator.h"
+#include "OtTypedArrayReference.h"
+#include "OtVM.h"
+
+
+//
+//	OtTypedArrayClass::index
+//
+
+OtObject OtTypedArrayClass::index(size_t index) {
+	checkIndex(index);
+	return OtTypedArrayReference::create(OtTypedArray(this), index);
+}
+
+
+//
+//	OtTypedArrayClass::iterate
+//
+
+OtObject OtTypedArrayClass::iterate() {
+	return OtTypedArrayIterator::create(OtTypedArray(this));
+}
+
+
+//
+//	OtTypedArrayClass::adopt
+//
+
+OtTypedArray OtTypedArrayClass::adopt(ElementType elementType, std::shared_ptr<void> storage, size_t count) {
+	switch (elementType) {
+		case ElementType::uint8:
+			return OtUint8Array::create(std::static_pointer_cast<uint8_t[]>(storage), 0, count);
+
+		case ElementType::int32:
+			return OtInt32Array::create(std::static_pointer_cast<int32_t[]>(storage), 0, count);
+
+		case ElementType::float32:
+			return OtFloat32Array::create(std::static_pointer_cast<float[]>(storage), 0, count);
+
+		default:
+			return OtFloat64Array::create(std::static_pointer_cast<double[]>(storage), 0, count);
+	}
+}
+
+
+//
+//	OtTypedArrayClass::getMeta
+//
+
+OtType OtTypedArrayClass::getMeta() {
+	thread_local OtType type;
+
+	if (!type) {
+		// this is an abstract class so we use the collection allocator which is never called
+		type = OtType::create<OtCollectionClass>("TypedArray", OtCollectionClass::getMeta(), []() {
+			OtLogError("Can't create an instance of abstract class [TypedArray]");
+			return OtObject();
+		});
+
+		type->set("__index__", OtFunction::create(&OtTypedArrayClass::index));
+		type->set("__iter__", OtFunction::create(&OtTypedArrayClass::iterate));
+		type->set("size", OtFunction::create(&OtTypedArrayClass::size));
+	}
+
+	return type;
+}
+
+
+//
+//	OtTypedArrayExpression
+//
+//	Compiles a simple arithmetic expression in "x" (the element value) and "i"
+//	(the element index) into a postfix program. The program is evaluated on
+//	blocks of elements at a time so every step is a loop the compiler can
+//	vectorize.
+//
+
+class OtTypedArrayExpression {
+public:
+	// constructor
+	OtTypedArrayExpression(const std::string& e) : expression(e) {
+		skipWhitespace();
+		parseExpression();
+
+		if (position != expression.size()) {
+			error("unexpected character");
+		}
+	}
+
+	// block size used during evaluation
+	static constexpr size_t blockSize = 256;
+
+	// evaluate the expression for a block of values (in place)
+	void evaluate(double* values, size_t first, size_t count) {
+		if (registers.size() < maxDepth) {
+			registers.resize(maxDepth);
+		}
+
+		size_t sp = 0;
+
+		for (auto& instruction : program) {
+			switch (instruction.opcode) {
+				case Opcode::constant: {
+					auto& r = registers[sp++];
+					std::fill(r.begin(), r.begin() + count, instruction.value);
+					break;
+				}
+
+				case Opcode::x: {
+					auto& r = registers[sp++];
+					std::copy(values, values + count, r.begin());
+					break;
+				}
+
+				case Opcode::i: {
+					auto& r = registers[sp++];
+
+					for (size_t j = 0; j < count; j++) {
+						r[j] = static_cast<double>(first + j);
+					}
+
+					break;
+				}
+
+				case Opcode::add: binary(sp, count, [](double a, double b) { return a + b; }); break;
+				case Opcode::subtract: binary(sp, count, [](double a, double b) { return a - b; }); break;
+				case Opcode::multiply: binary(sp, count, [](double a, double b) { return a * b; }); break;
+				case Opcode::divide: binary(sp, count, [](double a, double b) { return a / b; }); break;
+				case Opcode::power: binary(sp, count, [](double a, double b) { return std::pow(a, b); }); break;
+				case Opcode::min: binary(sp, count, [](double a, double b) { return std::min(a, b); }); break;
+				case Opcode::max: binary(sp, count, [](double a, double b) { return std::max(a, b); }); break;
+
+				case Opcode::negate: unary(sp, count, [](double a) { return -a; }); break;
+				case Opcode::abs: unary(sp, count, [](double a) { return std::abs(a); }); break;
+				case Opcode::sqrt: unary(sp, count, [](double a) { return std::sqrt(a); }); break;
+				case Opcode::sin: unary(sp, count, [](double a) { return std::sin(a); }); break;
+				case Opcode::cos: unary(sp, count, [](double a) { return std::cos(a); }); break;
+				case Opcode::tan: unary(sp, count, [](double a) { return std::tan(a); }); break;
+				case Opcode::exp: unary(sp, count, [](double a) { return std::exp(a); }); break;
+				case Opcode::log: unary(sp, count, [](double a) { return std::log(a); }); break;
+				case Opcode::floor: unary(sp, count, [](double a) { return std::floor(a); }); break;
+				case Opcode::ceil: unary(sp, count, [](double a) { return std::ceil(a); }); break;
+				case Opcode::round: unary(sp, count, [](double a) { return std::round(a); }); break;
+			}
+		}
+
+		std::copy(registers[0].begin(), registers[0].begin() + count, values);
+	}
+
+private:
+	// program
+	enum class Opcode {
+		constant, x, i,
+		add, subtract, multiply, divide, power, min, max,
+		negate, abs, sqrt, sin, cos, tan, exp, log, floor, ceil, round
+	};
+
+	struct Instruction {
+		Opcode opcode;
+		double value;
+	};
+
+	std::vector<Instruction> program;
+	size_t depth = 0;
+	size_t maxDepth = 0;
+	std::vector<std::array<double, blockSize>> registers;
+
+	// emit an instruction and track the stack depth
+	void emit(Opcode opcode, int stackEffect, double value=0.0) {
+		program.push_back(Instruction{opcode, value});
+		depth += stackEffect;
+		maxDepth = std::max(maxDepth, depth);
+	}
+
+	// apply operations to the top of the stack
+	template <typename Operation>
+	inline void binary(size_t& sp, size_t count, Operation operation) {
+		auto& a = registers[sp - 2];
+		auto& b = registers[sp - 1];
+
+		for (size_t j = 0; j < count; j++) {
+			a[j] = operation(a[j], b[j]);
+		}
+
+		sp--;
+	}
+
+	template <typename Operation>
+	inline void unary(size_t& sp, size_t count, Operation operation) {
+		auto& a = registers[sp - 1];
+
+		for (size_t j = 0; j < count; j++) {
+			a[j] = operation(a[j]);
+		}
+	}
+
+	// parser
+	const std::string& expression;
+	size_t position = 0;
+
+	void skipWhitespace() {
+		while (position < expression.size() && std::isspace(static_cast<unsigned char>(expression[position]))) {
+			position++;
+		}
+	}
+
+	bool match(char ch) {
+		if (position < expression.size() && expression[position] == ch) {
+			position++;
+			skipWhitespace();
+			return true;
+
+		} else {
+			return false;
+		}
+	}
+
+	void parseExpression() {
+		parseTerm();
+
+		while (true) {
+			if (match('+')) {
+				parseTerm();
+				emit(Opcode::add, -1);
+
+			} else if (match('-')) {
+				parseTerm();
+				emit(Opcode::subtract, -1);
+
+			} else {
+				return;
+			}
+		}
+	}
+
+	void parseTerm() {
+		parseUnary();
+
+		while (true) {
+			if (match('*')) {
+				parseUnary();
+				emit(Opcode::multiply, -1);
+
+			} else if (match('/')) {
+				parseUnary();
+				emit(Opcode::divide, -1);
+
+			} else {
+				return;
+			}
+		}
+	}
+
+	void parseUnary() {
+		if (match('-')) {
+			parseUnary();
+			emit(Opcode::negate, 0);
+
+		} else if (match('+')) {
+			parseUnary();
+
+		} else {
+			parsePrimary();
+
+			if (match('^')) {
+				parseUnary();
+				emit(Opcode::power, -1);
+			}
+		}
+	}
+
+	void parsePrimary() {
+		if (position >= expression.size()) {
+			error("unexpected end of expression");
+		}
+
+		auto ch = static_cast<unsigned char>(expression[position]);
+
+		if (std::isdigit(ch) || ch == '.') {
+			char* end;
+			auto value = std::strtod(expression.c_str() + position, &end);
+			position = end - expression.c_str();
+			skipWhitespace();
+			emit(Opcode::constant, 1, value);
+
+		} else if (std::isalpha(ch)) {
+			auto start = position;
+
+			while (position < expression.size() && std::isalnum(static_cast<unsigned char>(expression[position]))) {
+				position++;
+			}
+
+			auto name = expression.substr(start, position - start);
+			skipWhitespace();
+
+			if (name == "x") {
+				emit(Opcode::x, 1);
+
+			} else if (name == "i") {
+				emit(Opcode::i, 1);
+
+			} else if (name == "pi") {
+				emit(Opcode::constant, 1, 3.14159265358979323846);
+
+			} else {
+				parseFunction(name);
+			}
+
+		} else if (match('(')) {
+			parseExpression();
+
+			if (!match(')')) {
+				error("expected [)]");
+			}
+
+		} else {
+			error("unexpected character");
+		}
+	}
+
+	void parseFunction(const std::string& name) {
+		static const struct {
+			const char* name;
+			Opcode opcode;
+			size_t arguments;
+		} functions[] = {
+			{"abs", Opcode::abs, 1},
+			{"sqrt", Opcode::sqrt, 1},
+			{"sin", Opcode::sin, 1},
+			{"cos", Opcode::cos, 1},
+			{"tan", Opcode::tan, 1},
+			{"exp", Opcode::exp, 1},
+			{"log", Opcode::log, 1},
+			{"floor", Opcode::floor, 1},
+			{"ceil", Opcode::ceil, 1},
+			{"round", Opcode::round, 1},
+			{"min", Opcode::min, 2},
+			{"max", Opcode::max, 2},
+			{"pow", Opcode::power, 2}
+		};
+
+		for (auto& function : functions) {
+			if (name == function.name) {
+				if (!match('(')) {
+					error("expected [(] after [" + name + "]");
+				}
+
+				for (size_t i = 0; i < function.arguments; i++) {
+					if (i && !match(',')) {
+						error("expected [,] in call to [" + name + "]");
+					}
+
+					parseExpression();
+				}
+
+				if (!match(')')) {
+					error("expected [)] in call to [" + name + "]");
+				}
+
+				emit(function.opcode, 1 - static_cast<int>(function.arguments));
+				return;
+			}
+		}
+
+		error("unknown name [" + name + "]");
+	}
+
+	void error(const std::string& message) {
+		OtLogError("Invalid expression [{}]: {}", expression, message);
+	}
+};
+
+
+//
+//	Element conversion helpers
+//
+
+template <typename T>
+static inline T fromReal(double value) {
+	if constexpr (std::is_integral_v<T>) {
+		// avoid undefined behavior for values that don't fit
+		if (std::isnan(value)) {
+			return 0;
+
+		} else {
+			return static_cast<T>(std::clamp(
+				value,
+				static_cast<double>(std::numeric_limits<T>::min()),
+				static_cast<double>(std::numeric_limits<T>::max())));
+		}
+
+	} else {
+		return static_cast<T>(value);
+	}
+}
+
+// integer elements wrap around on overflow (the arithmetic is done unsigned as signed overflow is undefined)
+template <typename T>
+static inline T wrappingAdd(T a, T b) {
+	if constexpr (std::is_integral_v<T>) {
+		return static_cast<T>(static_cast<uint64_t>(a) + static_cast<uint64_t>(b));
+
+	} else {
+		return a + b;
+	}
+}
+
+template <typename T>
+static inline T wrappingSubtract(T a, T b) {
+	if constexpr (std::is_integral_v<T>) {
+		return static_cast<T>(static_cast<uint64_t>(a) - static_cast<uint64_t>(b));
+
+	} else {
+		return a - b;
+	}
+}
+
+template <typename T>
+static inline T wrappingMultiply(T a, T b) {
+	if constexpr (std::is_integral_v<T>) {
+		return static_cast<T>(static_cast<uint64_t>(a) * static_cast<uint64_t>(b));
+
+	} else {
+		return a * b;
+	}
+}
+
+template <typename T>
+static inline T wrappingDivide(T a, T b) {
+	if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+		// the smallest value divided by -1 doesn't fit either
+		return b == -1 ? wrappingSubtract<T>(0, a) : static_cast<T>(a / b);
+
+	} else {
+		return static_cast<T>(a / b);
+	}
+}
+
+template <typename T>
+static inline T fromObject(OtObject& object) {
+	if constexpr (std::is_integral_v<T>) {
+		return static_cast<T>(object->operator int64_t());
+
+	} else {
+		return static_cast<T>(object->operator double());
+	}
+}
+
+template <typename T>
+static constexpr const char* getTypedArrayName() {
+	if constexpr (std::is_same_v<T, uint8_t>) {
+		return "Uint8Array";
+
+	} else if constexpr (std::is_same_v<T, int32_t>) {
+		return "Int32Array";
+
+	} else if constexpr (std::is_same_v<T, float>) {
+		return "Float32Array";
+
+	} else {
+		return "Float64Array";
+	}
+}
+
+
+//
+//	OtNumericArrayClass::OtNumericArrayClass
+//
+
+template <typename T>
+OtNumericArrayClass<T>::OtNumericArrayClass(std::shared_ptr<T[]> s, size_t o, size_t c) : storage(s), offset(o) {
+	data = getValues();
+	count = c;
+}
+
+
+//
+//	OtNumericArrayClass::allocate
+//
+
+template <typename T>
+void OtNumericArrayClass<T>::allocate(size_t size) {
+	storage = std::shared_ptr<T[]>(new T[size]());
+	offset = 0;
+	data = storage.get();
+	count = size;
+}
+
+
+//
+//	OtNumericArrayClass::init
+//
+
+template <typename T>
+void OtNumericArrayClass<T>::init(size_t argc, OtObject* parameters) {
+	if (argc == 0) {
+		allocate(0);
+
+	} else if (argc != 1) {
+		OtLogError("[{}] constructor expects 0 or 1 parameters not [{}]", getTypeName(), argc);
+
+	} else if (parameters[0].isKindOf<OtArrayClass>()) {
+		auto& entries = OtArray(parameters[0])->raw();
+		allocate(entries.size());
+		auto values = getValues();
+
+		for (size_t i = 0; i < count; i++) {
+			values[i] = fromObject<T>(entries[i]);
+		}
+
+	} else if (parameters[0].isKindOf<OtTypedArrayClass>()) {
+		OtTypedArray source = parameters[0];
+		allocate(source->size());
+		auto values = getValues();
+
+		for (size_t i = 0; i < count; i++) {
+			values[i] = fromReal<T>(source->getReal(i));
+		}
+
+	} else {
+		auto size = parameters[0]->operator int64_t();
+
+		if (size < 0) {
+			OtLogError("[{}] size can't be negative", getTypeName());
+		}
+
+		allocate(static_cast<size_t>(size));
+	}
+}
+
+
+//
+//	OtNumericArrayClass::operator std::string
+//
+
+template <typename T>
+OtNumericArrayClass<T>::operator std::string() {
+	std::ostringstream o;
+	auto values = getValues();
+	o << "[";
+
+	for (size_t i = 0; i < count; i++) {
+		if (i) {
+			o << ",";
+		}
+
+		if constexpr (std::is_integral_v<T>) {
+			o << std::to_string(static_cast<int64_t>(values[i]));
+
+		} else {
+			o << std::to_string(static_cast<double>(values[i]));
+		}
+	}
+
+	o << "]";
+	return o.str();
+}
+
+
+//
+//	OtNumericArrayClass::getEntry
+//
+
+template <typename T>
+OtObject OtNumericArrayClass<T>::getEntry(size_t index) {
+	checkIndex(index);
+	return toObject(getValues()[index]);
+}
+
+
+//
+//	OtNumericArrayClass::setEntry
+//
+
+template <typename T>
+OtObject OtNumericArrayClass<T>::setEntry(size_t index, OtObject object) {
+	checkIndex(index);
+	getValues()[index] = fromObject<T>(object);
+	return object;
+}
+
+
+//
+//	OtNumericArrayClass::toObject
+//
+
+template <typename T>
+OtObject OtNumericArrayClass<T>::toObject(T value) {
+	if constexpr (std::is_integral_v<T>) {
+		return OtInteger::create(static_cast<int64_t>(value));
+
+	} else {
+		return OtReal::create(static_cast<double>(value));
+	}
+}
+
+
+//
+//	OtNumericArrayClass::fill
+//
+
+template <typename T>
+OtObject OtNumericArrayClass<T>::fill(OtObject value) {
+	auto values = getValues();
+	std::fill(values, values + count, fromObject<T>(value));
+	return OtObject(this);
+}
+
+
+//
+//	OtNumericArrayClass::apply
+//
+
+template <typename T>
+template <typename Operation>
+OtObject OtNumericArrayClass<T>::apply(OtObject operand, Operation operation, bool isDivision) {
+	auto values = getValues();
+
+	if (operand.isKindOf<OtTypedArrayClass>()) {
+		OtTypedArray other = operand;
+
+		if (other->size() != count) {
+			OtLogError("Typed array sizes don't match ([{}] and [{}])", count, other->size());
+		}
+
+		// use the other array's storage directly if it has the same element type
+		if (other->getElementType() == getElementType()) {
+			auto otherValues = other->getData<T>();
+
+			if constexpr (std::is_integral_v<T>) {
+				if (isDivision && std::find(otherValues, otherValues + count, T(0)) != otherValues + count) {
+					OtLogError("Divide by zero");
+				}
+			}
+
+			for (size_t i = 0; i < count; i++) {
+				values[i] = operation(values[i], otherValues[i]);
+			}
+
+		} else {
+			for (size_t i = 0; i < count; i++) {
+				auto value = fromReal<T>(other->getReal(i));
+
+				if constexpr (std::is_integral_v<T>) {
+					if (isDivision && value == 0) {
+						OtLogError("Divide by zero");
+					}
+				}
+
+				values[i] = operation(values[i], value);
+			}
+		}
+
+	} else {
+		auto value = fromObject<T>(operand);
+
+		if constexpr (std::is_integral_v<T>) {
+			if (isDivision && value == 0) {
+				OtLogError("Divide by zero");
+			}
+		}
+
+		for (size_t i = 0; i < count; i++) {
+			values[i] = operation(values[i], value);
+		}
+	}
+
+	return OtObject(this);
+}
+
+
+//
+//	OtNumericArrayClass arithmetic
+//
+
+template <typename T>
+OtObject OtNumericArrayClass<T>::add(OtObject operand) {
+	return apply(operand, [](T a, T b) { return wrappingAdd(a, b); });
+}
+
+template <typename T>
+OtObject OtNumericArrayClass<T>::subtract(OtObject operand) {
+	return apply(operand, [](T a, T b) { return wrappingSubtract(a, b); });
+}
+
+template <typename T>
+OtObject OtNumericArrayClass<T>::multiply(OtObject operand) {
+	return apply(operand, [](T a, T b) { return wrappingMultiply(a, b); });
+}
+
+template <typename T>
+OtObject OtNumericArrayClass<T>::divide(OtObject operand) {
+	return apply(operand, [](T a, T b) { return wrappingDivide(a, b); }, true);
+}
+
+template <typename T>
+OtObject OtNumericArrayClass<T>::scale(double factor) {
+	auto values = getValues();
+
+	if constexpr (std::is_integral_v<T>) {
+		for (size_t i = 0; i < count; i++) {
+			values[i] = fromReal<T>(values[i] * factor);
+		}
+
+	} else {
+		auto f = static_cast<T>(factor);
+
+		for (size_t i = 0; i < count; i++) {
+			values[i] *= f;
+		}
+	}
+
+	return OtObject(this);
+}
+
+
+//
+//	OtNumericArrayClass::map
+//
+
+template <typename T>
+OtObject OtNumericArrayClass<T>::map(OtObject function) {
+	auto values = getValues();
+
+	if (function.isKindOf<OtStringClass>()) {
+		// evaluate expression a block at a time
+		OtTypedArrayExpression expression(OtString(function)->getValue());
+		double block[OtTypedArrayExpression::blockSize];
+
+		for (size_t first = 0; first < count; first += OtTypedArrayExpression::blockSize) {
+			auto size = std::min(count - first, OtTypedArrayExpression::blockSize);
+
+			for (size_t i = 0; i < size; i++) {
+				block[i] = static_cast<double>(values[first + i]);
+			}
+
+			expression.evaluate(block, first, size);
+
+			for (size_t i = 0; i < size; i++) {
+				values[first + i] = fromReal<T>(block[i]);
+			}
+		}
+
+	} else {
+		// call script function for each element
+		static OtID callID = OtIdentifier::create("__call__");
+		auto call = function->get(callID);
+
+		for (size_t i = 0; i < count; i++) {
+			auto value = toObject(values[i]);
+			auto result = OtVM::callMemberFunction(function, call, size_t(1), &value);
+			values[i] = fromReal<T>(result->operator double());
+		}
+	}
+
+	return OtObject(this);
+}
+
+
+//
+//	OtNumericArrayClass::dot
+//
+
+template <typename T>
+double OtNumericArrayClass<T>::dot(OtObject operand) {
+	if (!operand.isKindOf<OtTypedArrayClass>()) {
+		OtLogError("Dot product requires a typed array, not a [{}]", operand.getTypeName());
+	}
+
+	OtTypedArray other = operand;
+
+	if (other->size() != count) {
+		OtLogError("Typed array sizes don't match ([{}] and [{}])", count, other->size());
+	}
+
+	auto values = getValues();
+	double result = 0.0;
+
+	if (other->getElementType() == getElementType()) {
+		auto otherValues = other->getData<T>();
+
+		for (size_t i = 0; i < count; i++) {
+			result += static_cast<double>(values[i]) * static_cast<double>(otherValues[i]);
+		}
+
+	} else {
+		for (size_t i = 0; i < count; i++) {
+			result += static_cast<double>(values[i]) * other->getReal(i);
+		}
+	}
+
+	return result;
+}
+
+
+//
+//	OtNumericArrayClass::sum
+//
+
+template <typename T>
+OtObject OtNumericArrayClass<T>::sum() {
+	auto values = getValues();
+
+	if constexpr (std::is_integral_v<T>) {
+		int64_t result = 0;
+
+		for (size_t i = 0; i < count; i++) {
+			result += values[i];
+		}
+
+		return OtInteger::create(result);
+
+	} else {
+		// use independent accumulators to shorten the dependency chain
+		double lanes[4] = {0.0, 0.0, 0.0, 0.0};
+		size_t i = 0;
+
+		for (; i + 4 <= count; i += 4) {
+			lanes[0] += values[i];
+			lanes[1] += values[i + 1];
+			lanes[2] += values[i + 2];
+			lanes[3] += values[i + 3];
+		}
+
+		for (; i < count; i++) {
+			lanes[0] += values[i];
+		}
+
+		return OtReal::create((lanes[0] + lanes[1]) + (lanes[2] + lanes[3]));
+	}
+}
+
+
+//
+//	OtNumericArrayClass::min
+//
+
+template <typename T>
+OtObject OtNumericArrayClass<T>::min() {
+	if (!count) {
+		OtLogError("Can't determine the minimum of an empty [{}]", getTypeName());
+	}
+
+	auto values = getValues();
+	auto result = values[0];
+
+	for (size_t i = 1; i < count; i++) {
+		result = std::min(result, values[i]);
+	}
+
+	return toObject(result);
+}
+
+
+//
+//	OtNumericArrayClass::max
+//
+
+template <typename T>
+OtObject OtNumericArrayClass<T>::max() {
+	if (!count) {
+		OtLogError("Can't determine the maximum of an empty [{}]", getTypeName());
+	}
+
+	auto values = getValues();
+	auto result = values[0];
+
+	for (size_t i = 1; i < count; i++) {
+		result = std::max(result, values[i]);
+	}
+
+	return toObject(result);
+}
+
+
+//
+//	OtNumericArrayClass::view
+//
+
+template <typename T>
+OtObject OtNumericArrayClass<T>::view(size_t start, size_t size) {
+	if (start > count || size > count - start) {
+		OtLogError("View [{}, {}] is outside typed array of size [{}]", start, size, count);
+	}
+
+	return OtObjectPointer<OtNumericArrayClass<T>>::create(storage, offset + start, size);
+}
+
+
+//
+//	OtNumericArrayClass::detach
+//
+
+template <typename T>
+std::shared_ptr<void> OtNumericArrayClass<T>::detach() {
+	if (storage.use_count() > 1) {
+		OtLogError("Can't transfer a [{}] that shares its storage with a view", getTypeName());
+	}
+
+	// the result shares ownership of the storage but points at our first element
+	std::shared_ptr<void> result(storage, getValues());
+	storage.reset();
+	offset = 0;
+	data = nullptr;
+	count = 0;
+	return result;
+}
+
+
+//
+//	OtNumericArrayClass::clone
+//
+
+template <typename T>
+OtObject OtNumericArrayClass<T>::clone() {
+	auto result = OtObjectPointer<OtNumericArrayClass<T>>::create();
+	result->allocate(count);
+	std::copy(getValues(), getValues() + count, result->getValues());
+	return result;
+}
+
+
+//
+//	OtNumericArrayClass::toArray
+//
+
+template <typename T>
+OtObject OtNumericArrayClass<T>::toArray() {
+	auto result = OtArray::create();
+	auto& entries = result->raw();
+	entries.reserve(count);
+	auto values = getValues();
+
+	for (size_t i = 0; i < count; i++) {
+		entries.emplace_back(toObject(values[i]));
+	}
+
+	return result;
+}
+
+
+//
+//	OtNumericArrayClass::getMeta
+//
+
+template <typename T>
+OtType OtNumericArrayClass<T>::getMeta() {
+	thread_local OtType type;
+
+	if (!type) {
+		type = OtType::create<OtNumericArrayClass<T>>(getTypedArrayName<T>(), OtTypedArrayClass::getMeta());
+
+		type->set("string", OtFunction::create(&OtNumericArrayClass<T>::operator std::string));
+		type->set("__init__", OtFunction::create(&OtNumericArrayClass<T>::init));
+
+		type->set("fill", OtFunction::create(&OtNumericArrayClass<T>::fill));
+		type->set("add", OtFunction::create(&OtNumericArrayClass<T>::add));
+		type->set("subtract", OtFunction::create(&OtNumericArrayClass<T>::subtract));
+		type->set("multiply", OtFunction::create(&OtNumericArrayClass<T>::multiply));
+		type->set("divide", OtFunction::create(&OtNumericArrayClass<T>::divide));
+		type->set("scale", OtFunction::create(&OtNumericArrayClass<T>::scale));
+		type->set("map", OtFunction::create(&OtNumericArrayClass<T>::map));
+
+		type->set("dot", OtFunction::create(&OtNumericArrayClass<T>::dot));
+		type->set("sum", OtFunction::create(&OtNumericArrayClass<T>::sum));
+		type->set("min", OtFunction::create(&OtNumericArrayClass<T>::min));
+		type->set("max", OtFunction::create(&OtNumericArrayClass<T>::max));
+
+		type->set("view", OtFunction::create(&OtNumericArrayClass<T>::view));
+		type->set("clone", OtFunction::create(&OtNumericArrayClass<T>::clone));
+		type->set("toArray", OtFunction::create(&OtNumericArrayClass<T>::toArray));
+	}
+
+	return type;
+}
+
+
+//
+//	Explicit instantiations
+//
+
+template class OtNumericArrayClass<uint8_t>;
+template class OtNumericArrayClass<int32_t>;
+template class OtNumericArrayClass<float>;
+template class OtNumericArrayClass<double>;
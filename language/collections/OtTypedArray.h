@@ -0,0 +1,223 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+#pragma once
+
+
+//
+//	Include files
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include "OtCollection.h"
+#include "OtLog.h"
+
+
+//
+//	OtTypedArray
+//
+//	Base class for fixed size arrays of numbers that are stored contiguously.
+//	Native code can access the values directly (see getData) and views share
+//	the storage of the array they were created from.
+//
+
+class OtTypedArrayClass;
+using OtTypedArray = OtObjectPointer<OtTypedArrayClass>;
+
+class OtTypedArrayClass : public OtCollectionClass {
+public:
+	// element types
+	enum class ElementType {
+		uint8,
+		int32,
+		float32,
+		float64
+	};
+
+	// get information about the elements
+	virtual ElementType getElementType() = 0;
+	virtual size_t getElementSize() = 0;
+
+	// get number of elements
+	inline size_t size() { return count; }
+
+	// get direct access to the elements (the type must match)
+	template <typename T>
+	inline T* getData() {
+		if (getElementSize() != sizeof(T) || getElementType() != elementTypeOf<T>()) {
+			OtLogError("Can't access a [{}] as a different type", getTypeName());
+		}
+
+		return static_cast<T*>(data);
+	}
+
+	inline void* getRawData() { return data; }
+
+	// access elements as objects or reals
+	virtual OtObject getEntry(size_t index) = 0;
+	virtual OtObject setEntry(size_t index, OtObject object) = 0;
+	virtual double getReal(size_t index) = 0;
+
+	// support indexing and iteration
+	OtObject index(size_t index);
+	OtObject iterate();
+
+	// move the elements out of the array (used to transfer arrays to another thread)
+	// this fails if the storage is shared with views and leaves the array empty
+	virtual std::shared_ptr<void> detach() = 0;
+
+	// create a typed array that takes ownership of existing storage
+	static OtTypedArray adopt(ElementType elementType, std::shared_ptr<void> storage, size_t count);
+
+	// get type definition
+	static OtType getMeta();
+
+protected:
+	// constructor
+	friend class OtObjectPointer<OtTypedArrayClass>;
+	OtTypedArrayClass() = default;
+
+	// sanity check an index
+	inline void checkIndex(size_t index) {
+		if (index >= count) {
+			OtLogError("invalid index [{}] for typed array of size [{}]", index, count);
+		}
+	}
+
+	// map C++ type to element type
+	template <typename T>
+	static constexpr ElementType elementTypeOf() {
+		if constexpr (std::is_same_v<T, uint8_t>) {
+			return ElementType::uint8;
+
+		} else if constexpr (std::is_same_v<T, int32_t>) {
+			return ElementType::int32;
+
+		} else if constexpr (std::is_same_v<T, float>) {
+			return ElementType::float32;
+
+		} else {
+			static_assert(std::is_same_v<T, double>, "Unsupported typed array element type");
+			return ElementType::float64;
+		}
+	}
+
+	// location and number of elements (set by derived classes)
+	void* data = nullptr;
+	size_t count = 0;
+};
+
+
+//
+//	OtNumericArray
+//
+//	Typed array implementation for a specific element type. Bulk operations
+//	are written as simple loops over contiguous memory so the compiler can
+//	vectorize them.
+//
+
+template <typename T>
+class OtNumericArrayClass : public OtTypedArrayClass {
+public:
+	// conversion operators
+	operator std::string() override;
+
+	// debugging support
+	inline std::string describe() override { return std::to_string(count) + " entries"; }
+
+	// initialize array (from a size, an array or another typed array)
+	void init(size_t count, OtObject* parameters);
+
+	// get information about the elements
+	inline ElementType getElementType() override { return elementTypeOf<T>(); }
+	inline size_t getElementSize() override { return sizeof(T); }
+	inline T* getValues() { return storage.get() + offset; }
+
+	// access elements
+	OtObject getEntry(size_t index) override;
+	OtObject setEntry(size_t index, OtObject object) override;
+	inline double getReal(size_t index) override { return static_cast<double>(getValues()[index]); }
+
+	// bulk operations (in place, integer elements wrap around on overflow)
+	OtObject fill(OtObject value);
+	OtObject add(OtObject operand);
+	OtObject subtract(OtObject operand);
+	OtObject multiply(OtObject operand);
+	OtObject divide(OtObject operand);
+	OtObject scale(double factor);
+
+	// replace every element with the result of a function or an expression in "x" (value) and "i" (index)
+	OtObject map(OtObject function);
+
+	// reductions
+	double dot(OtObject operand);
+	OtObject sum();
+	OtObject min();
+	OtObject max();
+
+	// create a view that shares this array's storage
+	OtObject view(size_t start, size_t count);
+
+	// move the elements out of the array
+	std::shared_ptr<void> detach() override;
+
+	// create copies
+	OtObject clone();
+	OtObject toArray();
+
+	// get type definition
+	static OtType getMeta();
+
+protected:
+	// constructors
+	friend class OtObjectPointer<OtNumericArrayClass<T>>;
+	friend class OtTypedArrayClass;
+	OtNumericArrayClass() = default;
+	OtNumericArrayClass(std::shared_ptr<T[]> s, size_t o, size_t c);
+
+private:
+	// (re)allocate storage
+	void allocate(size_t size);
+
+	// apply an element-wise operation with a scalar or another typed array
+	template <typename Operation>
+	OtObject apply(OtObject operand, Operation operation, bool isDivision=false);
+
+	// convert a value to an object of the right type
+	OtObject toObject(T value);
+
+	// shared storage
+	std::shared_ptr<T[]> storage;
+	size_t offset = 0;
+};
+
+
+//
+//	Supported typed arrays
+//
+
+using OtUint8ArrayClass = OtNumericArrayClass<uint8_t>;
+using OtUint8Array = OtObjectPointer<OtUint8ArrayClass>;
+
+using OtInt32ArrayClass = OtNumericArrayClass<int32_t>;
+using OtInt32Array = OtObjectPointer<OtInt32ArrayClass>;
+
+using OtFloat32ArrayClass = OtNumericArrayClass<float>;
+using OtFloat32Array = OtObjectPointer<OtFloat32ArrayClass>;
+
+using OtFloat64ArrayClass = OtNumericArrayClass<double>;
+using OtFloat64Array = OtObjectPointer<OtFloat64ArrayClass>;
+
+extern template class OtNumericArrayClass<uint8_t>;
+extern template class OtNumericArrayClass<int32_t>;
+extern template class OtNumericArrayClass<float>;
+extern template class OtNumericArrayClass<double>;
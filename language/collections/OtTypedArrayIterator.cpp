@@ -0,0 +1,30 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+//
+//	Include files
+//
+
+#include "OtFunction.h"
+#include "OtTypedArrayIterator.h"
+
+
+//
+//	OtTypedArrayIteratorClass::getMeta
+//
+
+OtType OtTypedArrayIteratorClass::getMeta() {
+	thread_local OtType type;
+
+	if (!type) {
+		type = OtType::create<OtTypedArrayIteratorClass>("TypedArrayIterator", OtIteratorClass::getMeta());
+		type->set("__end__", OtFunction::create(&OtTypedArrayIteratorClass::end));
+		type->set("__next__", OtFunction::create(&OtTypedArrayIteratorClass::next));
+	}
+
+	return type;
+}
@@ -0,0 +1,49 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+#pragma once
+
+
+//
+//	Include files
+//
+
+#include "OtIterator.h"
+#include "OtTypedArray.h"
+
+
+//
+//	OtTypedArrayIteratorClass
+//
+
+class OtTypedArrayIteratorClass;
+using OtTypedArrayIterator = OtObjectPointer<OtTypedArrayIteratorClass>;
+
+class OtTypedArrayIteratorClass : public OtIteratorClass {
+public:
+	// iteration operations
+	inline bool end() { return index == array->size(); }
+	inline OtObject next() { return array->getEntry(index++); }
+
+	// cycle collector support
+	inline void traverse(OtObjectTraverser& traverser) override { OtIteratorClass::traverse(traverser); traverser(array); }
+	inline void clearReferences() override { OtIteratorClass::clearReferences(); array = nullptr; }
+
+	// get type definition
+	static OtType getMeta();
+
+protected:
+	// constructors
+	friend class OtObjectPointer<OtTypedArrayIteratorClass>;
+	OtTypedArrayIteratorClass() = default;
+	OtTypedArrayIteratorClass(OtTypedArray a) : array(a) {}
+
+private:
+	// data
+	OtTypedArray array;
+	size_t index {0};
+};
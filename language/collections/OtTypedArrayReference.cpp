@@ -0,0 +1,30 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+//
+//	Include files
+//
+
+#include "OtFunction.h"
+#include "OtTypedArrayReference.h"
+
+
+//
+//	OtTypedArrayReferenceClass::getMeta
+//
+
+OtType OtTypedArrayReferenceClass::getMeta() {
+	thread_local OtType type;
+
+	if (!type) {
+		type = OtType::create<OtTypedArrayReferenceClass>("TypedArrayReference", OtReferenceClass::getMeta());
+		type->set("__deref__", OtFunction::create(&OtTypedArrayReferenceClass::deref));
+		type->set("__assign__", OtFunction::create(&OtTypedArrayReferenceClass::assign));
+	}
+
+	return type;
+}
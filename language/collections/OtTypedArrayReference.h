@@ -0,0 +1,54 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+#pragma once
+
+
+//
+//	Include files
+//
+
+#include <string>
+
+#include "OtReference.h"
+#include "OtTypedArray.h"
+
+
+//
+//	OtTypedArrayReferenceClass
+//
+
+class OtTypedArrayReferenceClass;
+using OtTypedArrayReference = OtObjectPointer<OtTypedArrayReferenceClass>;
+
+class OtTypedArrayReferenceClass : public OtReferenceClass {
+public:
+	// debugging support
+	inline std::string describe() override { return "[" + std::to_string(index) + "]"; }
+
+	// (de)reference functions
+	inline OtObject deref() { return array->getEntry(index); }
+	inline OtObject assign(OtObject object) { array->setEntry(index, object); return object; }
+
+	// cycle collector support
+	inline void traverse(OtObjectTraverser& traverser) override { OtReferenceClass::traverse(traverser); traverser(array); }
+	inline void clearReferences() override { OtReferenceClass::clearReferences(); array = nullptr; }
+
+	// get type definition
+	static OtType getMeta();
+
+protected:
+	// constructors
+	friend class OtObjectPointer<OtTypedArrayReferenceClass>;
+	OtTypedArrayReferenceClass() = default;
+	OtTypedArrayReferenceClass(OtTypedArray a, size_t i) : array(a), index(i) {}
+
+private:
+	// data
+	OtTypedArray array;
+	size_t index;
+};
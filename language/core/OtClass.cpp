@@ -66,7 +66,7 @@ OtObject OtClassClass::instantiate(size_t count, OtObject* parameters) {
 	OtLogError("Unknown member [{}] in superclass of [{}]", name, type->getName());
 
 	// we will never get here because of the exception but a return statement keeps the compiler happy
-	return members->get(id);
+	return nullptr;
  }
 
 
@@ -75,7 +75,7 @@ OtObject OtClassClass::instantiate(size_t count, OtObject* parameters) {
 //
 
 OtType OtClassClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtClassClass>("Class", OtInternalClass::getMeta());
@@ -47,6 +47,7 @@ public:
 	inline OtObject get(OtID id) override { return OtInternalClass::has(id) ? OtInternalClass::get(id) : classType->get(id); }
 	inline OtObject set(OtID id, OtObject value) override { return classType->set(id, value); }
 	inline void unset(OtID id) override { return classType->unset(id); }
+	inline bool isMemberCacheable(OtID) override { return false; }
 
 	// special superclass member access
 	OtObject getSuper(OtID id);
@@ -0,0 +1,430 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+//
+//	Include files
+//
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "OtCycleCollector.h"
+#include "OtLibuv.h"
+#include "OtObject.h"
+
+
+//
+//	Collector state (one per thread)
+//
+//	The state is never freed as objects can be destroyed (and leave the
+//	candidate buffer) during static destruction after thread locals are gone.
+//
+
+struct OtCycleCollectorState {
+	// candidate roots
+	std::vector<OtObjectClass*> candidates;
+
+	// work lists (kept to avoid reallocations)
+	std::vector<OtObjectClass*> roots;
+	std::vector<OtObjectClass*> stack;
+	std::vector<OtObjectClass*> garbage;
+
+	// set while garbage is being freed
+	bool freeing = false;
+
+	// libuv integration
+	bool started = false;
+	uv_check_t checkHandle;
+	uv_idle_t idleHandle;
+	std::chrono::steady_clock::time_point lastCollection;
+
+	// statistics
+	OtCycleCollector::Statistics statistics;
+};
+
+static thread_local OtCycleCollectorState* collectorState = nullptr;
+
+static inline OtCycleCollectorState& getState() {
+	if (!collectorState) {
+		collectorState = new OtCycleCollectorState;
+	}
+
+	return *collectorState;
+}
+
+
+//
+//	Collector tuning
+//
+
+// number of candidates processed in one trial deletion
+static constexpr size_t batchSize = 256;
+
+// a slice runs when this many candidates are waiting (or when the last collection was a while ago)
+static constexpr size_t sliceThreshold = 4096;
+static constexpr std::chrono::milliseconds sliceInterval{1000};
+
+// time budget for a single slice
+static constexpr double sliceBudget = 2.0;
+
+
+//
+//	Object state helpers
+//
+
+uint32_t OtCycleCollector::getColor(OtObjectClass* object) {
+	return object->cycleInfo & colorMask;
+}
+
+void OtCycleCollector::setColor(OtObjectClass* object, uint32_t color) {
+	object->cycleInfo = (object->cycleInfo & ~colorMask) | color;
+}
+
+size_t OtCycleCollector::getPosition(OtObjectClass* object) {
+	return (object->cycleInfo >> positionShift);
+}
+
+void OtCycleCollector::setPosition(OtObjectClass* object, size_t position) {
+	object->cycleInfo = (object->cycleInfo & ~positionMask) | static_cast<uint32_t>(position << positionShift);
+}
+
+
+//
+//	Traversers for the various phases
+//
+
+template <typename Visit>
+class OtCycleTraverser : public OtObjectTraverser {
+public:
+	OtCycleTraverser(Visit v) : callback(v) {}
+	void visit(OtObjectClass* object) override { callback(object); }
+
+private:
+	Visit callback;
+};
+
+template <typename Visit>
+static inline void traverse(OtObjectClass* object, Visit visit) {
+	OtCycleTraverser<Visit> traverser(visit);
+	object->traverse(traverser);
+}
+
+
+//
+//	OtCycleCollector::release
+//
+
+bool OtCycleCollector::release(OtObjectClass* object) {
+	if (object->referenceCount == 0) {
+		delete object;
+		return true;
+
+	} else {
+		addCandidate(object);
+		return false;
+	}
+}
+
+
+//
+//	OtCycleCollector::addCandidate
+//
+
+void OtCycleCollector::addCandidate(OtObjectClass* object) {
+	auto& state = getState();
+
+	// releasing garbage produces no new cycles
+	if (!state.freeing) {
+		state.candidates.push_back(object);
+		setPosition(object, state.candidates.size());
+	}
+}
+
+
+//
+//	OtCycleCollector::removeCandidate
+//
+
+void OtCycleCollector::removeCandidate(OtObjectClass* object) {
+	auto& state = getState();
+	auto position = getPosition(object) - 1;
+	auto last = state.candidates.back();
+
+	// move the last candidate into the hole
+	state.candidates[position] = last;
+	setPosition(last, position + 1);
+	state.candidates.pop_back();
+	setPosition(object, 0);
+}
+
+
+//
+//	OtCycleCollector::collect
+//
+
+size_t OtCycleCollector::collect() {
+	auto& state = getState();
+	auto start = std::chrono::steady_clock::now();
+	size_t freed = 0;
+
+	while (state.candidates.size()) {
+		freed += collectBatch(batchSize);
+	}
+
+	std::chrono::duration<double, std::milli> pause = std::chrono::steady_clock::now() - start;
+	state.statistics.collections++;
+	state.statistics.slices++;
+	state.statistics.lastPause = pause.count();
+	state.statistics.maxPause = std::max(state.statistics.maxPause, pause.count());
+	state.statistics.totalPause += pause.count();
+	state.lastCollection = std::chrono::steady_clock::now();
+	return freed;
+}
+
+
+//
+//	OtCycleCollector::collectSlice
+//
+
+bool OtCycleCollector::collectSlice(double milliseconds) {
+	auto& state = getState();
+	auto start = std::chrono::steady_clock::now();
+	std::chrono::duration<double, std::milli> elapsed{0.0};
+
+	while (state.candidates.size() && elapsed.count() < milliseconds) {
+		collectBatch(batchSize);
+		elapsed = std::chrono::steady_clock::now() - start;
+	}
+
+	state.statistics.slices++;
+	state.statistics.lastPause = elapsed.count();
+	state.statistics.maxPause = std::max(state.statistics.maxPause, elapsed.count());
+	state.statistics.totalPause += elapsed.count();
+
+	if (state.candidates.empty()) {
+		state.statistics.collections++;
+		state.lastCollection = std::chrono::steady_clock::now();
+		return false;
+
+	} else {
+		return true;
+	}
+}
+
+
+//
+//	OtCycleCollector::collectBatch
+//
+
+size_t OtCycleCollector::collectBatch(size_t count) {
+	auto& state = getState();
+	auto& roots = state.roots;
+	auto& stack = state.stack;
+	auto& garbage = state.garbage;
+
+	// take the most recent candidates
+	roots.clear();
+
+	while (count-- && state.candidates.size()) {
+		auto object = state.candidates.back();
+		state.candidates.pop_back();
+		setPosition(object, 0);
+		roots.push_back(object);
+	}
+
+	// mark the graphs reachable from the roots gray while subtracting internal references
+	for (auto root : roots) {
+		if (getColor(root) != gray) {
+			setColor(root, gray);
+			stack.push_back(root);
+
+			while (stack.size()) {
+				auto object = stack.back();
+				stack.pop_back();
+
+				traverse(object, [&](OtObjectClass* child) {
+					child->referenceCount--;
+
+					if (getColor(child) != gray) {
+						setColor(child, gray);
+						stack.push_back(child);
+					}
+				});
+			}
+		}
+	}
+
+	// objects that still have references are alive (and so is everything they refer to)
+	// the others are tentatively garbage
+	auto scanBlack = [&](OtObjectClass* start) {
+		setColor(start, black);
+		auto base = stack.size();
+		stack.push_back(start);
+
+		while (stack.size() > base) {
+			auto object = stack.back();
+			stack.pop_back();
+
+			traverse(object, [&](OtObjectClass* child) {
+				child->referenceCount++;
+
+				if (getColor(child) != black) {
+					setColor(child, black);
+					stack.push_back(child);
+				}
+			});
+		}
+	};
+
+	for (auto root : roots) {
+		stack.push_back(root);
+
+		while (stack.size()) {
+			auto object = stack.back();
+			stack.pop_back();
+
+			if (getColor(object) == gray) {
+				if (object->referenceCount > 0) {
+					scanBlack(object);
+
+				} else {
+					setColor(object, white);
+
+					traverse(object, [&](OtObjectClass* child) {
+						stack.push_back(child);
+					});
+				}
+			}
+		}
+	}
+
+	// gather the garbage
+	garbage.clear();
+
+	for (auto root : roots) {
+		auto size = garbage.size();
+
+		if (getColor(root) == white) {
+			setColor(root, black);
+			stack.push_back(root);
+
+			while (stack.size()) {
+				auto object = stack.back();
+				stack.pop_back();
+				garbage.push_back(object);
+
+				traverse(object, [&](OtObjectClass* child) {
+					if (getColor(child) == white) {
+						setColor(child, black);
+						stack.push_back(child);
+					}
+				});
+			}
+		}
+
+		if (garbage.size() != size) {
+			state.statistics.cyclesCollected++;
+		}
+	}
+
+	if (garbage.empty()) {
+		return 0;
+	}
+
+	// restore the references held by garbage objects so normal reference counting can take over
+	for (auto object : garbage) {
+		traverse(object, [](OtObjectClass* child) {
+			child->referenceCount++;
+		});
+	}
+
+	// break the cycles and release the garbage (this runs the destructors)
+	std::vector<OtObject> hold(garbage.begin(), garbage.end());
+	auto freed = garbage.size();
+	state.freeing = true;
+
+	for (auto& object : hold) {
+		object->clearReferences();
+	}
+
+	hold.clear();
+	state.freeing = false;
+	state.statistics.objectsCollected += freed;
+	return freed;
+}
+
+
+//
+//	runSlice
+//
+
+static void runSlice() {
+	auto& state = getState();
+	auto due = std::chrono::steady_clock::now() - state.lastCollection > sliceInterval;
+
+	if (state.candidates.size() >= sliceThreshold || (due && state.candidates.size())) {
+		// keep the loop spinning (using the idle handle) until all candidates are processed
+		if (OtCycleCollector::collectSlice(sliceBudget)) {
+			uv_idle_start(&state.idleHandle, [](uv_idle_t*) {});
+
+		} else {
+			uv_idle_stop(&state.idleHandle);
+		}
+	}
+}
+
+
+//
+//	OtCycleCollector::start
+//
+
+void OtCycleCollector::start() {
+	auto& state = getState();
+
+	if (!state.started) {
+		state.started = true;
+		state.lastCollection = std::chrono::steady_clock::now();
+
+		// see after every loop iteration if there is enough work for a slice
+		uv_check_init(OtLibUv::getLoop(), &state.checkHandle);
+		uv_idle_init(OtLibUv::getLoop(), &state.idleHandle);
+
+		uv_check_start(&state.checkHandle, [](uv_check_t*) {
+			runSlice();
+		});
+
+		// the collector doesn't keep the loop alive
+		uv_unref(reinterpret_cast<uv_handle_t*>(&state.checkHandle));
+		uv_unref(reinterpret_cast<uv_handle_t*>(&state.idleHandle));
+	}
+}
+
+
+//
+//	OtCycleCollector::end
+//
+
+void OtCycleCollector::end() {
+	collect();
+
+	// (the handles were closed with the loop)
+	delete collectorState;
+	collectorState = nullptr;
+}
+
+
+//
+//	OtCycleCollector::getStatistics
+//
+
+OtCycleCollector::Statistics OtCycleCollector::getStatistics() {
+	auto& state = getState();
+	auto statistics = state.statistics;
+	statistics.candidates = state.candidates.size();
+	return statistics;
+}
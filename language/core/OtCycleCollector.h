@@ -0,0 +1,98 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+#pragma once
+
+
+//
+//	Include files
+//
+
+#include <cstddef>
+#include <cstdint>
+
+
+//
+//	Forward declarations
+//
+
+class OtObjectClass;
+
+
+//
+//	OtCycleCollector
+//
+//	Reference counting can't reclaim objects that refer to each other. This
+//	collector uses trial deletion (Bacon and Rajan's synchronous algorithm) to
+//	find such cycles. Objects whose reference count drops to a non-zero value
+//	are recorded as candidate roots. A collection subtracts all references
+//	that originate inside the subgraphs reachable from the candidates and
+//	objects that end up without references are garbage.
+//
+//	Collections run in slices from the libuv loop (so they never interrupt
+//	native code that holds raw object pointers) or when a script asks for one.
+//	Each thread has its own candidate buffer.
+//
+
+class OtCycleCollector {
+public:
+	// per object state (stored in OtObjectClass::cycleInfo)
+	static constexpr uint32_t black = 0;
+	static constexpr uint32_t gray = 1;
+	static constexpr uint32_t white = 2;
+	static constexpr uint32_t colorMask = 3;
+	static constexpr uint32_t acyclicFlag = 4;
+	static constexpr uint32_t positionShift = 3;
+	static constexpr uint32_t positionMask = ~((1u << positionShift) - 1);
+
+	// see if an object whose reference count dropped must become a candidate
+	// (it's not when it already is one or when its type can't be part of a cycle)
+	static inline bool isPossibleRoot(uint32_t info) { return (info & (positionMask | acyclicFlag)) == 0; }
+
+	// handle an object whose reference count dropped (returns true if it was deleted)
+	static bool release(OtObjectClass* object);
+
+	// manage candidate roots
+	static void addCandidate(OtObjectClass* object);
+	static void removeCandidate(OtObjectClass* object);
+
+	// collect all cycles reachable from the candidates (returns the number of objects freed)
+	static size_t collect();
+
+	// run a collection slice that takes roughly the specified time (returns true if candidates are left)
+	static bool collectSlice(double milliseconds);
+
+	// run collection slices from the libuv loop on the calling thread
+	static void start();
+
+	// collect everything and free the calling thread's collector state (for threads that are about to end)
+	static void end();
+
+	// get statistics for the calling thread
+	struct Statistics {
+		size_t candidates = 0;
+		size_t collections = 0;
+		size_t slices = 0;
+		size_t cyclesCollected = 0;
+		size_t objectsCollected = 0;
+		double lastPause = 0.0;
+		double maxPause = 0.0;
+		double totalPause = 0.0;
+	};
+
+	static Statistics getStatistics();
+
+private:
+	// process a batch of candidates (returns the number of objects freed)
+	static size_t collectBatch(size_t count);
+
+	// access the per object state
+	static uint32_t getColor(OtObjectClass* object);
+	static void setColor(OtObjectClass* object, uint32_t color);
+	static size_t getPosition(OtObjectClass* object);
+	static void setPosition(OtObjectClass* object, size_t position);
+};
@@ -12,15 +12,18 @@
 //	Include files
 //
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <list>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <string_view>
 #include <unordered_map>
-#include <vector>
 
+#include "OtLog.h"
 #include "OtSingleton.h"
 
 
@@ -34,6 +37,10 @@ using OtID = uint64_t;
 //
 //	OtIdentifier
 //
+//	Identifiers are shared by all threads. Names and hashes live in fixed
+//	segments that never move so they can be read without locking. Only
+//	looking up (and creating) identifiers by name takes a lock.
+//
 
 class OtIdentifier : OtSingleton<OtIdentifier> {
 public:
@@ -51,7 +58,12 @@ public:
 	}
 
 	static inline std::string_view name(OtID id) {
-		return instance().get(id);
+		return instance().getEntry(id).name;
+	}
+
+	// get the (cached) hash of an identifier's name (the same as std::hash<std::string>)
+	static inline size_t hash(OtID id) {
+		return instance().getEntry(id).hash;
 	}
 
 private:
@@ -66,21 +78,53 @@ private:
 
 	inline OtID get(const std::string_view text) {
 		// see if this id was already created
-		if (identifierIndex.count(text)) {
-			return identifierIndex[text];
-
-		} else {
-			OtID id = (OtID) identifiers.size();
-			auto name = saveIdentifier(text);
-			identifiers.emplace_back(name);
-			identifierIndex[name] = id;
-			return id;
+		{
+			std::shared_lock<std::shared_mutex> lock(mutex);
+			auto i = identifierIndex.find(text);
+
+			if (i != identifierIndex.end()) {
+				return i->second;
+			}
+		}
+
+		// no, create it (unless another thread beat us to it)
+		std::unique_lock<std::shared_mutex> lock(mutex);
+		auto i = identifierIndex.find(text);
+
+		if (i != identifierIndex.end()) {
+			return i->second;
+		}
+
+		OtID id = (OtID) count;
+		auto segment = id / segmentSize;
+
+		if (segment >= maxSegments) {
+			OtLogFatal("Too many identifiers");
+		}
+
+		if (!segments[segment].load(std::memory_order_relaxed)) {
+			segments[segment].store(new Entry[segmentSize], std::memory_order_release);
 		}
+
+		auto name = saveIdentifier(text);
+		auto& entry = segments[segment].load(std::memory_order_relaxed)[id % segmentSize];
+		entry.name = name;
+		entry.hash = std::hash<std::string_view>{}(name);
+		identifierIndex[name] = id;
+		count++;
+		return id;
 	}
 
-	// get the string associated with the id
-	inline const std::string_view get(OtID id) {
-		return identifiers[id];
+	// identifier details
+	struct Entry {
+		std::string_view name;
+		size_t hash;
+	};
+
+	// get the details associated with the id
+	// (ids are handed out after their entry is complete and an id reaches other threads through synchronized means)
+	inline Entry& getEntry(OtID id) {
+		return segments[id / segmentSize].load(std::memory_order_acquire)[id % segmentSize];
 	}
 
 	// buffer to store text chunks
@@ -91,7 +135,7 @@ private:
 		size_t next = 0;
 
 		// see if we have space for a specified number of characters
-		bool hasSpace(size_t space) { return capacity - next > space; }
+		bool hasSpace(size_t space) { return capacity - next >= space; }
 
 		// add a new chunk to the buffer and return pointer
 		const std::string_view addChunk(const std::string_view text) {
@@ -105,8 +149,13 @@ private:
 
 	// save named id
 	inline std::string_view saveIdentifier(const std::string_view text) {
+		// names that don't fit in a buffer get their own storage
+		if (text.size() > Buffer::capacity) {
+			return std::string_view(largeNames.emplace_back(text));
+		}
+
 		// create a new chunk buffer if required
-		if (!buffers.size() || buffers.back().hasSpace(text.size())) {
+		if (!buffers.size() || !buffers.back().hasSpace(text.size())) {
 			buffers.emplace_back();
 		}
 
@@ -115,9 +164,15 @@ private:
 	}
 
 	// properties
+	std::shared_mutex mutex;
 	std::list<Buffer> buffers;
+	std::list<std::string> largeNames;
+
+	// identifiers already in use (stored in segments that are allocated on demand)
+	static constexpr size_t segmentSize = 4096;
+	static constexpr size_t maxSegments = 4096;
+	std::atomic<Entry*> segments[maxSegments] = {};
+	size_t count = 0;
 
-	// list of identifiers already in use
-	std::vector<std::string_view> identifiers;
 	std::unordered_map<std::string_view, OtID> identifierIndex;
 };
@@ -17,7 +17,7 @@
 //
 
 OtType OtInternalClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtInternalClass>("Internal", OtObjectClass::getMeta());
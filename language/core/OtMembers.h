@@ -63,6 +63,14 @@ public:
 		}
 	}
 
+	// visit the member objects in place (without touching their reference counts)
+	template <typename CB>
+	inline void eachObject(CB callback) {
+		for (size_t i = 0; i < size; i++) {
+			callback(entries[i].object);
+		}
+	}
+
 private:
 	// a single entry in the hash table
 	static constexpr size_t noNext = std::numeric_limits<size_t>::max();
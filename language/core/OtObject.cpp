@@ -21,7 +21,15 @@
 //
 
 OtObjectClass::~OtObjectClass() {
+	if (cycleInfo & OtCycleCollector::positionMask) {
+		OtCycleCollector::removeCandidate(this);
+	}
+
 	unsetAll();
+
+	if (type) {
+		type->removeInstance();
+	}
 }
 
 
@@ -30,7 +38,7 @@ OtObjectClass::~OtObjectClass() {
 //
 
 bool OtObjectClass::has(OtID id) {
-	if (members && members->has(id)) {
+	if (slots && slots->has(id)) {
 		return true;
 	}
 
@@ -49,11 +57,12 @@ bool OtObjectClass::has(OtID id) {
 //
 
 OtObject OtObjectClass::set(OtID id, OtObject value) {
-	if (!members) {
-		members = new OtMembers;
+	if (!slots) {
+		// objects that don't have a type yet (i.e. during construction) share a separate shape tree
+		slots = OtSlots::create(type ? type->getRootShape() : OtType::getUntypedShape());
 	}
 
-	members->set(id, value);
+	slots = OtSlots::set(slots, id, value);
 	return value;
 }
 
@@ -63,8 +72,8 @@ OtObject OtObjectClass::set(OtID id, OtObject value) {
 //
 
 OtObject OtObjectClass::get(OtID id) {
-	if (members && members->has(id)) {
-		return members->get(id);
+	if (slots && slots->has(id)) {
+		return slots->get(id);
 	}
 
 	for (auto t = type; t; t = t->getParent()) {
@@ -87,8 +96,8 @@ OtObject OtObjectClass::get(OtID id) {
 //
 
 void OtObjectClass::unset(OtID id) {
-	if (members && members->has(id)) {
-		members->unset(id);
+	if (slots && slots->has(id)) {
+		slots = OtSlots::unset(slots, id);
 
 	} else {
 		auto name = OtIdentifier::name(id);
@@ -102,13 +111,37 @@ void OtObjectClass::unset(OtID id) {
 //
 
 void OtObjectClass::unsetAll() {
-	if (members) {
-		delete members;
-		members = nullptr;
+	if (slots) {
+		// detach members first as their destruction could lead back to this object
+		auto oldSlots = slots;
+		slots = nullptr;
+		OtSlots::destroy(oldSlots);
 	}
 }
 
 
+//
+//	OtObjectClass::traverse
+//
+
+void OtObjectClass::traverse(OtObjectTraverser& traverser) {
+	if (slots) {
+		slots->eachObject([&](OtObject& member) {
+			traverser(member);
+		});
+	}
+}
+
+
+//
+//	OtObjectClass::clearReferences
+//
+
+void OtObjectClass::clearReferences() {
+	OtObjectClass::unsetAll();
+}
+
+
 //
 //	OtObjectClass::operator==
 //
@@ -123,6 +156,21 @@ bool OtObjectClass::operator==(OtObject operand) {
 }
 
 
+//
+//	OtObjectClass::hash
+//
+
+size_t OtObjectClass::hash() {
+	// all null objects are equal, everything else compares by identity
+	if (type == getMeta()) {
+		return 0;
+
+	} else {
+		return std::hash<OtObjectClass*>{}(this);
+	}
+}
+
+
 //
 //	OtObjectClass::operator<
 //
@@ -166,7 +214,7 @@ OtObject OtObjectClass::getClass() {
 //
 
 OtType OtObjectClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtObjectClass>("Object", nullptr);
@@ -14,11 +14,14 @@
 
 #include <cstdint>
 #include <functional>
+#include <new>
 #include <string>
 #include <vector>
 
-#include "OtMembers.h"
+#include "OtCycleCollector.h"
 #include "OtObjectPointer.h"
+#include "OtShape.h"
+#include "OtSlabAllocator.h"
 #include "OtType.h"
 
 
@@ -37,10 +40,52 @@ using OtClass = OtObjectPointer<OtClassClass>;
 class OtObjectClass;
 using OtObject = OtObjectPointer<OtObjectClass>;
 
+
+//
+//	OtObjectTraverser
+//
+//	Visits the objects another object holds references to (see
+//	OtObjectClass::traverse). Visitors must not change the references.
+//
+
+class OtObjectTraverser {
+public:
+	// destructor
+	virtual ~OtObjectTraverser() = default;
+
+	// visit a referenced object
+	virtual void visit(OtObjectClass* object) = 0;
+
+	// visit a reference (null references are skipped)
+	template <typename T>
+	inline void operator()(OtObjectPointer<T>& object) {
+		if (object) {
+			visit(object.raw());
+		}
+	}
+};
+
 class OtObjectClass {
 public:
 	// type access
-	inline void setType(OtType t) { type = t; }
+	inline void setType(OtType t) {
+		if (type) {
+			type->removeInstance();
+		}
+
+		type = t;
+
+		if (type) {
+			type->addInstance();
+
+			if (type->isAcyclic()) {
+				cycleInfo |= OtCycleCollector::acyclicFlag;
+
+			} else {
+				cycleInfo &= ~OtCycleCollector::acyclicFlag;
+			}
+		}
+	}
 	inline OtType getType() { return type; }
 	inline std::string getTypeName() { return type->getName(); }
 
@@ -82,19 +127,38 @@ public:
 	inline OtObject getByName(const std::string& name) { return get(OtIdentifier::create(name)); }
 	inline void unsetByName(const std::string& name) { return unset(OtIdentifier::create(name)); }
 
-	bool hasMembers() { return members != nullptr; }
+	bool hasMembers() { return slots != nullptr; }
+	inline bool hasInstanceMember(OtID id) { return slots && slots->has(id); }
+
+	// access the instance's member layout (nullptr if instance has no members)
+	inline OtShape* getShape() { return slots ? slots->getShape() : nullptr; }
+	inline OtObject& getSlot(size_t slot) { return slots->getSlot(slot); }
+
+	// see if a member lookup can be cached by type (it can't if derived classes resolve the member dynamically)
+	virtual inline bool isMemberCacheable([[maybe_unused]] OtID id) { return true; }
 
 	// iterate through the members
-	inline void eachMember(std::function<void(OtID, OtObject object)> callback) { if (members) { members->each(callback); } }
-	inline void eachMemberID(std::function<void(OtID)> callback) { if (members) { members->eachID(callback); } }
+	inline void eachMember(std::function<void(OtID, OtObject object)> callback) { if (slots) { slots->each(callback); } }
+	inline void eachMemberID(std::function<void(OtID)> callback) { if (slots) { slots->each([&](OtID id, OtObject) { callback(id); }); } }
 
 	// comparison
 	virtual bool operator==(OtObject operand);
 	virtual bool operator<(OtObject operand);
 
 	inline bool equal(OtObject operand) { return operator==(operand); }
+
+	// get hash (objects that compare by value must return the same hash for equal values)
+	virtual size_t hash();
+
 	inline bool notEqual(OtObject operand) { return !(operator==(operand)); }
 
+	// visit all objects this object holds references to (each reference is visited once)
+	// classes that store references outside of the members must override this (and clearReferences)
+	virtual void traverse(OtObjectTraverser& traverser);
+
+	// drop all references to other objects (used to break cycles of garbage objects)
+	virtual void clearReferences();
+
 	// "call" object (count, parameters)
 	virtual OtObject operator() (size_t, OtObject*) { return nullptr; }
 
@@ -104,6 +168,14 @@ public:
 	// get type definition
 	static OtType getMeta();
 
+	// memory management (instances are allocated from per-thread slabs)
+	static inline void* operator new(size_t size) { return OtSlabAllocator::allocate(size); }
+	static inline void operator delete(void* pointer, size_t size) { OtSlabAllocator::release(pointer, size); }
+
+	// over-aligned instances bypass the slabs
+	static inline void* operator new(size_t size, std::align_val_t alignment) { return ::operator new(size, alignment); }
+	static inline void operator delete(void* pointer, std::align_val_t alignment) { ::operator delete(pointer, alignment); }
+
 protected:
 	// constructors/destructor (rule of 6)
 	friend class OtObjectPointer<OtObjectClass>;
@@ -121,10 +193,13 @@ private:
 	// object type
 	OtType type;
 
-	// reference count
-	size_t referenceCount = 0;
+	// reference count and cycle collector state
+	uint32_t referenceCount = 0;
+	uint32_t cycleInfo = 0;
 	template <typename T> friend class OtObjectPointer;
+	friend class OtCycleCollector;
+	friend class OtJit;
 
-	// members
-	OtMembers* members = nullptr;
+	// members (stored in slots described by a shape shared with similar instances)
+	OtSlots* slots = nullptr;
 };
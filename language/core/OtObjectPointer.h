@@ -19,6 +19,7 @@
 #include <utility>
 
 #include "OtAssert.h"
+#include "OtCycleCollector.h"
 #include "OtLog.h"
 
 
@@ -29,6 +30,21 @@
 class OtObjectClass;
 
 
+//
+//	Reference counting is on every hot path so it is always inlined (large
+//	functions like the VM's dispatch loop would otherwise exhaust the
+//	compiler's inlining budget)
+//
+
+#if defined(__GNUC__)
+#define OT_ALWAYS_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define OT_ALWAYS_INLINE __forceinline
+#else
+#define OT_ALWAYS_INLINE inline
+#endif
+
+
 //
 //	Shared pointer (not thread safe, not all the bells and whistles but fast)
 //
@@ -79,7 +95,7 @@ public:
 	}
 
 	// destructor
-	inline ~OtObjectPointer() {
+	OT_ALWAYS_INLINE ~OtObjectPointer() {
 		decrementReference();
 	}
 
@@ -179,17 +195,18 @@ public:
 
 private:
 	// increment instance reference count
-	inline void incrementReference() {
+	OT_ALWAYS_INLINE void incrementReference() {
 		if (ptr) {
 			ptr->referenceCount++;
 		}
 	}
 
 	// decrement instance reference count and delete instance if required
-	inline void decrementReference() {
-		if (ptr) {
-			if (--ptr->referenceCount == 0) {
-				delete ptr;
+	// (instances that survive could be part of a cycle and are handed to the cycle collector,
+	// both cases are handled out of line to keep this small enough to be inlined everywhere)
+	OT_ALWAYS_INLINE void decrementReference() {
+		if (ptr && (--ptr->referenceCount == 0 || OtCycleCollector::isPossibleRoot(ptr->cycleInfo))) {
+			if (OtCycleCollector::release(ptr)) {
 				ptr = nullptr;
 			}
 		}
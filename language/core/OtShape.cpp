@@ -0,0 +1,221 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+//
+//	Include files
+//
+
+#include <algorithm>
+#include <new>
+
+#include "OtObject.h"
+#include "OtShape.h"
+#include "OtSlabAllocator.h"
+
+
+//
+//	OtShape::OtShape
+//
+
+OtShape::OtShape(OtShape* parent, OtID id) : root(parent->root), ids(parent->ids) {
+	ids.push_back(id);
+
+	if (ids.size() > linearSearchLimit) {
+		for (size_t i = 0; i < ids.size(); i++) {
+			index[ids[i]] = i;
+		}
+	}
+}
+
+
+//
+//	OtShape::addMember
+//
+
+OtShape* OtShape::addMember(OtID id) {
+	if (ids.size() >= maxSlots) {
+		return nullptr;
+	}
+
+	// see if we already have a transition for this member
+	OtShape* shape = nullptr;
+
+	for (auto& [transitionID, transition] : transitions) {
+		if (transitionID == id) {
+			shape = transition.get();
+			break;
+		}
+	}
+
+	// if not, create one
+	if (!shape) {
+		shape = transitions.emplace_back(id, std::make_unique<OtShape>(this, id)).second.get();
+	}
+
+	// remember how many slots instances in this tree need so new ones can be allocated at the right size
+	root->expectedSlots = std::max(root->expectedSlots, shape->ids.size());
+	return shape;
+}
+
+
+//
+//	OtShape::dictionary
+//
+
+OtShape* OtShape::dictionary() {
+	static OtShape shape;
+	return &shape;
+}
+
+
+//
+//	OtSlots::create
+//
+
+OtSlots* OtSlots::create(OtShape* shape) {
+	return allocate(shape, std::max(shape->getExpectedSlots(), size_t(2)));
+}
+
+
+//
+//	OtSlots::destroy
+//
+
+void OtSlots::destroy(OtSlots* slots) {
+	if (slots->dictionary) {
+		delete slots->dictionary;
+	}
+
+	auto values = slots->getValues();
+
+	for (size_t i = 0; i < slots->capacity; i++) {
+		values[i].~OtObject();
+	}
+
+	auto size = sizeof(OtSlots) + slots->capacity * sizeof(OtObject);
+	slots->~OtSlots();
+	OtSlabAllocator::release(slots, size);
+}
+
+
+//
+//	OtSlots::has
+//
+
+bool OtSlots::has(OtID id) {
+	return dictionary ? dictionary->has(id) : shape->find(id) != OtShape::notFound;
+}
+
+
+//
+//	OtSlots::get
+//
+
+OtObject OtSlots::get(OtID id) {
+	return dictionary ? dictionary->get(id) : getValues()[shape->find(id)];
+}
+
+
+//
+//	OtSlots::set
+//
+
+OtSlots* OtSlots::set(OtSlots* slots, OtID id, OtObject value) {
+	if (slots->dictionary) {
+		slots->dictionary->set(id, value);
+		return slots;
+	}
+
+	// update existing member
+	auto slot = slots->shape->find(id);
+
+	if (slot != OtShape::notFound) {
+		slots->getValues()[slot] = value;
+		return slots;
+	}
+
+	// transition to a new shape (or a dictionary if the shape is full)
+	auto shape = slots->shape->addMember(id);
+
+	if (!shape) {
+		slots = toDictionary(slots);
+		slots->dictionary->set(id, value);
+		return slots;
+	}
+
+	// grow storage (if required)
+	slot = slots->shape->getSlotCount();
+
+	if (slot == slots->capacity) {
+		auto newSlots = allocate(shape, slots->capacity * 2);
+		auto oldValues = slots->getValues();
+		auto newValues = newSlots->getValues();
+
+		for (size_t i = 0; i < slot; i++) {
+			newValues[i] = std::move(oldValues[i]);
+		}
+
+		destroy(slots);
+		slots = newSlots;
+	}
+
+	slots->shape = shape;
+	slots->getValues()[slot] = value;
+	return slots;
+}
+
+
+//
+//	OtSlots::unset
+//
+
+OtSlots* OtSlots::unset(OtSlots* slots, OtID id) {
+	if (!slots->dictionary) {
+		slots = toDictionary(slots);
+	}
+
+	slots->dictionary->unset(id);
+	return slots;
+}
+
+
+//
+//	OtSlots::allocate
+//
+
+OtSlots* OtSlots::allocate(OtShape* shape, size_t capacity) {
+	auto slots = new (OtSlabAllocator::allocate(sizeof(OtSlots) + capacity * sizeof(OtObject))) OtSlots;
+	slots->shape = shape;
+	slots->dictionary = nullptr;
+	slots->capacity = capacity;
+
+	auto values = slots->getValues();
+
+	for (size_t i = 0; i < capacity; i++) {
+		new (&values[i]) OtObject;
+	}
+
+	return slots;
+}
+
+
+//
+//	OtSlots::toDictionary
+//
+
+OtSlots* OtSlots::toDictionary(OtSlots* slots) {
+	auto dictionary = allocate(OtShape::dictionary(), 0);
+	dictionary->dictionary = new OtMembers;
+	auto values = slots->getValues();
+
+	for (size_t i = 0; i < slots->shape->getSlotCount(); i++) {
+		dictionary->dictionary->set(slots->shape->getID(i), values[i]);
+	}
+
+	destroy(slots);
+	return dictionary;
+}
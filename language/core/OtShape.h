@@ -0,0 +1,180 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+#pragma once
+
+
+//
+//	Include files
+//
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "OtIdentifier.h"
+#include "OtMembers.h"
+#include "OtObjectPointer.h"
+
+
+//
+//	Forward declarations
+//
+
+class OtObjectClass;
+using OtObject = OtObjectPointer<OtObjectClass>;
+
+
+//
+//	OtShape
+//
+//	Describes the layout of an instance's members (which member lives in which
+//	slot). Shapes form a transition tree that is rooted in a type so instances
+//	that add the same members in the same order share a single shape and only
+//	have to store their values. Shapes live as long as their type (which is
+//	forever unless the thread's types are released when it ends) so inline
+//	caches can use them as a key.
+//
+
+class OtShape {
+public:
+	// constructors
+	OtShape() = default;
+	OtShape(OtShape* parent, OtID id);
+
+	// shapes are shared so they can't be copied or moved
+	OtShape(const OtShape&) = delete;
+	OtShape(OtShape&&) = delete;
+	OtShape& operator=(const OtShape&) = delete;
+	OtShape& operator=(OtShape&&) = delete;
+
+	// maximum number of slots before an instance switches to dictionary mode
+	static constexpr size_t maxSlots = 64;
+	static constexpr size_t notFound = std::numeric_limits<size_t>::max();
+
+	// find the slot for a member (returns notFound if shape doesn't have the member)
+	inline size_t find(OtID id) {
+		if (index.empty()) {
+			for (size_t i = 0; i < ids.size(); i++) {
+				if (ids[i] == id) {
+					return i;
+				}
+			}
+
+			return notFound;
+
+		} else {
+			auto i = index.find(id);
+			return i == index.end() ? notFound : i->second;
+		}
+	}
+
+	// get the shape that results from adding a member (returns nullptr if shape is full)
+	OtShape* addMember(OtID id);
+
+	// access shape information
+	inline size_t getSlotCount() { return ids.size(); }
+	inline OtID getID(size_t slot) { return ids[slot]; }
+	inline bool isDictionary() { return this == dictionary(); }
+
+	// get the number of slots instances of the root's tree typically need
+	inline size_t getExpectedSlots() { return root->expectedSlots; }
+
+	// get the shared shape used by instances in dictionary mode
+	static OtShape* dictionary();
+
+private:
+	// properties
+	OtShape* root = this;
+	std::vector<OtID> ids;
+	std::unordered_map<OtID, size_t> index;
+	std::vector<std::pair<OtID, std::unique_ptr<OtShape>>> transitions;
+	size_t expectedSlots = 0;
+
+	// shapes with more members than this also get a hash index
+	static constexpr size_t linearSearchLimit = 8;
+};
+
+
+//
+//	OtSlots
+//
+//	Member storage for a single instance. It is allocated as one block with
+//	the slot values following the header. In dictionary mode (after a member
+//	was removed or too many were added) the members live in a hash table.
+//
+
+class OtSlots {
+public:
+	// create storage for an instance
+	static OtSlots* create(OtShape* shape);
+
+	// destroy storage
+	static void destroy(OtSlots* slots);
+
+	// access members
+	bool has(OtID id);
+	OtObject get(OtID id);
+
+	// set a member (storage can be reallocated so the caller must use the returned pointer)
+	static OtSlots* set(OtSlots* slots, OtID id, OtObject value);
+
+	// remove a member (switches storage to dictionary mode)
+	static OtSlots* unset(OtSlots* slots, OtID id);
+
+	// iterate through the members
+	template <typename CB>
+	inline void each(CB callback) {
+		if (dictionary) {
+			dictionary->each(callback);
+
+		} else {
+			auto values = getValues();
+
+			for (size_t i = 0; i < shape->getSlotCount(); i++) {
+				callback(shape->getID(i), values[i]);
+			}
+		}
+	}
+
+	// visit the member objects in place (without touching their reference counts)
+	template <typename CB>
+	inline void eachObject(CB callback) {
+		if (dictionary) {
+			dictionary->eachObject(callback);
+
+		} else {
+			auto values = getValues();
+
+			for (size_t i = 0; i < shape->getSlotCount(); i++) {
+				callback(values[i]);
+			}
+		}
+	}
+
+	// access properties
+	inline OtShape* getShape() { return shape; }
+	inline OtObject& getSlot(size_t slot) { return getValues()[slot]; }
+
+private:
+	// properties
+	OtShape* shape;
+	OtMembers* dictionary;
+	size_t capacity;
+
+	// get the slot values (they follow the header)
+	inline OtObject* getValues() { return reinterpret_cast<OtObject*>(this + 1); }
+
+	// allocate storage for the specified number of slots
+	static OtSlots* allocate(OtShape* shape, size_t capacity);
+
+	// switch to dictionary mode
+	static OtSlots* toDictionary(OtSlots* slots);
+};
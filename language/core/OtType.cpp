@@ -9,16 +9,133 @@
 //	Include files
 //
 
+#include <mutex>
+#include <vector>
+
 #include "OtLog.h"
 #include "OtObject.h"
 #include "OtType.h"
 
 
 //
-//	List of all declared types
+//	OtType::getTypes
+//
+//	The main thread's types are never destroyed as objects can outlive them at
+//	program exit (they still reference their type's instance counter and
+//	shapes).
+//
+
+std::list<OtTypeClass>& OtType::getTypes() {
+	static auto types = new std::list<OtTypeClass>;
+	return *types;
+}
+
+
+//
+//	OtType::getMutex
+//
+
+std::recursive_mutex& OtType::getMutex() {
+	static auto mutex = new std::recursive_mutex;
+	return *mutex;
+}
+
+
+//
+//	OtType::each
+//
+
+void OtType::each(std::function<void(OtType)> callback) {
+	// types can be freed when threads end so the list stays locked (callbacks may still create types)
+	std::lock_guard<std::recursive_mutex> lock(getMutex());
+
+	for (auto& type : getTypes()) {
+		callback(OtType(&type));
+	}
+}
+
+
+//
+//	Types created by a thread
+//
+//	This is the first thread local object of threads that release their types
+//	so it is destroyed after all the others (which can hold objects).
+//
+
+struct OtThreadTypes {
+	~OtThreadTypes();
+
+	std::vector<std::list<OtTypeClass>::iterator> types;
+	OtShape* untypedShape = nullptr;
+	bool release = false;
+};
+
+static thread_local OtThreadTypes threadTypes;
+
+OtThreadTypes::~OtThreadTypes() {
+	if (release && OtType::releaseThreadTypes(types)) {
+		delete untypedShape;
+	}
+}
+
+
+//
+//	OtType::releaseAtThreadExit
+//
+
+void OtType::releaseAtThreadExit() {
+	threadTypes.release = true;
+}
+
+
+//
+//	OtType::getUntypedShape
+//
+
+OtShape* OtType::getUntypedShape() {
+	if (!threadTypes.untypedShape) {
+		threadTypes.untypedShape = new OtShape;
+	}
+
+	return threadTypes.untypedShape;
+}
+
+
+//
+//	OtType::addThreadType
 //
 
-std::list<OtTypeClass> OtType::types;
+void OtType::addThreadType(std::list<OtTypeClass>::iterator type) {
+	threadTypes.types.emplace_back(type);
+}
+
+
+//
+//	OtType::releaseThreadTypes
+//
+
+bool OtType::releaseThreadTypes(std::vector<std::list<OtTypeClass>::iterator>& types) {
+	// release the members first (they are instances of these types)
+	for (auto& type : types) {
+		type->members.unsetAll();
+	}
+
+	// types of objects that are still alive (like uncollected cycles) can't go
+	for (auto& type : types) {
+		if (type->instances.load(std::memory_order_relaxed) > 0) {
+			return false;
+		}
+	}
+
+	std::lock_guard<std::recursive_mutex> lock(getMutex());
+
+	for (auto& type : types) {
+		getTypes().erase(type);
+	}
+
+	types.clear();
+	return true;
+}
 
 
 //
@@ -51,6 +168,7 @@ void OtTypeClass::setParent(OtType p) {
 	}
 
 	parent = p;
+	memberVersion++;
 }
 
 
@@ -79,6 +197,7 @@ bool OtTypeClass::isKindOf(const std::string& name) {
 
 OtObject OtTypeClass::set(OtID id, OtObject value) {
 	members.set(id, value);
+	memberVersion++;
 	return value;
 }
 
@@ -12,18 +12,32 @@
 //	Include files
 //
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <functional>
+#include <iterator>
 #include <list>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "OtIdentifier.h"
 #include "OtMembers.h"
 #include "OtObjectPointer.h"
+#include "OtShape.h"
 
 
 //
 //	OtType
 //
+//	Types hold script objects (like member functions) whose reference counts
+//	aren't atomic so every thread builds its own set (getMeta functions keep
+//	them in thread_local variables). The list of all types is shared. Types
+//	normally live forever but threads whose objects all die with them (like
+//	workers) can have their types freed when they end.
+//
 
 class OtTypeClass;
 using OtTypeAllocator = OtObject(*)();
@@ -55,9 +69,30 @@ public:
 	// create an incomplete type (parent must be set later)
 	static inline OtType create(OtID id);
 
+	// iterate through all types
+	static void each(std::function<void(OtType)> callback);
+
+	// free the calling thread's types when it ends (call this before the thread creates any objects)
+	static void releaseAtThreadExit();
+
+	// get the calling thread's shape tree for objects that don't have a type yet (it goes with the types)
+	static OtShape* getUntypedShape();
+
 private:
 	OtTypeClass* type = nullptr;
-	static std::list<OtTypeClass> types;
+
+	// register a new type
+	template <typename... ARGS>
+	static OtTypeClass* add(ARGS&&... args);
+
+	// all types (only the types of threads that asked for it are ever destroyed)
+	static std::list<OtTypeClass>& getTypes();
+	static std::recursive_mutex& getMutex();
+
+	// remember which thread created a type and release a thread's types
+	friend struct OtThreadTypes;
+	static void addThreadType(std::list<OtTypeClass>::iterator type);
+	static bool releaseThreadTypes(std::vector<std::list<OtTypeClass>::iterator>& types);
 };
 
 
@@ -93,18 +128,48 @@ public:
 	OtObject set(OtID id, OtObject value);
 	OtObject set(const char* name, OtObject value);
 	inline OtObject get(OtID id) { return members.get(id); }
-	inline void unset(OtID id) { members.unset(id); }
+	inline void unset(OtID id) { members.unset(id); memberVersion++; }
 
 	// iterate through the members
 	inline void eachMember(std::function<void(OtID, OtObject object)> callback) { members.each(callback); }
 	inline void eachMemberID(std::function<void(OtID)> callback) { members.eachID(callback); }
 
+	// mark the type as one whose instances can't be part of a reference cycle on their own
+	// (the cycle collector doesn't track such instances as candidates)
+	inline void setAcyclic() { acyclic = true; }
+	inline bool isAcyclic() { return acyclic; }
+
+	// get the root of the shape tree shared by this type's instances
+	inline OtShape* getRootShape() { return &rootShape; }
+
+	// track the number of live instances (for capacity planning)
+	// this avoids locked instructions so counts are approximate when threads create the same type concurrently
+	inline void addInstance() { instances.store(instances.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+	inline void removeInstance() { instances.store(instances.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed); }
+	inline size_t getInstanceCount() { return static_cast<size_t>(std::max(instances.load(std::memory_order_relaxed), int64_t(0))); }
+
+	// get the member version (changes whenever a member is added to or removed from any of the calling thread's types)
+	// this allows caches to detect that previous lookups might no longer be valid
+	static inline uint64_t getMemberVersion() { return memberVersion; }
+
 private:
+	// types are released by OtType
+	friend class OtType;
+
+	// native code checks the member version directly
+	friend class OtJit;
+
+	// member version tracker (types and the caches that use them are per thread so this is too)
+	static inline thread_local uint64_t memberVersion = 0;
+
 	// attributes
 	OtID typeID;
 	OtType parent;
 	OtMembers members;
 	OtTypeAllocator allocator;
+	OtShape rootShape;
+	std::atomic<int64_t> instances = 0;
+	bool acyclic = false;
 };
 
 
@@ -125,9 +190,23 @@ OtType OtType::create(OtID id, OtType parent, OtTypeAllocator allocator) {
 		};
 	}
 
-	return OtType(&types.emplace_back(id, parent, allocator));
+	return OtType(add(id, parent, allocator));
 }
 
 inline OtType OtType::create(OtID id) {
-	return OtType(&types.emplace_back(id));
+	return OtType(add(id));
+}
+
+
+//
+//	OtType::add
+//
+
+template <typename... ARGS>
+OtTypeClass* OtType::add(ARGS&&... args) {
+	std::lock_guard<std::recursive_mutex> lock(getMutex());
+	auto& types = getTypes();
+	types.emplace_back(std::forward<ARGS>(args)...);
+	addThreadType(std::prev(types.end()));
+	return &types.back();
 }
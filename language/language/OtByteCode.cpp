@@ -17,6 +17,7 @@
 #include "fmt/format.h"
 
 #include "OtByteCode.h"
+#include "OtByteCodeCache.h"
 #include "OtLog.h"
 #include "OtMemberReference.h"
 #include "OtIdentifier.h"
@@ -104,7 +105,7 @@ std::string OtByteCodeClass::disassemble() {
 				break;
 
 			case Opcode::jumpFalse:
-				buffer << "jumpTrue" << jumps[getNumber(pc)];
+				buffer << "jumpFalse" << jumps[getNumber(pc)];
 				break;
 
 			case Opcode::member:
@@ -113,8 +114,9 @@ std::string OtByteCodeClass::disassemble() {
 
 			case Opcode::method: {
 				auto method = getID(pc);
-				auto count =getNumber(pc);
-				buffer << "method" << OtIdentifier::name(method) << "(" << count << ")";
+				auto count = getNumber(pc);
+				auto cache = getNumber(pc);
+				buffer << "method" << OtIdentifier::name(method) << "(" << count << ") [cache " << cache << "]";
 				break;
 			}
 
@@ -134,6 +136,14 @@ std::string OtByteCodeClass::disassemble() {
 				buffer << "popTry";
 				break;
 
+			case Opcode::iterate: {
+				auto slot = getNumber(pc);
+				auto jump = jumps[getNumber(pc)];
+				auto cache = getNumber(pc);
+				buffer << "iterate" << slot << " " << jump << " [cache " << cache << "]";
+				break;
+			}
+
 			case Opcode::pushStackObject:
 				buffer << "pushStackObject" << getNumber(pc);
 				break;
@@ -141,7 +151,8 @@ std::string OtByteCodeClass::disassemble() {
 			case Opcode::pushStackMember: {
 				auto offset = getNumber(pc);
 				auto memberName = OtIdentifier::name(getID(pc));
-				buffer << "pushStackMember" << offset << " " << memberName;
+				auto cache = getNumber(pc);
+				buffer << "pushStackMember" << offset << " " << memberName << " [cache " << cache << "]";
 				break;
 			}
 
@@ -152,9 +163,12 @@ std::string OtByteCodeClass::disassemble() {
 				break;
 			}
 
-			case Opcode::pushMember:
-				buffer << "pushMember" << OtIdentifier::name(getID(pc));
+			case Opcode::pushMember: {
+				auto memberName = OtIdentifier::name(getID(pc));
+				auto cache = getNumber(pc);
+				buffer << "pushMember" << memberName << " [cache " << cache << "]";
 				break;
+			}
 
 			case Opcode::assignStack:
 				buffer << "assignStack" << getNumber(pc);
@@ -166,6 +180,50 @@ std::string OtByteCodeClass::disassemble() {
 				buffer << "assignMember" << objectName << " " << memberName;
 				break;
 			}
+
+			case Opcode::add:
+				buffer << "add" << "[cache " << getNumber(pc) << "]";
+				break;
+
+			case Opcode::subtract:
+				buffer << "subtract" << "[cache " << getNumber(pc) << "]";
+				break;
+
+			case Opcode::multiply:
+				buffer << "multiply" << "[cache " << getNumber(pc) << "]";
+				break;
+
+			case Opcode::divide:
+				buffer << "divide" << "[cache " << getNumber(pc) << "]";
+				break;
+
+			case Opcode::modulo:
+				buffer << "modulo" << "[cache " << getNumber(pc) << "]";
+				break;
+
+			case Opcode::equal:
+				buffer << "equal" << "[cache " << getNumber(pc) << "]";
+				break;
+
+			case Opcode::notEqual:
+				buffer << "notEqual" << "[cache " << getNumber(pc) << "]";
+				break;
+
+			case Opcode::lessThan:
+				buffer << "lessThan" << "[cache " << getNumber(pc) << "]";
+				break;
+
+			case Opcode::lessEqual:
+				buffer << "lessEqual" << "[cache " << getNumber(pc) << "]";
+				break;
+
+			case Opcode::greaterThan:
+				buffer << "greaterThan" << "[cache " << getNumber(pc) << "]";
+				break;
+
+			case Opcode::greaterEqual:
+				buffer << "greaterEqual" << "[cache " << getNumber(pc) << "]";
+				break;
 		}
 
 		buffer << std::endl;
@@ -180,7 +238,9 @@ std::string OtByteCodeClass::disassemble() {
 //
 
 void OtByteCodeClass::copyOpcode(OtByteCode other, size_t pc) {
-	switch (other->getOpcode(pc)) {
+	auto opcode = other->getOpcode(pc);
+
+	switch (opcode) {
 		case Opcode::statement:
 			statement();
 			break;
@@ -252,6 +312,13 @@ void OtByteCodeClass::copyOpcode(OtByteCode other, size_t pc) {
 			popTry();
 			break;
 
+		case Opcode::iterate: {
+			auto slot = other->getNumber(pc);
+			auto target = other->jumps[other->getNumber(pc)];
+			jumps[iterate(slot)] = target;
+			break;
+		}
+
 		case Opcode::pushStackObject:
 			pushStackObject(other->getNumber(pc));
 			break;
@@ -286,10 +353,494 @@ void OtByteCodeClass::copyOpcode(OtByteCode other, size_t pc) {
 			assignMember(other->constants[object], member);
 			break;
 		}
+
+		case Opcode::add:
+		case Opcode::subtract:
+		case Opcode::multiply:
+		case Opcode::divide:
+		case Opcode::modulo:
+		case Opcode::equal:
+		case Opcode::notEqual:
+		case Opcode::lessThan:
+		case Opcode::lessEqual:
+		case Opcode::greaterThan:
+		case Opcode::greaterEqual:
+			other->getNumber(pc);
+			binaryOperator(opcode);
+			break;
+	}
+}
+
+
+//
+//	OtByteCodeClass::serialize
+//
+
+bool OtByteCodeClass::serialize(OtByteCodeWriter& writer) {
+	writer.writeID(bytecodeID);
+
+	// write constants (nested functions and classes are written recursively)
+	writer.writeNumber(constants.size());
+
+	for (auto& constant : constants) {
+		if (!writer.writeObject(constant)) {
+			return false;
+		}
+	}
+
+	// write jump targets (as original offsets, they are remapped on load)
+	writer.writeNumber(jumps.size());
+
+	for (auto jump : jumps) {
+		writer.writeNumber(jump);
+	}
+
+	// write opcodes with their original offset and operands (caches are recreated on load)
+	size_t end = bytecode.size();
+	size_t count = 0;
+
+	for (size_t pc = 0; pc < end; pc += getOpcodeSize(pc)) {
+		count++;
+	}
+
+	writer.writeNumber(count);
+	size_t pc = 0;
+
+	while (pc < end) {
+		writer.writeNumber(pc);
+		auto opcode = getOpcode(pc);
+		writer.writeByte(static_cast<uint8_t>(opcode));
+
+		switch (opcode) {
+			case Opcode::statement:
+			case Opcode::pushNull:
+			case Opcode::pop:
+			case Opcode::dup:
+			case Opcode::swap:
+			case Opcode::exit:
+			case Opcode::popTry:
+				break;
+
+			case Opcode::push:
+			case Opcode::popCount:
+			case Opcode::move:
+			case Opcode::jump:
+			case Opcode::jumpTrue:
+			case Opcode::jumpFalse:
+			case Opcode::pushTry:
+			case Opcode::pushStackObject:
+			case Opcode::assignStack:
+				writer.writeNumber(getNumber(pc));
+				break;
+
+			case Opcode::member:
+			case Opcode::super:
+				writer.writeID(getID(pc));
+				break;
+
+			case Opcode::method:
+				writer.writeID(getID(pc));
+				writer.writeNumber(getNumber(pc));
+				getNumber(pc);
+				break;
+
+			case Opcode::pushStackMember:
+				writer.writeNumber(getNumber(pc));
+				writer.writeID(getID(pc));
+				getNumber(pc);
+				break;
+
+			case Opcode::iterate:
+				writer.writeNumber(getNumber(pc));
+				writer.writeNumber(getNumber(pc));
+				getNumber(pc);
+				break;
+
+			case Opcode::pushObjectMember:
+			case Opcode::assignMember:
+				writer.writeNumber(getNumber(pc));
+				writer.writeID(getID(pc));
+				break;
+
+			case Opcode::pushMember:
+				writer.writeID(getID(pc));
+				getNumber(pc);
+				break;
+
+			case Opcode::add:
+			case Opcode::subtract:
+			case Opcode::multiply:
+			case Opcode::divide:
+			case Opcode::modulo:
+			case Opcode::equal:
+			case Opcode::notEqual:
+			case Opcode::lessThan:
+			case Opcode::lessEqual:
+			case Opcode::greaterThan:
+			case Opcode::greaterEqual:
+				getNumber(pc);
+				break;
+		}
+	}
+
+	writer.writeNumber(end);
+
+	// write statement table
+	writer.writeNumber(statements.size());
+
+	for (auto& statement : statements) {
+		writer.writeNumber(statement.sourceStart);
+		writer.writeNumber(statement.sourceEnd);
+		writer.writeNumber(statement.opcodeStart);
+		writer.writeNumber(statement.opcodeEnd);
+	}
+
+	// write symbol table
+	writer.writeNumber(symbols.size());
+
+	for (auto& symbol : symbols) {
+		writer.writeByte(static_cast<uint8_t>(symbol.type));
+		writer.writeID(symbol.id);
+
+		if (symbol.type == OtSymbol::Type::heap) {
+			if (!writer.writeReference(symbol.object)) {
+				return false;
+			}
+
+		} else if (symbol.type == OtSymbol::Type::stack) {
+			writer.writeNumber(symbol.slot);
+		}
+
+		writer.writeNumber(symbol.opcodeStart);
+		writer.writeNumber(symbol.opcodeEnd);
+	}
+
+	return true;
+}
+
+
+//
+//	OtByteCodeClass::deserialize
+//
+
+OtByteCode OtByteCodeClass::deserialize(OtByteCodeReader& reader) {
+	OtByteCode result = OtByteCode::create(reader.getSource(), reader.readID());
+
+	// read constants
+	auto constantCount = reader.readCount();
+
+	for (size_t i = 0; i < constantCount && !reader.hasFailed(); i++) {
+		result->constants.emplace_back(reader.readObject());
+	}
+
+	// read jump targets
+	auto jumpCount = reader.readCount();
+
+	for (size_t i = 0; i < jumpCount && !reader.hasFailed(); i++) {
+		result->jumps.emplace_back(reader.readNumber());
+	}
+
+	// helpers to validate operands that index tables
+	auto emitConstantIndex = [&]() {
+		auto index = reader.readNumber();
+
+		if (index < result->constants.size()) {
+			result->emitNumber(index);
+
+		} else {
+			reader.fail();
+		}
+	};
+
+	auto emitJumpIndex = [&]() {
+		auto index = reader.readNumber();
+
+		if (index < result->jumps.size()) {
+			result->emitNumber(index);
+
+		} else {
+			reader.fail();
+		}
+	};
+
+	// re-emit opcodes (identifiers are translated so offsets can change)
+	std::unordered_map<size_t, size_t> offsets;
+	auto opcodeCount = reader.readCount();
+
+	for (size_t i = 0; i < opcodeCount && !reader.hasFailed(); i++) {
+		offsets[reader.readNumber()] = result->bytecode.size();
+		auto byte = reader.readByte();
+
+		if (byte >= OtByteCodeClass::opcodeCount) {
+			reader.fail();
+			break;
+		}
+
+		auto opcode = static_cast<Opcode>(byte);
+		result->emitOpcode(opcode);
+
+		switch (opcode) {
+			case Opcode::statement:
+			case Opcode::pushNull:
+			case Opcode::pop:
+			case Opcode::dup:
+			case Opcode::swap:
+			case Opcode::exit:
+			case Opcode::popTry:
+				break;
+
+			case Opcode::push:
+				emitConstantIndex();
+				break;
+
+			case Opcode::popCount:
+			case Opcode::move:
+			case Opcode::pushStackObject:
+			case Opcode::assignStack:
+				result->emitNumber(reader.readNumber());
+				break;
+
+			case Opcode::jump:
+			case Opcode::jumpTrue:
+			case Opcode::jumpFalse:
+			case Opcode::pushTry:
+				emitJumpIndex();
+				break;
+
+			case Opcode::member:
+			case Opcode::super:
+				result->emitID(reader.readID());
+				break;
+
+			case Opcode::method:
+				result->emitID(reader.readID());
+				result->emitNumber(reader.readNumber());
+				result->emitCache();
+				break;
+
+			case Opcode::pushStackMember:
+				result->emitNumber(reader.readNumber());
+				result->emitID(reader.readID());
+				result->emitCache();
+				break;
+
+			case Opcode::iterate:
+				result->emitNumber(reader.readNumber());
+				emitJumpIndex();
+				result->emitCache(2);
+				break;
+
+			case Opcode::pushObjectMember:
+			case Opcode::assignMember:
+				emitConstantIndex();
+				result->emitID(reader.readID());
+				break;
+
+			case Opcode::pushMember:
+				result->emitID(reader.readID());
+				result->emitCache();
+				break;
+
+			case Opcode::add:
+			case Opcode::subtract:
+			case Opcode::multiply:
+			case Opcode::divide:
+			case Opcode::modulo:
+			case Opcode::equal:
+			case Opcode::notEqual:
+			case Opcode::lessThan:
+			case Opcode::lessEqual:
+			case Opcode::greaterThan:
+			case Opcode::greaterEqual:
+				result->emitCache();
+				break;
+		}
+	}
+
+	offsets[reader.readNumber()] = result->bytecode.size();
+
+	// translate an original offset into a new one
+	auto remap = [&](size_t& offset) {
+		auto i = offsets.find(offset);
+
+		if (i == offsets.end()) {
+			reader.fail();
+
+		} else {
+			offset = i->second;
+		}
+	};
+
+	for (auto& jump : result->jumps) {
+		remap(jump);
+	}
+
+	// read statement table
+	auto statementCount = reader.readCount();
+
+	for (size_t i = 0; i < statementCount && !reader.hasFailed(); i++) {
+		auto sourceStart = reader.readNumber();
+		auto sourceEnd = reader.readNumber();
+		auto opcodeStart = reader.readNumber();
+		auto opcodeEnd = reader.readNumber();
+		remap(opcodeStart);
+		remap(opcodeEnd);
+		result->addStatement(sourceStart, sourceEnd, opcodeStart, opcodeEnd);
+	}
+
+	// read symbol table
+	auto symbolCount = reader.readCount();
+
+	for (size_t i = 0; i < symbolCount && !reader.hasFailed(); i++) {
+		auto type = static_cast<OtSymbol::Type>(reader.readByte());
+		auto id = reader.readID();
+		OtObject object;
+		size_t slot = 0;
+
+		if (type == OtSymbol::Type::heap) {
+			object = reader.readReference();
+
+		} else if (type == OtSymbol::Type::stack) {
+			slot = reader.readNumber();
+
+		} else if (type != OtSymbol::Type::capture) {
+			reader.fail();
+			break;
+		}
+
+		auto opcodeStart = reader.readNumber();
+		auto opcodeEnd = reader.readNumber();
+		remap(opcodeStart);
+		remap(opcodeEnd);
+
+		if (type == OtSymbol::Type::heap) {
+			result->symbols.emplace_back(id, object, opcodeStart);
+
+		} else if (type == OtSymbol::Type::stack) {
+			result->symbols.emplace_back(id, slot, opcodeStart);
+
+		} else {
+			result->symbols.emplace_back(id, opcodeStart);
+		}
+
+		result->symbols.back().opcodeEnd = opcodeEnd;
 	}
+
+	return reader.hasFailed() ? nullptr : result;
 }
 
 
+//
+//	OtByteCodeClass::link
+//
+
+void OtByteCodeClass::link(const void* const* handlers) {
+	// map bytecode offsets to instruction indices (the end maps to a sentinel)
+	size_t end = bytecode.size();
+	std::vector<size_t> index(end + 1);
+	size_t count = 0;
+
+	for (size_t pc = 0; pc < end; pc += getOpcodeSize(pc)) {
+		index[pc] = count++;
+	}
+
+	index[end] = count;
+
+	// decode all instructions
+	instructions.resize(count + 1);
+	auto instruction = instructions.data();
+	size_t pc = 0;
+
+	while (pc < end) {
+		auto opcode = getOpcode(pc);
+		instruction->opcode = opcode;
+
+		switch (opcode) {
+			case Opcode::statement:
+			case Opcode::pushNull:
+			case Opcode::pop:
+			case Opcode::dup:
+			case Opcode::swap:
+			case Opcode::exit:
+			case Opcode::popTry:
+				break;
+
+			case Opcode::popCount:
+			case Opcode::move:
+			case Opcode::member:
+			case Opcode::super:
+			case Opcode::pushStackObject:
+			case Opcode::assignStack:
+				instruction->operand1 = getNumber(pc);
+				break;
+
+			case Opcode::push:
+				instruction->constant = &constants[getNumber(pc)];
+				break;
+
+			case Opcode::jump:
+			case Opcode::jumpTrue:
+			case Opcode::jumpFalse:
+			case Opcode::pushTry:
+				instruction->operand1 = index[jumps[getNumber(pc)]];
+				break;
+
+			case Opcode::method:
+			case Opcode::pushStackMember:
+				instruction->operand1 = getNumber(pc);
+				instruction->operand2 = getNumber(pc);
+				instruction->cache = &caches[getNumber(pc)];
+				break;
+
+			case Opcode::iterate:
+				instruction->operand1 = getNumber(pc);
+				instruction->operand2 = index[jumps[getNumber(pc)]];
+				instruction->cache = &caches[getNumber(pc)];
+				break;
+
+			case Opcode::pushMember:
+				instruction->operand1 = getNumber(pc);
+				instruction->cache = &caches[getNumber(pc)];
+				break;
+
+			case Opcode::pushObjectMember:
+			case Opcode::assignMember:
+				instruction->constant = &constants[getNumber(pc)];
+				instruction->operand1 = getNumber(pc);
+				break;
+
+			case Opcode::add:
+			case Opcode::subtract:
+			case Opcode::multiply:
+			case Opcode::divide:
+			case Opcode::modulo:
+			case Opcode::equal:
+			case Opcode::notEqual:
+			case Opcode::lessThan:
+			case Opcode::lessEqual:
+			case Opcode::greaterThan:
+			case Opcode::greaterEqual:
+				instruction->operand1 = getOperatorMethod(opcode);
+				instruction->cache = &caches[getNumber(pc)];
+				break;
+		}
+
+		instruction->pc = pc;
+		instruction++;
+	}
+
+	// running off the end is the same as an explicit exit
+	instruction->opcode = Opcode::exit;
+	instruction->pc = end;
+
+	// resolve dispatch targets (if required)
+	if (handlers) {
+		for (auto& i : instructions) {
+			i.handler = handlers[static_cast<size_t>(i.opcode)];
+		}
+	}
+}
+
 //
 //	OtByteCodeClass::getOpcodeSize
 //
@@ -343,6 +894,7 @@ size_t OtByteCodeClass::getOpcodeSize(size_t offset) {
 			break;
 
 		case Opcode::method:
+			getNumber(pc);
 			getNumber(pc);
 			getNumber(pc);
 			break;
@@ -361,11 +913,18 @@ size_t OtByteCodeClass::getOpcodeSize(size_t offset) {
 		case Opcode::popTry:
 			break;
 
+		case Opcode::iterate:
+			getNumber(pc);
+			getNumber(pc);
+			getNumber(pc);
+			break;
+
 		case Opcode::pushStackObject:
 			getNumber(pc);
 			break;
 
 		case Opcode::pushStackMember:
+			getNumber(pc);
 			getNumber(pc);
 			getNumber(pc);
 			break;
@@ -376,6 +935,7 @@ size_t OtByteCodeClass::getOpcodeSize(size_t offset) {
 			break;
 
 		case Opcode::pushMember:
+			getNumber(pc);
 			getNumber(pc);
 			break;
 
@@ -387,6 +947,20 @@ size_t OtByteCodeClass::getOpcodeSize(size_t offset) {
 			getNumber(pc);
 			getNumber(pc);
 			break;
+
+		case Opcode::add:
+		case Opcode::subtract:
+		case Opcode::multiply:
+		case Opcode::divide:
+		case Opcode::modulo:
+		case Opcode::equal:
+		case Opcode::notEqual:
+		case Opcode::lessThan:
+		case Opcode::lessEqual:
+		case Opcode::greaterThan:
+		case Opcode::greaterEqual:
+			getNumber(pc);
+			break;
 	}
 
 	return pc - offset;
@@ -477,6 +1051,22 @@ bool OtByteCodeClass::isMember(size_t pc, OtID& member) {
 }
 
 
+//
+//	OtByteCodeClass::isMethod
+//
+
+bool OtByteCodeClass::isMethod(size_t pc, OtID& method, size_t& count) {
+	if (getOpcode(pc) == Opcode::method) {
+		method = getID(pc);
+		count = getNumber(pc);
+		return true;
+
+	} else {
+		return false;
+	}
+}
+
+
 //
 //	OtByteCodeClass::isMethodDeref
 //
@@ -522,6 +1112,67 @@ bool OtByteCodeClass::isAnyJump(size_t pc, size_t& offset) {
 }
 
 
+//
+//	OtByteCodeClass::isBinaryOperator
+//
+
+bool OtByteCodeClass::isBinaryOperator(size_t pc, Opcode& opcode) {
+	if (getOpcode(pc) == Opcode::method) {
+		auto method = getID(pc);
+
+		if (getNumber(pc) == 1) {
+			for (auto i = static_cast<int>(Opcode::add); i <= static_cast<int>(Opcode::greaterEqual); i++) {
+				auto candidate = static_cast<Opcode>(i);
+
+				if (getOperatorMethod(candidate) == method) {
+					opcode = candidate;
+					return true;
+				}
+			}
+		}
+	}
+
+	return false;
+}
+
+
+//
+//	OtByteCodeClass::getOperatorMethod
+//
+
+OtID OtByteCodeClass::getOperatorMethod(Opcode opcode) {
+	static OtID addID = OtIdentifier::create("__add__");
+	static OtID subtractID = OtIdentifier::create("__sub__");
+	static OtID multiplyID = OtIdentifier::create("__mul__");
+	static OtID divideID = OtIdentifier::create("__div__");
+	static OtID moduloID = OtIdentifier::create("__mod__");
+	static OtID equalID = OtIdentifier::create("__eq__");
+	static OtID notEqualID = OtIdentifier::create("__ne__");
+	static OtID lessThanID = OtIdentifier::create("__lt__");
+	static OtID lessEqualID = OtIdentifier::create("__le__");
+	static OtID greaterThanID = OtIdentifier::create("__gt__");
+	static OtID greaterEqualID = OtIdentifier::create("__ge__");
+
+	switch (opcode) {
+		case Opcode::add: return addID;
+		case Opcode::subtract: return subtractID;
+		case Opcode::multiply: return multiplyID;
+		case Opcode::divide: return divideID;
+		case Opcode::modulo: return moduloID;
+		case Opcode::equal: return equalID;
+		case Opcode::notEqual: return notEqualID;
+		case Opcode::lessThan: return lessThanID;
+		case Opcode::lessEqual: return lessEqualID;
+		case Opcode::greaterThan: return greaterThanID;
+		case Opcode::greaterEqual: return greaterEqualID;
+
+		default:
+			OtLogFatal("Internal error: opcode [{}] is not a binary operator", static_cast<int>(opcode));
+	}
+
+	return 0;
+}
+
 //
 //	OtByteCodeClass::getStatementStart
 //
@@ -642,7 +1293,7 @@ std::vector<std::string> OtByteCodeClass::getUsedSymbolNames(size_t pc) {
 //
 
 OtType OtByteCodeClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtByteCodeClass>("ByteCode", OtInternalClass::getMeta());
@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -21,6 +22,7 @@
 #include "OtException.h"
 #include "OtIdentifier.h"
 #include "OtInternal.h"
+#include "OtMethodCache.h"
 #include "OtObject.h"
 #include "OtSource.h"
 #include "OtStatement.h"
@@ -37,6 +39,10 @@ using OtMemberReference = OtObjectPointer<OtMemberReferenceClass>;
 class OtStackReferenceClass;
 using OtStackReference = OtObjectPointer<OtStackReferenceClass>;
 
+class OtByteCodeWriter;
+class OtByteCodeReader;
+class OtJitCode;
+
 
 //
 //	OtByteCode
@@ -67,6 +73,7 @@ public:
 		exit,
 		pushTry,
 		popTry,
+		iterate,
 
 		// opcodes generated by the optimizer
 		pushStackObject,
@@ -74,7 +81,31 @@ public:
 		pushObjectMember,
 		pushMember,
 		assignStack,
-		assignMember
+		assignMember,
+		add,
+		subtract,
+		multiply,
+		divide,
+		modulo,
+		equal,
+		notEqual,
+		lessThan,
+		lessEqual,
+		greaterThan,
+		greaterEqual
+	};
+
+	static constexpr size_t opcodeCount = static_cast<size_t>(Opcode::greaterEqual) + 1;
+
+	// pre-decoded instruction (see link)
+	struct Instruction {
+		const void* handler;	// dispatch target in a threaded interpreter
+		Opcode opcode;
+		size_t operand1;		// number, slot, identifier or jump target (as an instruction index)
+		size_t operand2;		// second number, identifier or jump target
+		OtObject* constant;
+		OtMethodCache* cache;
+		size_t pc;				// bytecode offset after this instruction (for error reporting and debugging)
 	};
 
 	// constructors
@@ -94,23 +125,25 @@ public:
 	inline size_t jumpTrue(size_t offset) { emitOpcode(Opcode::jumpTrue); return emitJump(offset); }
 	inline size_t jumpFalse(size_t offset) { emitOpcode(Opcode::jumpFalse); return emitJump(offset); }
 	inline void member(OtID id) { emitOpcode(Opcode::member); emitID(id); }
-	inline void method(OtID id, size_t count) { emitOpcode(Opcode::method); emitID(id); emitNumber(count); }
+	inline void method(OtID id, size_t count) { emitOpcode(Opcode::method); emitID(id); emitNumber(count); emitCache(); }
 	inline void super(OtID id) { emitOpcode(Opcode::super); emitID(id); }
 	inline void exit() { emitOpcode(Opcode::exit); }
 	inline size_t pushTry() { emitOpcode(Opcode::pushTry); return emitJump(0); }
 	inline void pushTry(size_t offset) { emitOpcode(Opcode::pushTry); emitJump(offset); }
 	inline void popTry() { emitOpcode(Opcode::popTry); }
+	inline size_t iterate(size_t slot) { emitOpcode(Opcode::iterate); emitNumber(slot); auto jump = emitJump(0); emitCache(2); return jump; }
 
 	// patch jump offset
 	inline void patchJump(size_t jump) { jumps[jump] = bytecode.size(); }
 
 	// add optimizer opcodes
 	inline void pushStackObject(size_t slot) { emitOpcode(Opcode::pushStackObject); emitNumber(slot); }
-	inline void pushStackMember(size_t slot, OtID member) { emitOpcode(Opcode::pushStackMember); emitNumber(slot); emitID(member); }
+	inline void pushStackMember(size_t slot, OtID member) { emitOpcode(Opcode::pushStackMember); emitNumber(slot); emitID(member); emitCache(); }
 	inline void pushObjectMember(OtObject object, OtID member) { emitOpcode(Opcode::pushObjectMember); emitConstant(object); emitID(member); }
-	inline void pushMember(OtID member) { emitOpcode(Opcode::pushMember); emitID(member); }
+	inline void pushMember(OtID member) { emitOpcode(Opcode::pushMember); emitID(member); emitCache(); }
 	inline void assignStack(size_t slot) { emitOpcode(Opcode::assignStack); emitNumber(slot); }
 	inline void assignMember(OtObject object, OtID member) { emitOpcode(Opcode::assignMember); emitConstant(object); emitID(member); }
+	inline void binaryOperator(Opcode opcode) { emitOpcode(opcode); emitCache(); }
 
 	// get current code size
 	inline size_t size() { return bytecode.size(); }
@@ -148,6 +181,28 @@ public:
 	// copy from other bytecode
 	void copyOpcode(OtByteCode bytecode, size_t pc);
 
+	// write bytecode to a portable image (returns false if bytecode can't be serialized)
+	bool serialize(OtByteCodeWriter& writer);
+
+	// create bytecode from a portable image (returns nullptr if image is invalid)
+	static OtByteCode deserialize(OtByteCodeReader& reader);
+
+	// get the pre-decoded instructions (the bytecode is linked on first use and must be complete by then)
+	inline Instruction* getInstructions(const void* const* handlers) {
+		if (instructions.empty()) {
+			link(handlers);
+		}
+
+		return instructions.data();
+	}
+
+	// get the number of pre-decoded instructions (including the final exit)
+	inline size_t getInstructionCount() { return instructions.size(); }
+
+	// just-in-time compiler state (see OtJit)
+	inline size_t& getHotness() { return hotness; }
+	inline std::shared_ptr<OtJitCode>& getNativeCode() { return nativeCode; }
+
 	// add statement reference
 	inline void addStatement(size_t sourceStart, size_t sourceEnd, size_t opcodeStart, size_t opcodeEnd) {
 		statements.emplace_back(sourceStart, sourceEnd, opcodeStart, opcodeEnd);
@@ -164,6 +219,7 @@ public:
 	inline OtID getID() { return bytecodeID; }
 	inline uint8_t* getCode() { return bytecode.data(); }
 	inline OtObject& getConstant(size_t index) { return constants[index]; }
+	inline OtMethodCache& getCache(size_t index) { return caches[index]; }
 	inline std::vector<size_t>& getJumps() { return jumps; }
 	inline size_t getJump(size_t jump) { return jumps[jump]; }
 	inline std::vector<OtStatement>& getStatements() { return statements; }
@@ -177,9 +233,14 @@ public:
 	bool isPushMemberReference(size_t pc, OtMemberReference& reference);
 	bool isSwap(size_t pc);
 	bool isMember(size_t pc, OtID& member);
+	bool isMethod(size_t pc, OtID& method, size_t& count);
 	bool isMethodDeref(size_t pc);
 	bool isMethodAssign(size_t pc);
 	bool isAnyJump(size_t pc, size_t& offset);
+	bool isBinaryOperator(size_t pc, Opcode& opcode);
+
+	// get the method that implements a binary operator opcode
+	static OtID getOperatorMethod(Opcode opcode);
 
 	size_t getStatementStart(size_t pc);
 	size_t getStatementEnd(size_t pc);
@@ -193,6 +254,9 @@ public:
 	static OtType getMeta();
 
 private:
+	// turn bytecode into pre-decoded instructions
+	void link(const void* const* handlers);
+
 	// emit parts to bytecode
 	inline void emitOpcode(Opcode opcode) {
 		bytecode.emplace_back(static_cast<uint8_t>(opcode));
@@ -213,6 +277,11 @@ private:
 
 	inline void emitID(OtID id) { emitNumber(static_cast<size_t>(id)); }
 
+	inline void emitCache(size_t count=1) {
+		emitNumber(caches.size());
+		caches.resize(caches.size() + count);
+	}
+
 	inline void emitNumber(size_t number) {
 		while (number > 0x7f) {
 			bytecode.emplace_back(static_cast<uint8_t>((number & 0x7f) | 0x80));
@@ -228,8 +297,12 @@ private:
 	std::vector<uint8_t> bytecode;
 	std::vector<OtObject> constants;
 	std::vector<size_t> jumps;
+	std::vector<OtMethodCache> caches;
 	std::vector<OtStatement> statements;
 	std::vector<OtSymbol> symbols;
+	std::vector<Instruction> instructions;
+	size_t hotness = 0;
+	std::shared_ptr<OtJitCode> nativeCode;
 
 	// internal method identifiers used by compiler
 	OtID assignID = OtIdentifier::create("__assign__");
@@ -0,0 +1,673 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+//
+//	Include files
+//
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+
+#include "fmt/format.h"
+
+#include "OtBoolean.h"
+#include "OtByteCodeCache.h"
+#include "OtByteCodeFunction.h"
+#include "OtCaptureReference.h"
+#include "OtClass.h"
+#include "OtClosure.h"
+#include "OtConfig.h"
+#include "OtGlobal.h"
+#include "OtHash.h"
+#include "OtInteger.h"
+#include "OtLibuv.h"
+#include "OtMemberReference.h"
+#include "OtPath.h"
+#include "OtReal.h"
+#include "OtStackReference.h"
+#include "OtString.h"
+#include "OtThrow.h"
+#include "OtVM.h"
+
+
+//
+//	Object tags used in images
+//
+
+enum class OtByteCodeTag : uint8_t {
+	null,
+	boolean,
+	integer,
+	real,
+	string,
+	stackReference,
+	captureReference,
+	memberReference,
+	function,
+	closure,
+	classDefinition,
+	classReference,
+	throwMarker,
+	global,
+	module
+};
+
+
+//
+//	Magic number at the start of every cache file
+//
+
+static constexpr char magic[] = {'O', 'T', 'B', 'C'};
+
+
+//
+//	OtByteCodeWriter::writeNumber
+//
+
+void OtByteCodeWriter::writeNumber(uint64_t number) {
+	while (number > 0x7f) {
+		writeByte(static_cast<uint8_t>((number & 0x7f) | 0x80));
+		number >>= 7;
+	}
+
+	writeByte(static_cast<uint8_t>(number));
+}
+
+
+//
+//	OtByteCodeWriter::writeReal
+//
+
+void OtByteCodeWriter::writeReal(double real) {
+	uint64_t bits;
+	std::memcpy(&bits, &real, sizeof(bits));
+
+	for (size_t i = 0; i < sizeof(bits); i++) {
+		writeByte(static_cast<uint8_t>(bits >> (i * 8)));
+	}
+}
+
+
+//
+//	OtByteCodeWriter::writeString
+//
+
+void OtByteCodeWriter::writeString(const std::string& string) {
+	writeNumber(string.size());
+	body.append(string);
+}
+
+
+//
+//	OtByteCodeWriter::writeID
+//
+
+void OtByteCodeWriter::writeID(OtID id) {
+	auto i = identifierIndex.find(id);
+
+	if (i == identifierIndex.end()) {
+		auto index = identifiers.size();
+		identifiers.emplace_back(id);
+		identifierIndex[id] = index;
+		writeNumber(index);
+
+	} else {
+		writeNumber(i->second);
+	}
+}
+
+
+//
+//	OtByteCodeWriter::writeObject
+//
+
+bool OtByteCodeWriter::writeObject(OtObject object) {
+	auto tag = [this](OtByteCodeTag t) { writeByte(static_cast<uint8_t>(t)); };
+
+	if (!object) {
+		tag(OtByteCodeTag::null);
+
+	} else if (object.raw() == module.raw()) {
+		tag(OtByteCodeTag::module);
+
+	} else if (object.isKindOf<OtGlobalClass>()) {
+		tag(OtByteCodeTag::global);
+
+	} else if (object.isKindOf<OtBooleanClass>()) {
+		tag(OtByteCodeTag::boolean);
+		writeByte(object->operator bool() ? 1 : 0);
+
+	} else if (object.isKindOf<OtIntegerClass>()) {
+		tag(OtByteCodeTag::integer);
+		writeNumber(static_cast<uint64_t>(object->operator int64_t()));
+
+	} else if (object.isKindOf<OtRealClass>()) {
+		tag(OtByteCodeTag::real);
+		writeReal(object->operator double());
+
+	} else if (object.isKindOf<OtStringClass>()) {
+		tag(OtByteCodeTag::string);
+		writeString(object->operator std::string());
+
+	} else if (object.isKindOf<OtStackReferenceClass>()) {
+		OtStackReference reference = object;
+		tag(OtByteCodeTag::stackReference);
+		writeID(reference->getID());
+		writeNumber(reference->getSlot());
+
+	} else if (object.isKindOf<OtCaptureReferenceClass>()) {
+		OtCaptureReference reference = object;
+		tag(OtByteCodeTag::captureReference);
+		writeID(reference->getMember());
+
+	} else if (object.isKindOf<OtMemberReferenceClass>()) {
+		OtMemberReference reference = object;
+		tag(OtByteCodeTag::memberReference);
+
+		if (!writeReference(reference->getObject())) {
+			return false;
+		}
+
+		writeID(reference->getMember());
+
+	} else if (object.isKindOf<OtByteCodeFunctionClass>()) {
+		OtByteCodeFunction function = object;
+		tag(OtByteCodeTag::function);
+		writeNumber(function->getParameterCount());
+		return function->getByteCode()->serialize(*this);
+
+	} else if (object.isKindOf<OtClosureClass>()) {
+		OtClosure closure = object;
+		tag(OtByteCodeTag::closure);
+		auto& captures = closure->getCaptures();
+		writeNumber(captures.size());
+
+		for (auto& [id, location] : captures) {
+			writeID(id);
+			writeNumber(location.first);
+			writeNumber(location.second);
+		}
+
+		return writeObject(closure->getFunction());
+
+	} else if (object.isKindOf<OtClassClass>()) {
+		// classes are created by the compiler and must keep their identity
+		OtClass cls = object;
+		auto type = cls->getClassType().raw();
+		auto i = classIndex.find(type);
+
+		if (i == classIndex.end()) {
+			auto index = classIndex.size();
+			classIndex[type] = index;
+			tag(OtByteCodeTag::classDefinition);
+			writeID(type->getID());
+
+		} else {
+			tag(OtByteCodeTag::classReference);
+			writeNumber(i->second);
+		}
+
+	} else if (object.isKindOf<OtThrowClass>()) {
+		tag(OtByteCodeTag::throwMarker);
+
+	} else {
+		return false;
+	}
+
+	return true;
+}
+
+
+//
+//	OtByteCodeWriter::writeReference
+//
+
+bool OtByteCodeWriter::writeReference(OtObject object) {
+	// only scope objects can be rebound in another process
+	if (!object || object.raw() == module.raw() || object.isKindOf<OtGlobalClass>() || object.isKindOf<OtClassClass>()) {
+		return writeObject(object);
+
+	} else {
+		return false;
+	}
+}
+
+
+//
+//	OtByteCodeWriter::getImage
+//
+
+std::string OtByteCodeWriter::getImage() {
+	OtByteCodeWriter header(module);
+	header.writeNumber(identifiers.size());
+
+	for (auto id : identifiers) {
+		header.writeString(std::string(OtIdentifier::name(id)));
+	}
+
+	return header.body + body;
+}
+
+
+//
+//	OtByteCodeReader::OtByteCodeReader
+//
+
+OtByteCodeReader::OtByteCodeReader(const std::string& i, OtSource s, OtObject m) : image(i), source(s), module(m) {
+	// read name table and turn names into process identifiers
+	auto count = readCount();
+
+	for (size_t i = 0; i < count && !failed; i++) {
+		identifiers.emplace_back(OtIdentifier::create(readString()));
+	}
+}
+
+
+//
+//	OtByteCodeReader::readByte
+//
+
+uint8_t OtByteCodeReader::readByte() {
+	if (failed || position >= image.size()) {
+		failed = true;
+		return 0;
+	}
+
+	return static_cast<uint8_t>(image[position++]);
+}
+
+
+//
+//	OtByteCodeReader::readNumber
+//
+
+uint64_t OtByteCodeReader::readNumber() {
+	uint64_t result = 0;
+	size_t shift = 0;
+
+	while (!failed) {
+		auto byte = readByte();
+
+		if (shift > 63) {
+			failed = true;
+			return 0;
+		}
+
+		result |= uint64_t(byte & 0x7f) << shift;
+
+		if (!(byte & 0x80)) {
+			break;
+		}
+
+		shift += 7;
+	}
+
+	return failed ? 0 : result;
+}
+
+
+//
+//	OtByteCodeReader::readReal
+//
+
+double OtByteCodeReader::readReal() {
+	uint64_t bits = 0;
+
+	for (size_t i = 0; i < sizeof(bits); i++) {
+		bits |= uint64_t(readByte()) << (i * 8);
+	}
+
+	double real;
+	std::memcpy(&real, &bits, sizeof(real));
+	return real;
+}
+
+
+//
+//	OtByteCodeReader::readString
+//
+
+std::string OtByteCodeReader::readString() {
+	auto size = readCount();
+
+	if (failed) {
+		return std::string();
+	}
+
+	auto result = image.substr(position, size);
+	position += size;
+	return result;
+}
+
+
+//
+//	OtByteCodeReader::readID
+//
+
+OtID OtByteCodeReader::readID() {
+	auto index = readNumber();
+
+	if (failed || index >= identifiers.size()) {
+		failed = true;
+		return 0;
+	}
+
+	return identifiers[index];
+}
+
+
+//
+//	OtByteCodeReader::readCount
+//
+
+size_t OtByteCodeReader::readCount() {
+	// every counted item takes at least one byte so this stops runaway allocations
+	auto count = readNumber();
+
+	if (count > image.size() - position) {
+		failed = true;
+		return 0;
+	}
+
+	return static_cast<size_t>(count);
+}
+
+
+//
+//	OtByteCodeReader::readObject
+//
+
+OtObject OtByteCodeReader::readObject() {
+	auto tag = static_cast<OtByteCodeTag>(readByte());
+
+	if (failed) {
+		return nullptr;
+	}
+
+	switch (tag) {
+		case OtByteCodeTag::null:
+			return nullptr;
+
+		case OtByteCodeTag::boolean:
+			return OtBoolean::create(readByte() != 0);
+
+		case OtByteCodeTag::integer:
+			return OtInteger::create(static_cast<int64_t>(readNumber()));
+
+		case OtByteCodeTag::real:
+			return OtReal::create(readReal());
+
+		case OtByteCodeTag::string:
+			return OtString::create(readString());
+
+		case OtByteCodeTag::stackReference: {
+			auto id = readID();
+			auto slot = readNumber();
+			return OtStackReference::create(id, slot);
+		}
+
+		case OtByteCodeTag::captureReference:
+			return OtCaptureReference::create(readID());
+
+		case OtByteCodeTag::memberReference: {
+			auto object = readReference();
+			auto id = readID();
+			return failed ? nullptr : OtMemberReference::create(object, id);
+		}
+
+		case OtByteCodeTag::function: {
+			auto parameterCount = readNumber();
+			auto bytecode = OtByteCodeClass::deserialize(*this);
+			return failed ? nullptr : OtByteCodeFunction::create(bytecode, parameterCount);
+		}
+
+		case OtByteCodeTag::closure: {
+			std::unordered_map<OtID, std::pair<size_t, size_t>> captures;
+			auto count = readCount();
+
+			for (size_t i = 0; i < count && !failed; i++) {
+				auto id = readID();
+				auto frame = readNumber();
+				auto slot = readNumber();
+				captures[id] = std::make_pair(frame, slot);
+			}
+
+			OtObject function = readObject();
+
+			if (failed || !function.isKindOf<OtByteCodeFunctionClass>()) {
+				failed = true;
+				return nullptr;
+			}
+
+			return OtClosure::create(OtByteCodeFunction(function), captures);
+		}
+
+		case OtByteCodeTag::classDefinition: {
+			OtClass cls = OtClass::create(readID());
+			classes.emplace_back(cls);
+			return cls;
+		}
+
+		case OtByteCodeTag::classReference: {
+			auto index = readNumber();
+
+			if (index >= classes.size()) {
+				failed = true;
+				return nullptr;
+			}
+
+			return classes[index];
+		}
+
+		case OtByteCodeTag::throwMarker:
+			return OtThrow::create();
+
+		case OtByteCodeTag::global:
+			return OtVM::getGlobal();
+
+		case OtByteCodeTag::module:
+			return module;
+	}
+
+	failed = true;
+	return nullptr;
+}
+
+
+//
+//	OtByteCodeReader::readReference
+//
+
+OtObject OtByteCodeReader::readReference() {
+	auto object = readObject();
+
+	if (object && object.raw() != module.raw() && !object.isKindOf<OtGlobalClass>() && !object.isKindOf<OtClassClass>()) {
+		failed = true;
+		return nullptr;
+	}
+
+	return object;
+}
+
+
+//
+//	Fingerprint of the environment the compiler resolves names against
+//
+
+static uint64_t getEnvironmentHash(OtSource source) {
+	// compiled code depends on the global names that existed at compile time
+	std::vector<std::string> names;
+
+	OtVM::getGlobal()->eachMemberID([&](OtID id) {
+		names.emplace_back(OtIdentifier::name(id));
+	});
+
+	std::sort(names.begin(), names.end());
+	std::string environment;
+
+	for (auto& name : names) {
+		environment.append(name);
+		environment.push_back('\n');
+	}
+
+	return OtHash::generate(OtByteCodeCache::version, source->getModule(), environment);
+}
+
+
+//
+//	OtByteCodeCache::load
+//
+
+OtByteCode OtByteCodeCache::load(OtSource source, OtObject module) {
+	if (!OtConfig::useByteCodeCache()) {
+		return nullptr;
+	}
+
+	// read cache file (a missing file is a regular miss)
+	std::ifstream stream(getFilename(source), std::ios::binary);
+
+	if (!stream) {
+		return nullptr;
+	}
+
+	std::string image{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+
+	// ensure file is intact (magic number followed by a checksum of the image)
+	static constexpr size_t headerSize = sizeof(magic) + sizeof(uint64_t);
+
+	if (image.size() < headerSize || image.compare(0, sizeof(magic), magic, sizeof(magic)) != 0) {
+		return nullptr;
+	}
+
+	uint64_t checksum = 0;
+
+	for (size_t i = 0; i < sizeof(checksum); i++) {
+		checksum |= uint64_t(static_cast<uint8_t>(image[sizeof(magic) + i])) << (i * 8);
+	}
+
+	image.erase(0, headerSize);
+
+	if (checksum != OtHash::generate(image)) {
+		return nullptr;
+	}
+
+	// ensure entry was created for this source code in this environment
+	OtByteCodeReader reader(image, source, module);
+	auto sourceSize = reader.readNumber();
+	auto sourceHash = reader.readNumber();
+	auto environmentHash = reader.readNumber();
+
+	if (reader.hasFailed() ||
+		sourceSize != source->size() ||
+		sourceHash != OtHash::generate(source->getSource()) ||
+		environmentHash != getEnvironmentHash(source)) {
+		return nullptr;
+	}
+
+	return OtByteCodeClass::deserialize(reader);
+}
+
+
+//
+//	OtByteCodeCache::save
+//
+
+void OtByteCodeCache::save(OtByteCode bytecode, OtObject module) {
+	if (!OtConfig::useByteCodeCache()) {
+		return;
+	}
+
+	// create the image (some constants can't be serialized in which case we don't cache)
+	auto source = bytecode->getSource();
+	OtByteCodeWriter writer(module);
+	writer.writeNumber(source->size());
+	writer.writeNumber(OtHash::generate(source->getSource()));
+	writer.writeNumber(getEnvironmentHash(source));
+
+	if (!bytecode->serialize(writer)) {
+		return;
+	}
+
+	// write to a temporary file first so other processes never see a partial entry
+	std::error_code error;
+	std::filesystem::create_directories(getDirectory(), error);
+
+	if (error) {
+		return;
+	}
+
+	auto filename = getFilename(source);
+	// temporary files are unique per process and per save (workers can save the same module concurrently)
+	static std::atomic<uint64_t> saves = 0;
+	auto tmp = fmt::format("{}.{}.{}.tmp", filename, uv_os_getpid(), saves++);
+
+	{
+		std::ofstream stream(tmp, std::ios::binary | std::ios::trunc);
+
+		if (!stream) {
+			return;
+		}
+
+		auto image = writer.getImage();
+		uint64_t checksum = OtHash::generate(image);
+		char checksumBytes[sizeof(checksum)];
+
+		for (size_t i = 0; i < sizeof(checksum); i++) {
+			checksumBytes[i] = static_cast<char>(checksum >> (i * 8));
+		}
+
+		stream.write(magic, sizeof(magic));
+		stream.write(checksumBytes, sizeof(checksumBytes));
+		stream.write(image.data(), image.size());
+
+		if (!stream) {
+			stream.close();
+			std::filesystem::remove(tmp, error);
+			return;
+		}
+	}
+
+	std::filesystem::rename(tmp, filename, error);
+
+	if (error) {
+		std::filesystem::remove(tmp, error);
+	}
+}
+
+
+//
+//	OtByteCodeCache::clear
+//
+
+void OtByteCodeCache::clear() {
+	std::error_code error;
+	std::filesystem::remove_all(getDirectory(), error);
+}
+
+
+//
+//	OtByteCodeCache::getDirectory
+//
+
+std::string OtByteCodeCache::getDirectory() {
+	return OtPath::join(OtPath::join(OtPath::getCacheDirectory(), "ObjectTalk"), "bytecode");
+}
+
+
+//
+//	OtByteCodeCache::getFilename
+//
+
+std::string OtByteCodeCache::getFilename(OtSource source) {
+	// one entry per module path, a changed module simply replaces its entry
+	return OtPath::join(getDirectory(), fmt::format("{:016x}.otc", OtHash::generate(source->getModule())));
+}
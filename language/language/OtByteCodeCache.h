@@ -0,0 +1,139 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+#pragma once
+
+
+//
+//	Include files
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "OtByteCode.h"
+#include "OtIdentifier.h"
+#include "OtObject.h"
+#include "OtSource.h"
+
+
+//
+//	OtByteCodeWriter
+//
+//	Turns compiled bytecode into a portable binary image. Identifiers are
+//	process-local so they are written as indices into a name table that is
+//	resolved again when the image is loaded. Scope objects (global, module
+//	and classes defined in the module) are written as references so they
+//	can be rebound to their counterparts in the loading process.
+//
+
+class OtByteCodeWriter {
+public:
+	// constructor
+	OtByteCodeWriter(OtObject m) : module(m) {}
+
+	// write primitives
+	void writeByte(uint8_t byte) { body.push_back(static_cast<char>(byte)); }
+	void writeNumber(uint64_t number);
+	void writeReal(double real);
+	void writeString(const std::string& string);
+	void writeID(OtID id);
+
+	// write objects (returns false if object can't be serialized)
+	bool writeObject(OtObject object);
+	bool writeReference(OtObject object);
+
+	// get the final image (name table followed by the body)
+	std::string getImage();
+
+private:
+	// properties
+	OtObject module;
+	std::string body;
+	std::vector<OtID> identifiers;
+	std::unordered_map<OtID, size_t> identifierIndex;
+	std::unordered_map<OtTypeClass*, size_t> classIndex;
+};
+
+
+//
+//	OtByteCodeReader
+//
+//	Reconstructs objects from an image created by OtByteCodeWriter. Images
+//	are never trusted: every read is range checked and the first problem
+//	marks the reader as failed after which all reads return empty values.
+//
+
+class OtByteCodeReader {
+public:
+	// constructor
+	OtByteCodeReader(const std::string& image, OtSource source, OtObject module);
+
+	// read primitives
+	uint8_t readByte();
+	uint64_t readNumber();
+	double readReal();
+	std::string readString();
+	OtID readID();
+
+	// read a count that is checked against the remaining image size
+	size_t readCount();
+
+	// read objects
+	OtObject readObject();
+	OtObject readReference();
+
+	// access reader state
+	inline OtSource getSource() { return source; }
+	inline bool hasFailed() { return failed; }
+	inline void fail() { failed = true; }
+
+private:
+	// properties
+	const std::string& image;
+	size_t position = 0;
+	bool failed = false;
+	OtSource source;
+	OtObject module;
+	std::vector<OtID> identifiers;
+	std::vector<OtObject> classes;
+};
+
+
+//
+//	OtByteCodeCache
+//
+//	Persistent cache of compiled modules. Entries are keyed by the module's
+//	path and source code, the compiler version and the set of global names
+//	the compiler resolved against. A cache problem is never fatal, the module
+//	is simply compiled again.
+//
+
+class OtByteCodeCache {
+public:
+	// bump this whenever the compiler, optimizer or image format changes
+	static constexpr uint32_t version = 2;
+
+	// get compiled module bytecode from the cache (returns nullptr on a miss)
+	static OtByteCode load(OtSource source, OtObject module);
+
+	// store compiled module bytecode in the cache
+	static void save(OtByteCode bytecode, OtObject module);
+
+	// remove all entries from the cache
+	static void clear();
+
+	// get the directory used for cache entries
+	static std::string getDirectory();
+
+private:
+	// determine the cache file for a module
+	static std::string getFilename(OtSource source);
+};
@@ -41,7 +41,7 @@ OtObject OtByteCodeFunctionClass::operator()(size_t count, [[maybe_unused]] OtOb
 //
 
 OtType OtByteCodeFunctionClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtByteCodeFunctionClass>("ByteCodeFunction", OtInternalClass::getMeta());
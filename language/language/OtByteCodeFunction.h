@@ -35,6 +35,9 @@ public:
 	// get parameter count
 	inline size_t getParameterCount() { return parameterCount; }
 
+	// get the function's code
+	inline OtByteCode getByteCode() { return bytecode; }
+
 	// get type definition
 	static OtType getMeta();
 
@@ -40,7 +40,7 @@ OtObject OtCaptureReferenceClass::assign(OtObject value) {
 //
 
 OtType OtCaptureReferenceClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtCaptureReferenceClass>("CaptureReference", OtReferenceClass::getMeta());
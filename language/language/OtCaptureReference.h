@@ -32,6 +32,9 @@ public:
 	OtObject deref();
 	OtObject assign(OtObject value);
 
+	// get referenced member
+	inline OtID getMember() { return member; }
+
 	// get type definition
 	static OtType getMeta();
 
@@ -58,7 +58,7 @@ OtObject OtClosureClass::operator()(size_t count, OtObject* parameters) {
 //
 
 OtType OtClosureClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtClosureClass>("Closure", OtInternalClass::getMeta());
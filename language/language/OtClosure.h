@@ -39,6 +39,10 @@ public:
 	// get parameter count
 	inline size_t getParameterCount() { return function->getParameterCount(); }
 
+	// access closure parts
+	inline OtByteCodeFunction getFunction() { return function; }
+	inline const std::unordered_map<OtID, std::pair<size_t, size_t>>& getCaptures() { return captures; }
+
 	// get type definition
 	static OtType getMeta();
 
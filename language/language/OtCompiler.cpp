@@ -1543,15 +1543,8 @@ void OtCompiler::forStatement(OtByteCode bytecode) {
 	bytecode->method(iteratorID, 0);
 	size_t offset1 = bytecode->size();
 
-	// see if we are at the end of the iteration
-	bytecode->dup();
-	bytecode->method(endID, 0);
-	size_t offset2 = bytecode->jumpTrue(0);
-
-	// get the next iteration
-	bytecode->dup();
-	bytecode->method(nextID, 0);
-	assignVariable(id);
+	// get the next iteration into the loop variable or leave the loop when we're at the end
+	size_t offset2 = bytecode->iterate(scopeStack.back().locals[id]);
 
 	// process the actual for loop block
 	block(bytecode);
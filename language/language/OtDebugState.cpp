@@ -30,7 +30,7 @@ void OtDebugState::update() {
 	for (size_t i = 0; i < stackFrameCount; i++) {
 		auto& stackframe = stack->getFrame(i);
 		auto bytecode = stackframe.bytecode;
-		auto pc = *stackframe.pc;
+		auto pc = stackframe.getPC();
 		auto sp = OtVM::getStack()->raw();
 		auto& frame = frames.emplace_back(bytecode->getModule(), bytecode->getLineNumber(pc));
 
@@ -133,11 +133,9 @@ void OtDebugState::addObject(std::vector<Variable>& list, const std::string_view
 
 	} else if (object.isKindOf<OtDictClass>()) {
 		auto& items = variable.members.emplace_back("_items");
-		auto dict = OtDict(object)->raw();
-
-		for (auto& [memberName, memberObject] : dict) {
+		OtDict(object)->each([&](const std::string& memberName, OtObject& memberObject) {
 			addObject(items.members, memberName, memberObject);
-		}
+		});
 
 	} else if (object.isKindOf<OtSetClass>()) {
 		auto& items = variable.members.emplace_back("_items");
@@ -21,8 +21,11 @@
 #include "OtArray.h"
 #include "OtConfig.h"
 #include "OtDebugger.h"
+#include "OtDict.h"
 #include "OtFunction.h"
+#include "OtInteger.h"
 #include "OtLog.h"
+#include "OtMethodCache.h"
 #include "OtStderrMultiplexer.h"
 #include "OtString.h"
 #include "OtText.h"
@@ -122,6 +125,28 @@ OtObject OtDebuggerClass::getVariableNames() {
 }
 
 
+//
+//	OtDebuggerClass::getStatistics
+//
+
+OtObject OtDebuggerClass::getStatistics() {
+	// report the VM's runtime statistics for the current thread
+	auto dict = OtDict::create();
+	dict->setEntry("methodCacheHits", OtInteger::create(static_cast<int64_t>(OtMethodCache::getHits())));
+	dict->setEntry("methodCacheMisses", OtInteger::create(static_cast<int64_t>(OtMethodCache::getMisses())));
+	return dict;
+}
+
+
+//
+//	OtDebuggerClass::resetStatistics
+//
+
+void OtDebuggerClass::resetStatistics() {
+	OtMethodCache::resetStatistics();
+}
+
+
 //
 //	Completer support functions
 //
@@ -397,7 +422,7 @@ std::string OtDebuggerClass::getVariables() {
 //
 
 OtType OtDebuggerClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtGlobalClass>("Debugger", OtInternalClass::getMeta());
@@ -405,6 +430,8 @@ OtType OtDebuggerClass::getMeta() {
 		type->set("where", OtFunction::create(&OtDebuggerClass::where));
 		type->set("disassemble", OtFunction::create(&OtDebuggerClass::disassemble));
 		type->set("getVariableNames", OtFunction::create(&OtDebuggerClass::getVariableNames));
+		type->set("getStatistics", OtFunction::create(&OtDebuggerClass::getStatistics));
+		type->set("resetStatistics", OtFunction::create(&OtDebuggerClass::resetStatistics));
 	}
 
 	return type;
@@ -34,6 +34,10 @@ public:
 	// get variable names
 	OtObject getVariableNames();
 
+	// get/reset runtime statistics (method cache hits and misses)
+	OtObject getStatistics();
+	void resetStatistics();
+
 	// get type definition
 	static OtType getMeta();
 
@@ -24,11 +24,13 @@
 #include "OtArray.h"
 #include "OtDict.h"
 #include "OtSet.h"
+#include "OtTypedArray.h"
 
 #include "OtPathObject.h"
 #include "OtIO.h"
 #include "OtOS.h"
 #include "OtFS.h"
+#include "OtWorker.h"
 
 #include "OtCout.h"
 #include "OtCerr.h"
@@ -48,8 +50,8 @@
 OtGlobalClass::OtGlobalClass() {
 	// add default constants
 	set("null", OtObject::create());
-	set("true", OtBoolean::create(true));
-	set("false", OtBoolean::create(false));
+	set("true", OtBooleanClass::getShared(true));
+	set("false", OtBooleanClass::getShared(false));
 	set("pi", OtReal::create(std::numbers::pi));
 	set("e", OtReal::create(std::numbers::e));
 
@@ -74,10 +76,16 @@ OtGlobalClass::OtGlobalClass() {
 	set("Dict", OtClass::create(OtDictClass::getMeta()));
 	set("Set", OtClass::create(OtSetClass::getMeta()));
 
+	set("Uint8Array", OtClass::create(OtUint8ArrayClass::getMeta()));
+	set("Int32Array", OtClass::create(OtInt32ArrayClass::getMeta()));
+	set("Float32Array", OtClass::create(OtFloat32ArrayClass::getMeta()));
+	set("Float64Array", OtClass::create(OtFloat64ArrayClass::getMeta()));
+
 	set("Path", OtClass::create(OtPathObjectClass::getMeta()));
 	set("IO", OtClass::create(OtIOClass::getMeta()));
 	set("OS", OtClass::create(OtOSClass::getMeta()));
 	set("FS", OtClass::create(OtFSClass::getMeta()));
+	set("Worker", OtClass::create(OtWorkerClass::getMeta()));
 
 	set("Cout", OtClass::create(OtCoutClass::getMeta()));
 	set("Cerr", OtClass::create(OtCerrClass::getMeta()));
@@ -207,7 +215,7 @@ OtObject OtGlobalClass::members(OtObject object) {
 //
 
 OtType OtGlobalClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtGlobalClass>("Global", OtInternalClass::getMeta());
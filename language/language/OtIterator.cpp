@@ -17,7 +17,7 @@
 //
 
 OtType OtIteratorClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtIteratorClass>("Iterator", OtInternalClass::getMeta());
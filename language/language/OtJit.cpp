@@ -0,0 +1,1418 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+//
+//	Include files
+//
+
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "OtAssert.h"
+#include "OtBoolean.h"
+#include "OtClass.h"
+#include "OtConfig.h"
+#include "OtCycleCollector.h"
+#include "OtIdentifier.h"
+#include "OtInteger.h"
+#include "OtJit.h"
+#include "OtLog.h"
+#include "OtMemberReference.h"
+#include "OtReal.h"
+#include "OtStackReference.h"
+#include "OtVM.h"
+
+#if OT_JIT_SUPPORTED
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+
+//
+//	Constants
+//
+
+using Instruction = OtByteCodeClass::Instruction;
+using Opcode = OtByteCodeClass::Opcode;
+
+// status returned by helpers and native code
+static constexpr int statusNext = 0;
+static constexpr int statusBranch = 1;
+static constexpr int statusExit = 2;
+static constexpr int statusException = -1;
+
+// hotness of bytecode that can't be compiled
+static constexpr size_t notCompilable = std::numeric_limits<size_t>::max();
+
+
+//
+//	OtJit::Helpers
+//
+//	Helpers implement the opcodes like the interpreter does. Native code calls
+//	them with the virtual machine, the instruction and the context.
+//
+
+enum class OtJitOperand {
+	stack,		// already on the stack
+	slot,		// a stack frame slot (pushStackObject)
+	constant	// a constant (push)
+};
+
+enum class OtJitBranch {
+	none,
+	ifTrue,
+	ifFalse
+};
+
+class OtJit::Helpers {
+public:
+	using Function = int (*)(OtVM*, Instruction*, OtJitContext*);
+
+	// get the helper for an opcode
+	static Function get(Opcode opcode);
+
+	// get the helper for a fused binary operator (see OtJit::compile)
+	static Function getBinaryOperator(OtJitOperand left, OtJitOperand right, OtJitBranch branch);
+
+	// get the helper for a method call whose result is discarded
+	static Function getMethodPop() { return &call<methodPop>; }
+
+	// replace the operands of a binary operator that native code applied with its result
+	static int pushInteger(OtVM* vm, size_t pops, OtJitContext* context, int64_t value) {
+		return guard(context, [&]() {
+			vm->stack.pop(pops);
+			vm->stack.push(OtInteger::create(value));
+			return statusNext;
+		});
+	}
+
+	static int pushReal(OtVM* vm, size_t pops, OtJitContext* context, double value) {
+		return guard(context, [&]() {
+			vm->stack.pop(pops);
+			vm->stack.push(OtReal::create(value));
+			return statusNext;
+		});
+	}
+
+	static int pushBoolean(OtVM* vm, size_t pops, OtJitContext* context, bool value) {
+		return guard(context, [&]() {
+			vm->stack.pop(pops);
+			vm->stack.push(OtBooleanClass::getShared(value));
+			return statusNext;
+		});
+	}
+
+	// handle an object whose reference count native code dropped (like OtObjectPointer does)
+	static void release(OtObjectClass* object) {
+		OtCycleCollector::release(object);
+	}
+
+private:
+	// run a function and keep its exceptions out of native code
+	template <typename FUNCTION>
+	static int guard(OtJitContext* context, FUNCTION&& function) {
+		try {
+			return function();
+
+		} catch (OtException& e) {
+			context->error = std::move(e);
+			return statusException;
+
+		} catch (...) {
+			context->exception = std::current_exception();
+			return statusException;
+		}
+	}
+
+	// turn a handler into a helper
+	template <auto handler>
+	static int call(OtVM* vm, Instruction* instruction, OtJitContext* context) {
+		return guard(context, [&]() {
+			if constexpr (std::is_void_v<decltype(handler(*vm, *context, instruction))>) {
+				handler(*vm, *context, instruction);
+				return statusNext;
+
+			} else {
+				return handler(*vm, *context, instruction) ? statusBranch : statusNext;
+			}
+		});
+	}
+
+	// get the helper for a fused binary operator with known operands
+	template <OtJitOperand left, OtJitOperand right>
+	static Function getBinaryOperator(OtJitBranch branch) {
+		switch (branch) {
+			case OtJitBranch::none: return &call<binaryOperator<left, right, OtJitBranch::none>>;
+			case OtJitBranch::ifTrue: return &call<binaryOperator<left, right, OtJitBranch::ifTrue>>;
+			case OtJitBranch::ifFalse: return &call<binaryOperator<left, right, OtJitBranch::ifFalse>>;
+		}
+
+		return nullptr;
+	}
+
+	// opcode handlers (the ones returning a boolean tell native code to branch)
+	static void statement(OtVM& vm, OtJitContext&, Instruction*) {
+		vm.runHooks();
+	}
+
+	static void push(OtVM& vm, OtJitContext&, Instruction* instruction) {
+		vm.stack.push(*instruction->constant);
+	}
+
+	static void pushNull(OtVM& vm, OtJitContext&, Instruction*) {
+		vm.stack.push(vm.null);
+	}
+
+	static void pop(OtVM& vm, OtJitContext&, Instruction*) {
+		vm.stack.pop();
+	}
+
+	static void popCount(OtVM& vm, OtJitContext&, Instruction* instruction) {
+		vm.stack.pop(instruction->operand1);
+	}
+
+	static void dup(OtVM& vm, OtJitContext&, Instruction*) {
+		vm.stack.dup();
+	}
+
+	static void swap(OtVM& vm, OtJitContext&, Instruction*) {
+		vm.stack.swap();
+	}
+
+	static void move(OtVM& vm, OtJitContext&, Instruction* instruction) {
+		vm.stack.move(instruction->operand1);
+	}
+
+	static bool jumpTrue(OtVM& vm, OtJitContext&, Instruction*) {
+		return vm.stack.pop()->operator bool();
+	}
+
+	static bool jumpFalse(OtVM& vm, OtJitContext&, Instruction*) {
+		return !vm.stack.pop()->operator bool();
+	}
+
+	static void member(OtVM& vm, OtJitContext&, Instruction* instruction) {
+		auto object = vm.stack.pop();
+		auto reference = OtMemberReference::create(object, static_cast<OtID>(instruction->operand1));
+		vm.stack.push(std::move(reference));
+	}
+
+	static void super(OtVM& vm, OtJitContext&, Instruction* instruction) {
+		auto cls = OtClass(vm.stack.pop());
+		auto result = cls->getSuper(static_cast<OtID>(instruction->operand1));
+		vm.stack.push(std::move(result));
+	}
+
+	static OtObject callMethod(OtVM& vm, Instruction* instruction) {
+		auto method = static_cast<OtID>(instruction->operand1);
+		auto count = instruction->operand2;
+		auto parameters = vm.stack.getSP(count + 1);
+
+		if (!parameters[0]) {
+			OtLogFatal("Internal error: can't call method [{}] with [{}] parameters on nullptr", OtIdentifier::name(method), count);
+		}
+
+		return instruction->cache->lookup(parameters[0], method)->operator()(count + 1, parameters);
+	}
+
+	static void method(OtVM& vm, OtJitContext&, Instruction* instruction) {
+		auto result = callMethod(vm, instruction);
+		vm.stack.replace(instruction->operand2 + 1, result ? std::move(result) : vm.null);
+	}
+
+	static void methodPop(OtVM& vm, OtJitContext&, Instruction* instruction) {
+		callMethod(vm, instruction);
+		vm.stack.pop(instruction->operand2 + 1);
+	}
+
+	static void pushTry(OtVM& vm, OtJitContext& context, Instruction* instruction) {
+		context.tryCatch->push_back(OtTryCatch(instruction->operand1, vm.stack.getState()));
+	}
+
+	static void popTry(OtVM&, OtJitContext& context, Instruction*) {
+		context.tryCatch->pop_back();
+	}
+
+	static bool iterate(OtVM& vm, OtJitContext&, Instruction* instruction) {
+		return !vm.iterate(instruction->operand1, instruction->cache);
+	}
+
+	static void pushStackObject(OtVM& vm, OtJitContext&, Instruction* instruction) {
+		vm.stack.push(vm.stack.getFrameItem(instruction->operand1));
+	}
+
+	static void pushStackMember(OtVM& vm, OtJitContext&, Instruction* instruction) {
+		auto object = vm.stack.getFrameItem(instruction->operand1);
+		auto member = static_cast<OtID>(instruction->operand2);
+		vm.stack.push(OtMemberReferenceClass::resolveMember(object, member, *instruction->cache));
+	}
+
+	static void pushObjectMember(OtVM& vm, OtJitContext&, Instruction* instruction) {
+		auto object = *instruction->constant;
+		auto member = static_cast<OtID>(instruction->operand1);
+		vm.stack.push(OtMemberReferenceClass::resolveMember(object, member));
+	}
+
+	static void pushMember(OtVM& vm, OtJitContext&, Instruction* instruction) {
+		auto object = vm.stack.pop();
+		auto member = static_cast<OtID>(instruction->operand1);
+		vm.stack.push(OtMemberReferenceClass::resolveMember(object, member, *instruction->cache));
+	}
+
+	static void assignStack(OtVM& vm, OtJitContext&, Instruction* instruction) {
+		auto value = vm.stack.top();
+		vm.stack.setFrameItem(instruction->operand1, value);
+	}
+
+	static void assignMember(OtVM& vm, OtJitContext&, Instruction* instruction) {
+		auto& object = *instruction->constant;
+		auto value = vm.stack.top();
+		object->set(static_cast<OtID>(instruction->operand1), value);
+	}
+
+	// get an operand that isn't on the stack
+	template <OtJitOperand kind>
+	static inline OtObject getOperand(OtVM& vm, Instruction* instruction) {
+		if constexpr (kind == OtJitOperand::slot) {
+			return vm.stack.getFrameItem(instruction->operand1);
+
+		} else {
+			return *instruction->constant;
+		}
+	}
+
+	// binary operator with its operands and an optional conditional jump
+	// (the instruction is the first one of the fused sequence)
+	template <OtJitOperand left, OtJitOperand right, OtJitBranch branch>
+	static bool binaryOperator(OtVM& vm, OtJitContext&, Instruction* instruction) {
+		constexpr size_t pushes = (left != OtJitOperand::stack) + (right != OtJitOperand::stack);
+		auto operation = instruction + pushes;
+		auto& stack = vm.stack;
+		OtObject result;
+
+		if constexpr (pushes == 0) {
+			result = vm.primitiveOperator(operation->opcode, stack.getSP(2));
+
+		} else if constexpr (pushes == 1) {
+			OtObject operands[2] = {stack.top(), getOperand<right>(vm, instruction)};
+			result = vm.primitiveOperator(operation->opcode, operands);
+
+			if (result) {
+				stack.pop();
+
+			} else {
+				stack.push(std::move(operands[1]));
+			}
+
+		} else {
+			OtObject operands[2] = {getOperand<left>(vm, instruction), getOperand<right>(vm, instruction + 1)};
+			result = vm.primitiveOperator(operation->opcode, operands);
+
+			if (!result) {
+				stack.push(std::move(operands[0]));
+				stack.push(std::move(operands[1]));
+			}
+		}
+
+		// call the operator method when the fast path didn't work
+		if (!result) {
+			auto operands = stack.getSP(2);
+			result = operation->cache->lookup(operands[0], static_cast<OtID>(operation->operand1))->operator()(2, operands);
+			stack.pop(2);
+
+		} else if constexpr (pushes == 0) {
+			stack.pop(2);
+		}
+
+		if constexpr (branch == OtJitBranch::none) {
+			stack.push(result ? std::move(result) : vm.null);
+			return false;
+
+		} else if constexpr (branch == OtJitBranch::ifTrue) {
+			return (result ? result : vm.null)->operator bool();
+
+		} else {
+			return !(result ? result : vm.null)->operator bool();
+		}
+	}
+};
+
+
+//
+//	OtJit::Helpers::get
+//
+
+OtJit::Helpers::Function OtJit::Helpers::get(Opcode opcode) {
+	switch (opcode) {
+		case Opcode::statement: return &call<statement>;
+		case Opcode::push: return &call<push>;
+		case Opcode::pushNull: return &call<pushNull>;
+		case Opcode::pop: return &call<pop>;
+		case Opcode::popCount: return &call<popCount>;
+		case Opcode::dup: return &call<dup>;
+		case Opcode::swap: return &call<swap>;
+		case Opcode::move: return &call<move>;
+		case Opcode::jumpTrue: return &call<jumpTrue>;
+		case Opcode::jumpFalse: return &call<jumpFalse>;
+		case Opcode::member: return &call<member>;
+		case Opcode::super: return &call<super>;
+		case Opcode::method: return &call<method>;
+		case Opcode::pushTry: return &call<pushTry>;
+		case Opcode::popTry: return &call<popTry>;
+		case Opcode::iterate: return &call<iterate>;
+		case Opcode::pushStackObject: return &call<pushStackObject>;
+		case Opcode::pushStackMember: return &call<pushStackMember>;
+		case Opcode::pushObjectMember: return &call<pushObjectMember>;
+		case Opcode::pushMember: return &call<pushMember>;
+		case Opcode::assignStack: return &call<assignStack>;
+		case Opcode::assignMember: return &call<assignMember>;
+
+		case Opcode::add:
+		case Opcode::subtract:
+		case Opcode::multiply:
+		case Opcode::divide:
+		case Opcode::modulo:
+		case Opcode::equal:
+		case Opcode::notEqual:
+		case Opcode::lessThan:
+		case Opcode::lessEqual:
+		case Opcode::greaterThan:
+		case Opcode::greaterEqual:
+			return getBinaryOperator(OtJitOperand::stack, OtJitOperand::stack, OtJitBranch::none);
+
+		// these are native code without a helper
+		case Opcode::jump:
+		case Opcode::exit:
+			break;
+	}
+
+	return nullptr;
+}
+
+
+//
+//	OtJit::Helpers::getBinaryOperator
+//
+
+OtJit::Helpers::Function OtJit::Helpers::getBinaryOperator(OtJitOperand left, OtJitOperand right, OtJitBranch branch) {
+	if (left == OtJitOperand::stack) {
+		switch (right) {
+			case OtJitOperand::stack: return getBinaryOperator<OtJitOperand::stack, OtJitOperand::stack>(branch);
+			case OtJitOperand::slot: return getBinaryOperator<OtJitOperand::stack, OtJitOperand::slot>(branch);
+			case OtJitOperand::constant: return getBinaryOperator<OtJitOperand::stack, OtJitOperand::constant>(branch);
+		}
+
+	} else if (right == OtJitOperand::slot) {
+		return left == OtJitOperand::slot ?
+			getBinaryOperator<OtJitOperand::slot, OtJitOperand::slot>(branch) :
+			getBinaryOperator<OtJitOperand::constant, OtJitOperand::slot>(branch);
+
+	} else if (left == OtJitOperand::slot && right == OtJitOperand::constant) {
+		return getBinaryOperator<OtJitOperand::slot, OtJitOperand::constant>(branch);
+	}
+
+	// other combinations are never generated by the compiler (constant expressions are folded)
+	return nullptr;
+}
+
+
+//
+//	OtJit::Layout
+//
+//	Native code reads and writes the interpreter's data directly. The offsets
+//	are taken from live instances so they always match the compiler's layout
+//	of these classes.
+//
+
+struct OtJit::Layout {
+	// virtual machine
+	int32_t stack;
+	int32_t sp;
+	int32_t capacity;
+	int32_t integerType;
+	int32_t realType;
+	int32_t methodsVersion;
+	int32_t methodsValid;
+
+	// objects
+	int32_t type;
+	int32_t referenceCount;
+	int32_t cycleInfo;
+	int32_t slots;
+	int32_t integerValue;
+	int32_t realValue;
+};
+
+const OtJit::Layout& OtJit::getLayout() {
+	static_assert(sizeof(OtObject) == sizeof(void*), "Objects pointers must be plain pointers");
+	static_assert(sizeof(OtType) == sizeof(void*), "Types must be plain pointers");
+	static_assert(sizeof(OtObjectClass::referenceCount) == 4 && sizeof(OtObjectClass::cycleInfo) == 4, "Reference counts must be 32 bits");
+
+	static Layout layout = []() {
+		auto offset = [](const void* object, const void* member) {
+			return static_cast<int32_t>(static_cast<const char*>(member) - static_cast<const char*>(object));
+		};
+
+		auto& vm = OtVM::instance();
+		auto integer = OtInteger::create(0);
+		auto real = OtReal::create(0.0);
+		OtObjectClass* object = integer.raw();
+
+		Layout result;
+		result.stack = offset(&vm, &vm.stack.stack);
+		result.sp = offset(&vm, &vm.stack.sp);
+		result.capacity = offset(&vm, &vm.stack.capacity);
+		result.integerType = offset(&vm, &vm.integerType);
+		result.realType = offset(&vm, &vm.realType);
+		result.methodsVersion = offset(&vm, &vm.primitiveMethodsVersion);
+		result.methodsValid = offset(&vm, &vm.primitiveMethodsValid);
+		result.type = offset(object, &object->type);
+		result.referenceCount = offset(object, &object->referenceCount);
+		result.cycleInfo = offset(object, &object->cycleInfo);
+		result.slots = offset(object, &object->slots);
+		result.integerValue = offset(integer.raw(), &integer->value);
+		result.realValue = offset(real.raw(), &real->value);
+		return result;
+	}();
+
+	return layout;
+}
+
+
+//
+//	OtJitCode::OtJitCode
+//
+
+OtJitCode::OtJitCode(const std::vector<uint8_t>& code, std::vector<size_t>&& o) : offsets(std::move(o)) {
+#if OT_JIT_SUPPORTED
+	// code is written before the memory becomes executable (it is never writable and executable at the same time)
+	auto pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+	size = (code.size() + pageSize - 1) / pageSize * pageSize;
+	auto address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+	if (address != MAP_FAILED) {
+		std::memcpy(address, code.data(), code.size());
+
+		if (mprotect(address, size, PROT_READ | PROT_EXEC) == 0) {
+			memory = address;
+
+		} else {
+			munmap(address, size);
+		}
+	}
+#else
+	(void) code;
+#endif
+}
+
+
+//
+//	OtJitCode::~OtJitCode
+//
+
+OtJitCode::~OtJitCode() {
+#if OT_JIT_SUPPORTED
+	if (memory) {
+		munmap(memory, size);
+	}
+#endif
+}
+
+
+//
+//	OtJitCode::run
+//
+
+bool OtJitCode::run(OtJitContext& context, size_t instruction) {
+	// native code starts with a prologue that jumps to the requested entry point
+	// (only the first instruction, jump targets and exception handlers can be entered)
+	OtAssert(offsets[instruction]);
+	using Entry = int (*)(OtJitContext*, const void*, OtVM*, Instruction**, std::atomic<uint32_t>*, size_t);
+	Entry entry;
+	std::memcpy(&entry, &memory, sizeof(entry));
+	auto address = static_cast<uint8_t*>(memory) + offsets[instruction];
+	return entry(&context, address, context.vm, context.instruction, context.hooks, context.frame) == statusExit;
+}
+
+
+//
+//	OtJit::getCode
+//
+
+OtJitCode* OtJit::getCode(OtByteCodeClass* bytecode) {
+	auto& code = bytecode->getNativeCode();
+
+	if (!code) {
+		auto& hotness = bytecode->getHotness();
+
+		if (hotness != notCompilable && ++hotness >= OtConfig::getJitThreshold()) {
+			code = compile(bytecode);
+
+			if (!code) {
+				hotness = notCompilable;
+			}
+		}
+	}
+
+	return code.get();
+}
+
+
+//
+//	OtJit::isSupportedOpcode
+//
+
+bool OtJit::isSupportedOpcode(OtByteCodeClass::Opcode opcode) {
+	return opcode == Opcode::jump || opcode == Opcode::exit || Helpers::get(opcode) != nullptr;
+}
+
+
+
+
+//
+//	OtJitAssembler
+//
+//	Just enough of an x86-64 assembler for the code templates. Labels are the
+//	instruction addresses and the epilogue followed by labels local to a
+//	template. Jumps are patched once all labels have an address.
+//
+
+enum OtJitRegister : uint8_t {
+	rax, rcx, rdx, rbx, rsp, rbp, rsi, rdi, r8, r9, r10, r11, r12, r13, r14, r15
+};
+
+enum class OtJitCondition : uint8_t {
+	below = 0x2,
+	aboveEqual = 0x3,
+	equal = 0x4,
+	notEqual = 0x5,
+	belowEqual = 0x6,
+	above = 0x7,
+	parity = 0xa,
+	noParity = 0xb,
+	less = 0xc,
+	greaterEqual = 0xd,
+	lessEqual = 0xe,
+	greater = 0xf
+};
+
+// the opposite condition
+static inline OtJitCondition operator!(OtJitCondition condition) {
+	return static_cast<OtJitCondition>(static_cast<uint8_t>(condition) ^ 1);
+}
+
+// a memory operand (base + index * scale + displacement, rsp as the index means no index)
+struct OtJitMemory {
+	OtJitRegister base;
+	int32_t displacement = 0;
+	OtJitRegister index = rsp;
+	uint8_t scale = 1;
+};
+
+class OtJitAssembler {
+public:
+	// constructor
+	OtJitAssembler(size_t count) : labels(count, 0) {}
+
+	// emit bytes and immediates
+	inline void emit(std::initializer_list<uint8_t> bytes) { code.insert(code.end(), bytes); }
+
+	template <typename T>
+	inline void emitImmediate(T value) {
+		auto bytes = reinterpret_cast<uint8_t*>(&value);
+		code.insert(code.end(), bytes, bytes + sizeof(T));
+	}
+
+	// emit an instruction with a register (or an opcode extension) and a memory operand
+	// (wide instructions work on 64 bits, the prefix is a mandatory prefix for SSE instructions)
+	void emit(std::initializer_list<uint8_t> opcode, uint8_t reg, const OtJitMemory& memory, bool wide=true, uint8_t prefix=0) {
+		emitPrefixes(prefix, wide, reg, memory.index, memory.base);
+		emit(opcode);
+
+		if (memory.index == rsp && (memory.base & 7) != rsp) {
+			emitByte(0x80 | ((reg & 7) << 3) | (memory.base & 7));
+
+		} else {
+			auto scale = memory.scale == 8 ? 3 : (memory.scale == 4 ? 2 : (memory.scale == 2 ? 1 : 0));
+			emitByte(0x84 | ((reg & 7) << 3));
+			emitByte((scale << 6) | ((memory.index & 7) << 3) | (memory.base & 7));
+		}
+
+		emitImmediate<int32_t>(memory.displacement);
+	}
+
+	// emit an instruction with two register operands (or an opcode extension and a register)
+	void emit(std::initializer_list<uint8_t> opcode, uint8_t reg, OtJitRegister rm, bool wide=true) {
+		emitPrefixes(0, wide, reg, rsp, rm);
+		emit(opcode);
+		emitByte(0xc0 | ((reg & 7) << 3) | (rm & 7));
+	}
+
+	// load a 64-bit immediate into a register
+	inline void emitLoad(OtJitRegister reg, uint64_t value) {
+		emitByte(0x48 | ((reg & 8) >> 3));
+		emitByte(0xb8 | (reg & 7));
+		emitImmediate(value);
+	}
+
+	template <typename T>
+	inline void emitLoad(OtJitRegister reg, T* pointer) {
+		emitLoad(reg, reinterpret_cast<uint64_t>(pointer));
+	}
+
+	// emit a jump (with a 32-bit displacement) to a label
+	inline void emitJump(std::initializer_list<uint8_t> opcode, size_t label) {
+		emit(opcode);
+		fixups.emplace_back(code.size(), label);
+		emitImmediate<int32_t>(0);
+	}
+
+	inline void emitJump(size_t label) {
+		emitJump({0xe9}, label);
+	}
+
+	inline void emitJump(OtJitCondition condition, size_t label) {
+		emitJump({0x0f, static_cast<uint8_t>(0x80 | static_cast<uint8_t>(condition))}, label);
+	}
+
+	// set a byte register to a condition
+	inline void emitSet(OtJitCondition condition, OtJitRegister reg) {
+		emit({0x0f, static_cast<uint8_t>(0x90 | static_cast<uint8_t>(condition))}, 0, reg, false);
+	}
+
+	// manage labels
+	inline size_t createLabel() { labels.emplace_back(0); return labels.size() - 1; }
+	inline void bind(size_t label) { labels[label] = code.size(); }
+
+	// resolve the jumps
+	inline void patch() {
+		for (auto& [position, label] : fixups) {
+			auto displacement = static_cast<int32_t>(static_cast<int64_t>(labels[label]) - static_cast<int64_t>(position + 4));
+			std::memcpy(code.data() + position, &displacement, sizeof(displacement));
+		}
+	}
+
+	std::vector<uint8_t> code;
+	std::vector<size_t> labels;
+	std::vector<std::pair<size_t, size_t>> fixups;
+
+private:
+	inline void emitByte(int value) { code.emplace_back(static_cast<uint8_t>(value)); }
+
+	inline void emitPrefixes(uint8_t prefix, bool wide, uint8_t reg, uint8_t index, uint8_t base) {
+		if (prefix) {
+			emitByte(prefix);
+		}
+
+		auto rex = 0x40 | (wide ? 8 : 0) | ((reg & 8) >> 1) | ((index & 8) >> 2) | ((base & 8) >> 3);
+
+		if (rex != 0x40) {
+			emitByte(rex);
+		}
+	}
+};
+
+
+//
+//	OtJit::compile
+//
+//	Register use: rbx holds the virtual machine, r12 the address of the
+//	interpreter's current instruction, r13 the context, r14 the hook flags
+//	and r15 the byte offset of the frame on the stack (they are saved by the
+//	prologue). Helpers return their status in eax. Native code loads the
+//	stack's address into r10 and its size into r11 whenever it needs them as
+//	helpers can move the stack.
+//
+
+std::shared_ptr<OtJitCode> OtJit::compile(OtByteCodeClass* bytecode) {
+#if OT_JIT_SUPPORTED
+	auto instructions = bytecode->getInstructions(nullptr);
+	auto count = bytecode->getInstructionCount();
+
+	// find the instructions that can be entered from elsewhere (they can't be fused with the previous ones)
+	// and a stack reference (they only come from constants so assignments to them need native code if there are any)
+	std::vector<bool> targets(count, false);
+	targets[0] = true;
+	OtStackReferenceClass* stackReference = nullptr;
+
+	for (size_t i = 0; i < count; i++) {
+		auto& instruction = instructions[i];
+
+		if (!isSupportedOpcode(instruction.opcode)) {
+			return nullptr;
+		}
+
+		if (instruction.opcode == Opcode::push && instruction.constant->isKindOf<OtStackReferenceClass>()) {
+			stackReference = static_cast<OtStackReferenceClass*>(instruction.constant->raw());
+		}
+
+		switch (instruction.opcode) {
+			case Opcode::jump:
+			case Opcode::jumpTrue:
+			case Opcode::jumpFalse:
+			case Opcode::pushTry:
+				targets[instruction.operand1] = true;
+				break;
+
+			case Opcode::iterate:
+				targets[instruction.operand2] = true;
+				break;
+
+			default:
+				break;
+		}
+	}
+
+	auto fusable = [&](size_t i) {
+		return i < count && !targets[i];
+	};
+
+	auto isBinaryOperator = [](Opcode opcode) {
+		return opcode >= Opcode::add && opcode <= Opcode::greaterEqual;
+	};
+
+	auto getOperand = [](Opcode opcode) {
+		return opcode == Opcode::pushStackObject ? OtJitOperand::slot : (opcode == Opcode::push ? OtJitOperand::constant : OtJitOperand::stack);
+	};
+
+	// the instruction labels are zero for fused instructions
+	static constexpr size_t noLabel = std::numeric_limits<size_t>::max();
+	auto& layout = getLayout();
+	auto& vm = OtVM::instance();
+
+	// the member version is per thread (native code only runs on the thread that owns the bytecode)
+	const void* memberVersion = &OtTypeClass::memberVersion;
+	OtJitAssembler assembler(count + 1);
+	auto epilogue = count;
+
+	// prologue: save the registers we use, load them and jump to the entry point
+	// (the stack stays aligned for calls as five registers and the return address are on it)
+	assembler.emit({0x53});							// push rbx
+	assembler.emit({0x41, 0x54});					// push r12
+	assembler.emit({0x41, 0x55});					// push r13
+	assembler.emit({0x41, 0x56});					// push r14
+	assembler.emit({0x41, 0x57});					// push r15
+	assembler.emit({0x49, 0x89, 0xfd});				// mov r13, rdi
+	assembler.emit({0x48, 0x89, 0xd3});				// mov rbx, rdx
+	assembler.emit({0x49, 0x89, 0xcc});				// mov r12, rcx
+	assembler.emit({0x4d, 0x89, 0xc6});				// mov r14, r8
+	assembler.emit({0x4d, 0x89, 0xcf});				// mov r15, r9
+	assembler.emit({0xff, 0xe6});					// jmp rsi
+
+	auto callHelper = [&](Helpers::Function helper, Instruction* current, Instruction* argument) {
+		assembler.emit({0x48, 0xbe});					// mov rsi, current
+		assembler.emitImmediate(reinterpret_cast<uint64_t>(current));
+		assembler.emit({0x49, 0x89, 0x34, 0x24});		// mov [r12], rsi
+
+		if (argument != current) {
+			assembler.emit({0x48, 0xbe});				// mov rsi, argument
+			assembler.emitImmediate(reinterpret_cast<uint64_t>(argument));
+		}
+
+		assembler.emit({0x48, 0x89, 0xdf});				// mov rdi, rbx
+		assembler.emit({0x4c, 0x89, 0xea});				// mov rdx, r13
+		assembler.emit({0x48, 0xb8});					// mov rax, helper
+		assembler.emitImmediate(reinterpret_cast<uint64_t>(helper));
+		assembler.emit({0xff, 0xd0});					// call rax
+	};
+
+	auto branchOnStatus = [&](size_t target) {
+		assembler.emit({0x83, 0xf8, statusBranch});		// cmp eax, statusBranch
+		assembler.emitJump(OtJitCondition::equal, target);
+	};
+
+	auto leaveOnStatus = [&]() {
+		assembler.emit({0x85, 0xc0});					// test eax, eax
+		assembler.emitJump(OtJitCondition::notEqual, epilogue);
+	};
+
+	// the stack and its slots (r10 and r11 must be loaded)
+	auto loadStack = [&]() {
+		assembler.emit({0x8b}, r10, {rbx, layout.stack});	// mov r10, stack
+		assembler.emit({0x8b}, r11, {rbx, layout.sp});		// mov r11, sp
+	};
+
+	auto stackItem = [](int32_t offset) {
+		return OtJitMemory{r10, offset * static_cast<int32_t>(sizeof(OtObject)), r11, sizeof(OtObject)};
+	};
+
+	auto frameItem = [](size_t slot) {
+		return OtJitMemory{r10, static_cast<int32_t>(slot * sizeof(OtObject)), r15};
+	};
+
+	// drop a reference to an object in a register and release it when required
+	auto release = [&](OtJitRegister object) {
+		auto call = assembler.createLabel();
+		auto done = assembler.createLabel();
+
+		assembler.emit({0xff}, 1, {object, layout.referenceCount}, false);	// dec dword [object + referenceCount]
+		assembler.emitJump(OtJitCondition::equal, call);
+		assembler.emit({0xf7}, 0, {object, layout.cycleInfo}, false);		// test dword [object + cycleInfo], mask
+		assembler.emitImmediate<uint32_t>(OtCycleCollector::positionMask | OtCycleCollector::acyclicFlag);
+		assembler.emitJump(OtJitCondition::notEqual, done);
+
+		assembler.bind(call);
+		assembler.emit({0x89}, object, rdi);								// mov rdi, object
+		assembler.emitLoad(rax, &Helpers::release);							// mov rax, Helpers::release
+		assembler.emit({0xff, 0xd0});										// call rax
+		assembler.bind(done);
+	};
+
+	// push a frame slot or a constant
+	auto push = [&](Instruction* instruction) {
+		auto slow = assembler.createLabel();
+		auto done = assembler.createLabel();
+
+		// the stack can't grow here and the slot we push to must be empty (moves leave copies above the top)
+		loadStack();
+		assembler.emit({0x3b}, r11, {rbx, layout.capacity});				// cmp r11, capacity
+		assembler.emitJump(OtJitCondition::equal, slow);
+		assembler.emit({0x83}, 7, stackItem(0));							// cmp qword [stack + sp * 8], 0
+		assembler.emitImmediate<uint8_t>(0);
+		assembler.emitJump(OtJitCondition::notEqual, slow);
+
+		if (instruction->opcode == Opcode::push) {
+			assembler.emitLoad(rax, instruction->constant->raw());			// mov rax, constant
+
+		} else {
+			assembler.emit({0x8b}, rax, frameItem(instruction->operand1));	// mov rax, slot
+			assembler.emit({0x85}, rax, rax);								// test rax, rax
+			assembler.emitJump(OtJitCondition::equal, slow);
+		}
+
+		assembler.emit({0xff}, 0, {rax, layout.referenceCount}, false);		// inc dword [rax + referenceCount]
+		assembler.emit({0x89}, rax, stackItem(0));							// mov [stack + sp * 8], rax
+		assembler.emit({0xff}, 0, r11);										// inc r11
+		assembler.emit({0x89}, r11, {rbx, layout.sp});						// mov sp, r11
+		assembler.emitJump(done);
+
+		assembler.bind(slow);
+		callHelper(Helpers::get(instruction->opcode), instruction, instruction);
+		leaveOnStatus();
+		assembler.bind(done);
+	};
+
+	// pop the top of the stack
+	auto pop = [&]() {
+		auto done = assembler.createLabel();
+
+		loadStack();
+		assembler.emit({0xff}, 1, r11);										// dec r11
+		assembler.emit({0x89}, r11, {rbx, layout.sp});						// mov sp, r11
+		assembler.emit({0x8b}, rax, stackItem(0));							// mov rax, [stack + sp * 8]
+		assembler.emit({0xc7}, 0, stackItem(0));							// mov qword [stack + sp * 8], 0
+		assembler.emitImmediate<int32_t>(0);
+		assembler.emit({0x85}, rax, rax);									// test rax, rax
+		assembler.emitJump(OtJitCondition::equal, done);
+		release(rax);
+		assembler.bind(done);
+	};
+
+	// assign the top of the stack to a frame slot (the instruction's first operand)
+	auto assignStack = [&](Instruction* instruction) {
+		auto slow = assembler.createLabel();
+		auto done = assembler.createLabel();
+
+		loadStack();
+		assembler.emit({0x8b}, rax, stackItem(-1));							// mov rax, [stack + sp * 8 - 8]
+		assembler.emit({0x8b}, rcx, frameItem(instruction->operand1));		// mov rcx, slot
+		assembler.emit({0x39}, rax, rcx);									// cmp rcx, rax
+		assembler.emitJump(OtJitCondition::equal, done);
+		assembler.emit({0x85}, rax, rax);									// test rax, rax
+		assembler.emitJump(OtJitCondition::equal, slow);
+		assembler.emit({0xff}, 0, {rax, layout.referenceCount}, false);		// inc dword [rax + referenceCount]
+		assembler.emit({0x89}, rax, frameItem(instruction->operand1));		// mov slot, rax
+		assembler.emit({0x85}, rcx, rcx);									// test rcx, rcx
+		assembler.emitJump(OtJitCondition::equal, done);
+		release(rcx);
+		assembler.emitJump(done);
+
+		assembler.bind(slow);
+		callHelper(Helpers::get(Opcode::assignStack), instruction, instruction);
+		leaveOnStatus();
+		assembler.bind(done);
+	};
+
+	// assign a value to a stack reference (and optionally discard the result)
+	auto assignReference = [&](Instruction* instruction, bool discard) {
+		auto slow = assembler.createLabel();
+		auto done = assembler.createLabel();
+
+		// the reference must be a plain one that survives being dropped from the stack
+		loadStack();
+		assembler.emit({0x8b}, rax, stackItem(-2));							// mov rax, reference
+		assembler.emit({0x85}, rax, rax);									// test rax, rax
+		assembler.emitJump(OtJitCondition::equal, slow);
+		assembler.emitLoad(rcx, stackReference->getType().raw());			// mov rcx, StackReference
+		assembler.emit({0x3b}, rcx, {rax, layout.type});					// cmp rcx, [rax + type]
+		assembler.emitJump(OtJitCondition::notEqual, slow);
+		assembler.emit({0x83}, 7, {rax, layout.slots});						// cmp qword [rax + slots], 0
+		assembler.emitImmediate<uint8_t>(0);
+		assembler.emitJump(OtJitCondition::notEqual, slow);
+		assembler.emit({0x83}, 7, {rax, layout.referenceCount}, false);		// cmp dword [rax + referenceCount], 1
+		assembler.emitImmediate<uint8_t>(1);
+		assembler.emitJump(OtJitCondition::belowEqual, slow);
+		assembler.emit({0xf7}, 0, {rax, layout.cycleInfo}, false);			// test dword [rax + cycleInfo], mask
+		assembler.emitImmediate<uint32_t>(OtCycleCollector::positionMask | OtCycleCollector::acyclicFlag);
+		assembler.emitJump(OtJitCondition::equal, slow);
+		assembler.emit({0x8b}, rcx, stackItem(-1));							// mov rcx, value
+		assembler.emit({0x85}, rcx, rcx);									// test rcx, rcx
+		assembler.emitJump(OtJitCondition::equal, slow);
+
+		// find the slot and replace its object
+		auto slot = static_cast<int32_t>(reinterpret_cast<char*>(&stackReference->slot) - reinterpret_cast<char*>(stackReference));
+		assembler.emit({0x8b}, rdx, {rax, slot});							// mov rdx, [rax + slot]
+		assembler.emit({0xc1}, 4, rdx);										// shl rdx, 3
+		assembler.emitImmediate<uint8_t>(3);
+		assembler.emit({0x01}, r15, rdx);									// add rdx, r15
+		assembler.emit({0x8b}, rsi, {r10, 0, rdx});							// mov rsi, [r10 + rdx]
+		assembler.emit({0xff}, 1, {rax, layout.referenceCount}, false);		// dec dword [rax + referenceCount]
+		assembler.emit({0x89}, rcx, {r10, 0, rdx});							// mov [r10 + rdx], rcx
+
+		if (discard) {
+			// the stack's reference to the value moves to the slot
+			assembler.emit({0xc7}, 0, stackItem(-1));						// mov qword [stack + sp * 8 - 8], 0
+			assembler.emitImmediate<int32_t>(0);
+			assembler.emit({0xc7}, 0, stackItem(-2));						// mov qword [stack + sp * 8 - 16], 0
+			assembler.emitImmediate<int32_t>(0);
+			assembler.emit({0x83}, 5, r11);									// sub r11, 2
+			assembler.emitImmediate<uint8_t>(2);
+
+		} else {
+			// the value is also the result
+			assembler.emit({0xff}, 0, {rcx, layout.referenceCount}, false);	// inc dword [rcx + referenceCount]
+			assembler.emit({0x89}, rcx, stackItem(-2));						// mov [stack + sp * 8 - 16], rcx
+			assembler.emit({0xc7}, 0, stackItem(-1));						// mov qword [stack + sp * 8 - 8], 0
+			assembler.emitImmediate<int32_t>(0);
+			assembler.emit({0xff}, 1, r11);									// dec r11
+		}
+
+		assembler.emit({0x89}, r11, {rbx, layout.sp});						// mov sp, r11
+		assembler.emit({0x85}, rsi, rsi);									// test rsi, rsi
+		assembler.emitJump(OtJitCondition::equal, done);
+		release(rsi);
+		assembler.emitJump(done);
+
+		assembler.bind(slow);
+		callHelper(discard ? Helpers::getMethodPop() : Helpers::get(Opcode::method), instruction, instruction);
+		leaveOnStatus();
+		assembler.bind(done);
+	};
+
+	auto assignID = OtIdentifier::create("__assign__");
+
+	auto isAssignment = [&](size_t i) {
+		return stackReference && fusable(i) && instructions[i].opcode == Opcode::method &&
+			static_cast<OtID>(instructions[i].operand1) == assignID && instructions[i].operand2 == 1;
+	};
+
+	auto isStackReference = [&](Instruction* instruction) {
+		return instruction->opcode == Opcode::push && instruction->constant->isKindOf<OtStackReferenceClass>();
+	};
+
+	// apply a binary operator to integers or reals (see below)
+	enum class Primitive {
+		integer,
+		real
+	};
+
+	auto getConstantType = [&](OtJitOperand operand, Instruction* instruction) -> OtTypeClass* {
+		if (operand == OtJitOperand::constant && !(*instruction->constant)->hasMembers()) {
+			auto type = (*instruction->constant)->getType().raw();
+			return (type == vm.integerType || type == vm.realType) ? type : nullptr;
+		}
+
+		return nullptr;
+	};
+
+	auto primitiveOperator = [&](Primitive primitive, Instruction* operation, size_t pops, OtJitBranch branch, size_t target, size_t done, size_t updated) {
+		// the left operand is in rsi, the right one in rdi
+		auto opcode = operation->opcode;
+		auto realComparison = primitive == Primitive::real && opcode >= Opcode::equal;
+		OtJitCondition condition = OtJitCondition::equal;
+
+		if (primitive == Primitive::integer) {
+			static constexpr OtJitCondition conditions[] = {
+				OtJitCondition::equal, OtJitCondition::notEqual, OtJitCondition::less,
+				OtJitCondition::lessEqual, OtJitCondition::greater, OtJitCondition::greaterEqual};
+
+			assembler.emit({0x8b}, rax, {rsi, layout.integerValue});				// mov rax, [rsi + value]
+
+			switch (opcode) {
+				case Opcode::add: assembler.emit({0x03}, rax, {rdi, layout.integerValue}); break;			// add rax, [rdi + value]
+				case Opcode::subtract: assembler.emit({0x2b}, rax, {rdi, layout.integerValue}); break;		// sub rax, [rdi + value]
+				case Opcode::multiply: assembler.emit({0x0f, 0xaf}, rax, {rdi, layout.integerValue}); break;	// imul rax, [rdi + value]
+
+				default:
+					assembler.emit({0x3b}, rax, {rdi, layout.integerValue});		// cmp rax, [rdi + value]
+					condition = conditions[static_cast<size_t>(opcode) - static_cast<size_t>(Opcode::equal)];
+					break;
+			}
+
+		} else {
+			// "less" compares the other way around so unordered operands (NaNs) are never less or greater
+			auto swap = opcode == Opcode::lessThan || opcode == Opcode::lessEqual;
+			auto first = swap ? rdi : rsi;
+			auto second = swap ? rsi : rdi;
+			assembler.emit({0x0f, 0x10}, 0, {first, layout.realValue}, false, 0xf2);	// movsd xmm0, [first + value]
+
+			switch (opcode) {
+				case Opcode::add: assembler.emit({0x0f, 0x58}, 0, {second, layout.realValue}, false, 0xf2); break;		// addsd xmm0, [second + value]
+				case Opcode::subtract: assembler.emit({0x0f, 0x5c}, 0, {second, layout.realValue}, false, 0xf2); break;	// subsd xmm0, [second + value]
+				case Opcode::multiply: assembler.emit({0x0f, 0x59}, 0, {second, layout.realValue}, false, 0xf2); break;	// mulsd xmm0, [second + value]
+
+				default:
+					assembler.emit({0x0f, 0x2e}, 0, {second, layout.realValue}, false, 0x66);	// ucomisd xmm0, [second + value]
+					condition = (opcode == Opcode::lessEqual || opcode == Opcode::greaterEqual) ? OtJitCondition::aboveEqual : OtJitCondition::above;
+					break;
+			}
+		}
+
+		if (opcode <= Opcode::multiply) {
+			// a result assigned to the slot of the left operand replaces its value if nobody else can see it
+			if (updated != noLabel) {
+				auto create = assembler.createLabel();
+				assembler.emit({0x83}, 7, {rsi, layout.referenceCount}, false);		// cmp dword [rsi + referenceCount], 1
+				assembler.emitImmediate<uint8_t>(1);
+				assembler.emitJump(OtJitCondition::notEqual, create);
+
+				if (primitive == Primitive::integer) {
+					assembler.emit({0x89}, rax, {rsi, layout.integerValue});		// mov [rsi + value], rax
+
+				} else {
+					assembler.emit({0x0f, 0x11}, 0, {rsi, layout.realValue}, false, 0xf2);	// movsd [rsi + value], xmm0
+				}
+
+				assembler.emitJump(updated);
+				assembler.bind(create);
+			}
+
+			// the result needs a new object
+			if (primitive == Primitive::integer) {
+				assembler.emit({0x89}, rax, rcx);								// mov rcx, rax
+			}
+
+			assembler.emit({0x48, 0xbe});										// mov rsi, operation
+			assembler.emitImmediate(reinterpret_cast<uint64_t>(operation));
+			assembler.emit({0x49, 0x89, 0x34, 0x24});							// mov [r12], rsi
+			assembler.emit({0x89}, rbx, rdi);									// mov rdi, rbx
+			assembler.emitLoad(rsi, pops);										// mov rsi, pops
+			assembler.emit({0x89}, r13, rdx);									// mov rdx, r13
+
+			if (primitive == Primitive::integer) {
+				assembler.emitLoad(rax, &Helpers::pushInteger);				// mov rax, Helpers::pushInteger
+
+			} else {
+				assembler.emitLoad(rax, &Helpers::pushReal);					// mov rax, Helpers::pushReal
+			}
+
+			assembler.emit({0xff, 0xd0});										// call rax
+			leaveOnStatus();
+
+		} else if (branch != OtJitBranch::none) {
+			// branch on the comparison
+			auto jumpIfTrue = branch == OtJitBranch::ifTrue;
+
+			if (realComparison && (opcode == Opcode::equal || opcode == Opcode::notEqual)) {
+				// equal means the zero flag is set and the parity flag (unordered) isn't
+				if (jumpIfTrue == (opcode == Opcode::equal)) {
+					auto unordered = assembler.createLabel();
+					assembler.emitJump(OtJitCondition::parity, unordered);
+					assembler.emitJump(OtJitCondition::equal, target);
+					assembler.bind(unordered);
+
+				} else {
+					assembler.emitJump(OtJitCondition::parity, target);
+					assembler.emitJump(OtJitCondition::notEqual, target);
+				}
+
+			} else {
+				assembler.emitJump(jumpIfTrue ? condition : !condition, target);
+			}
+
+		} else {
+			// the result is a shared boolean
+			if (realComparison && opcode == Opcode::equal) {
+				assembler.emitSet(OtJitCondition::equal, rcx);					// sete cl
+				assembler.emitSet(OtJitCondition::noParity, rdx);				// setnp dl
+				assembler.emit({0x20}, rdx, rcx, false);						// and cl, dl
+
+			} else if (realComparison && opcode == Opcode::notEqual) {
+				assembler.emitSet(OtJitCondition::notEqual, rcx);				// setne cl
+				assembler.emitSet(OtJitCondition::parity, rdx);					// setp dl
+				assembler.emit({0x08}, rdx, rcx, false);						// or cl, dl
+
+			} else {
+				assembler.emitSet(condition, rcx);								// setcc cl
+			}
+
+			assembler.emit({0x0f, 0xb6}, rcx, rcx, false);						// movzx ecx, cl
+			assembler.emit({0x89}, rbx, rdi);									// mov rdi, rbx
+			assembler.emitLoad(rsi, pops);										// mov rsi, pops
+			assembler.emit({0x89}, r13, rdx);									// mov rdx, r13
+			assembler.emitLoad(rax, &Helpers::pushBoolean);					// mov rax, Helpers::pushBoolean
+			assembler.emit({0xff, 0xd0});										// call rax
+			leaveOnStatus();
+		}
+
+		assembler.emitJump(done);
+	};
+
+	// apply a binary operator with fused operand pushes and an optional conditional jump
+	// (integers and reals are handled by native code, everything else by the helper)
+	auto binaryOperator = [&](Instruction* instruction, size_t pushes, OtJitOperand left, OtJitOperand right, OtJitBranch branch, size_t target, Helpers::Function helper, size_t updated) {
+		auto operation = instruction + pushes;
+		auto opcode = operation->opcode;
+		auto leftPush = instruction;
+		auto rightPush = pushes ? instruction + pushes - 1 : instruction;
+		auto leftType = getConstantType(left, leftPush);
+		auto rightType = getConstantType(right, rightPush);
+
+		// native code handles additions, subtractions, multiplications and comparisons
+		// (conditional jumps only when no operands are on the stack as they would have to be popped first)
+		bool native =
+			opcode != Opcode::divide && opcode != Opcode::modulo &&
+			(branch == OtJitBranch::none || pushes == 2) &&
+			(left != OtJitOperand::constant || leftType) &&
+			(right != OtJitOperand::constant || rightType) &&
+			(!leftType || !rightType || leftType == rightType);
+
+		auto slow = assembler.createLabel();
+		auto done = assembler.createLabel();
+
+		if (native) {
+			// the primitive methods must be the original ones
+			assembler.emitLoad(rax, memberVersion);								// mov rax, &memberVersion
+			assembler.emit({0x8b}, rax, {rax, 0});								// mov rax, [rax]
+			assembler.emit({0x3b}, rax, {rbx, layout.methodsVersion});			// cmp rax, primitiveMethodsVersion
+			assembler.emitJump(OtJitCondition::notEqual, slow);
+			assembler.emit({0x80}, 7, {rbx, layout.methodsValid}, false);		// cmp byte primitiveMethodsValid, 0
+			assembler.emitImmediate<uint8_t>(0);
+			assembler.emitJump(OtJitCondition::equal, slow);
+
+			// get the operands (they must be plain objects as members could override the operators)
+			loadStack();
+
+			auto load = [&](OtJitRegister reg, OtJitOperand operand, Instruction* push, int32_t stackOffset) {
+				if (operand == OtJitOperand::constant) {
+					assembler.emitLoad(reg, push->constant->raw());				// mov reg, constant
+
+				} else {
+					assembler.emit({0x8b}, reg, operand == OtJitOperand::slot ? frameItem(push->operand1) : stackItem(stackOffset));	// mov reg, operand
+					assembler.emit({0x85}, reg, reg);							// test reg, reg
+					assembler.emitJump(OtJitCondition::equal, slow);
+				}
+
+				assembler.emit({0x83}, 7, {reg, layout.slots});					// cmp qword [reg + slots], 0
+				assembler.emitImmediate<uint8_t>(0);
+				assembler.emitJump(OtJitCondition::notEqual, slow);
+			};
+
+			load(rsi, left, leftPush, pushes == 0 ? -2 : -1);
+			load(rdi, right, rightPush, -1);
+
+			auto pops = 2 - pushes;
+			auto constantType = leftType ? leftType : rightType;
+
+			auto checkType = [&](OtJitRegister reg, OtJitOperand operand, size_t failed) {
+				if (operand != OtJitOperand::constant) {
+					assembler.emit({0x3b}, rax, {reg, layout.type});			// cmp rax, [reg + type]
+					assembler.emitJump(OtJitCondition::notEqual, failed);
+				}
+			};
+
+			if (constantType) {
+				// the constant tells us what to expect
+				auto integer = constantType == vm.integerType;
+				assembler.emit({0x8b}, rax, {rbx, integer ? layout.integerType : layout.realType});	// mov rax, type
+				checkType(rsi, left, slow);
+				checkType(rdi, right, slow);
+				primitiveOperator(integer ? Primitive::integer : Primitive::real, operation, pops, branch, target, done, updated);
+
+			} else {
+				// try integers and reals
+				auto notInteger = assembler.createLabel();
+				assembler.emit({0x8b}, rax, {rbx, layout.integerType});			// mov rax, integerType
+				checkType(rsi, left, notInteger);
+				checkType(rdi, right, slow);
+				primitiveOperator(Primitive::integer, operation, pops, branch, target, done, updated);
+
+				assembler.bind(notInteger);
+				assembler.emit({0x8b}, rax, {rbx, layout.realType});			// mov rax, realType
+				checkType(rsi, left, slow);
+				checkType(rdi, right, slow);
+				primitiveOperator(Primitive::real, operation, pops, branch, target, done, updated);
+			}
+		}
+
+		assembler.bind(slow);
+		callHelper(helper, operation, instruction);
+
+		if (branch != OtJitBranch::none) {
+			branchOnStatus(target);
+		}
+
+		leaveOnStatus();
+		assembler.bind(done);
+	};
+
+	for (size_t i = 0; i < count;) {
+		auto instruction = instructions + i;
+		assembler.bind(i);
+
+		// "variable = variable op operand" as a statement can update the variable's object
+		// (the reference to the variable is known so the result is assigned to its slot directly)
+		if (isStackReference(instruction) &&
+			fusable(i + 1) && instructions[i + 1].opcode == Opcode::pushStackObject &&
+			instructions[i + 1].operand1 == OtStackReference(*instruction->constant)->getSlot() &&
+			fusable(i + 2) && getOperand(instructions[i + 2].opcode) != OtJitOperand::stack &&
+			fusable(i + 3) && instructions[i + 3].opcode >= Opcode::add && instructions[i + 3].opcode <= Opcode::multiply &&
+			isAssignment(i + 4) &&
+			fusable(i + 5) && instructions[i + 5].opcode == Opcode::pop) {
+
+			auto right = getOperand(instructions[i + 2].opcode);
+			auto updated = assembler.createLabel();
+			binaryOperator(instruction + 1, 2, OtJitOperand::slot, right, OtJitBranch::none, 0, Helpers::getBinaryOperator(OtJitOperand::slot, right, OtJitBranch::none), updated);
+			assignStack(instruction + 1);
+			pop();
+			assembler.bind(updated);
+			i += 6;
+			continue;
+		}
+
+		// fuse operand pushes, a binary operator and a conditional jump
+		auto left = OtJitOperand::stack;
+		auto right = OtJitOperand::stack;
+		size_t pushes = 0;
+
+		if (getOperand(instruction->opcode) != OtJitOperand::stack && fusable(i + 1)) {
+			auto next = getOperand(instructions[i + 1].opcode);
+
+			if (next != OtJitOperand::stack && fusable(i + 2) && isBinaryOperator(instructions[i + 2].opcode)) {
+				left = getOperand(instruction->opcode);
+				right = next;
+				pushes = 2;
+
+			} else if (isBinaryOperator(instructions[i + 1].opcode)) {
+				right = getOperand(instruction->opcode);
+				pushes = 1;
+			}
+		}
+
+		if (pushes || isBinaryOperator(instruction->opcode)) {
+			auto jump = i + pushes + 1;
+			auto branch = OtJitBranch::none;
+
+			if (fusable(jump) && instructions[jump].opcode == Opcode::jumpTrue) {
+				branch = OtJitBranch::ifTrue;
+
+			} else if (fusable(jump) && instructions[jump].opcode == Opcode::jumpFalse) {
+				branch = OtJitBranch::ifFalse;
+			}
+
+			if (auto helper = Helpers::getBinaryOperator(left, right, branch)) {
+				auto target = branch == OtJitBranch::none ? 0 : instructions[jump].operand1;
+				binaryOperator(instruction, pushes, left, right, branch, target, helper, noLabel);
+				i += pushes + (branch == OtJitBranch::none ? 1 : 2);
+				continue;
+			}
+		}
+
+		// assignments to stack references
+		if (isAssignment(i)) {
+			auto discard = fusable(i + 1) && instructions[i + 1].opcode == Opcode::pop;
+			assignReference(instruction, discard);
+			i += discard ? 2 : 1;
+			continue;
+		}
+
+		// fuse method calls with the pop of their result
+		if (instruction->opcode == Opcode::method && fusable(i + 1) && instructions[i + 1].opcode == Opcode::pop) {
+			callHelper(Helpers::getMethodPop(), instruction, instruction);
+			leaveOnStatus();
+			i += 2;
+			continue;
+		}
+
+		switch (instruction->opcode) {
+			case Opcode::statement:
+				// only call the helper when a hook is requested
+				assembler.emit({0x41, 0x8b, 0x06});			// mov eax, [r14]
+				assembler.emit({0x85, 0xc0});				// test eax, eax
+				assembler.emitJump(OtJitCondition::equal, i + 1);
+				callHelper(Helpers::get(instruction->opcode), instruction, instruction);
+				leaveOnStatus();
+				break;
+
+			case Opcode::jump:
+				assembler.emitJump(instruction->operand1);
+				break;
+
+			case Opcode::exit:
+				assembler.emit({0xb8});						// mov eax, statusExit
+				assembler.emitImmediate<int32_t>(statusExit);
+				assembler.emitJump(epilogue);
+				break;
+
+			case Opcode::push:
+			case Opcode::pushStackObject:
+				push(instruction);
+				break;
+
+			case Opcode::pop:
+				pop();
+				break;
+
+			case Opcode::assignStack:
+				assignStack(instruction);
+				break;
+
+			case Opcode::jumpTrue:
+			case Opcode::jumpFalse:
+				callHelper(Helpers::get(instruction->opcode), instruction, instruction);
+				branchOnStatus(instruction->operand1);
+				leaveOnStatus();
+				break;
+
+			case Opcode::iterate:
+				callHelper(Helpers::get(instruction->opcode), instruction, instruction);
+				branchOnStatus(instruction->operand2);
+				leaveOnStatus();
+				break;
+
+			default:
+				callHelper(Helpers::get(instruction->opcode), instruction, instruction);
+				leaveOnStatus();
+				break;
+		}
+
+		i++;
+	}
+
+	// epilogue: restore the registers and return the status
+	assembler.bind(epilogue);
+	assembler.emit({0x41, 0x5f});						// pop r15
+	assembler.emit({0x41, 0x5e});						// pop r14
+	assembler.emit({0x41, 0x5d});						// pop r13
+	assembler.emit({0x41, 0x5c});						// pop r12
+	assembler.emit({0x5b});								// pop rbx
+	assembler.emit({0xc3});								// ret
+
+	assembler.patch();
+	auto labels = std::move(assembler.labels);
+	labels.resize(count);
+
+	auto code = std::make_shared<OtJitCode>(assembler.code, std::move(labels));
+	return code->isValid() ? code : nullptr;
+
+#else
+	(void) bytecode;
+	return nullptr;
+#endif
+}
@@ -0,0 +1,138 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+#pragma once
+
+
+//
+//	Include files
+//
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <vector>
+
+#include "OtByteCode.h"
+#include "OtException.h"
+
+
+//
+//	Availability
+//
+
+#if defined(__x86_64__) && !defined(_WIN32)
+#define OT_JIT_SUPPORTED 1
+#else
+#define OT_JIT_SUPPORTED 0
+#endif
+
+
+//
+//	Forward declarations
+//
+
+class OtVM;
+class OtTryCatch;
+
+
+//
+//	OtJitContext
+//
+//	The state native code shares with the interpreter. Frames keep pointing
+//	to the interpreter's current instruction, which native code updates
+//	before every operation that can fail or call out, so exceptions, the
+//	debugger and the profiler see the same program counter.
+//
+
+struct OtJitContext {
+	OtVM* vm;
+	std::atomic<uint32_t>* hooks;
+	OtByteCodeClass::Instruction** instruction;
+	std::vector<OtTryCatch>* tryCatch;
+
+	// byte offset of the frame's first slot on the stack
+	size_t frame;
+
+	// the exception raised by native code (the pointer is only used for exceptions of other types)
+	OtException error;
+	std::exception_ptr exception;
+};
+
+
+//
+//	OtJitCode
+//
+
+class OtJitCode {
+public:
+	// constructor/destructor
+	OtJitCode(const std::vector<uint8_t>& code, std::vector<size_t>&& offsets);
+	~OtJitCode();
+
+	// see if code was allocated successfully
+	inline bool isValid() { return memory != nullptr; }
+
+	// run from the specified instruction (returns false if an exception was raised, which is then in the context)
+	bool run(OtJitContext& context, size_t instruction);
+
+private:
+	void* memory = nullptr;
+	size_t size = 0;
+	std::vector<size_t> offsets;
+};
+
+
+//
+//	OtJit
+//
+//	Baseline just-in-time compiler for x86-64. Functions are compiled once
+//	their calls and loop iterations reach a threshold. The compiler stitches
+//	together code templates. Jumps (including loop back-edges), exits, the
+//	statement hook check, pops and pushes and assignments of frame slots and
+//	constants are native code. So are integer and real additions,
+//	subtractions, multiplications and comparisons (a comparison followed by
+//	a conditional jump becomes a native compare and branch). Native code
+//	guards the types it expects and falls back to a helper that implements
+//	the opcode like the interpreter does when a guard fails or when the stack
+//	must grow. Results that need a new object are created by a helper.
+//
+//	Other instructions are calls to helpers. Operand pushes, a binary
+//	operator and a conditional jump that follow each other are handled by a
+//	single helper that doesn't touch the stack for primitive operands (as
+//	are method calls whose result is discarded).
+//
+//	Helpers never let exceptions escape into native code. They store them in
+//	the context and return a status, so the interpreter can handle them
+//	exactly like its own. Functions with instructions the compiler can't
+//	handle (or on platforms without support) simply stay in the interpreter.
+//
+
+class OtJit {
+public:
+	// see if the just-in-time compiler is available on this platform
+	static constexpr bool isSupported() { return OT_JIT_SUPPORTED; }
+
+	// count a call or a loop iteration and get native code once the function is hot (returns nullptr otherwise)
+	static OtJitCode* getCode(OtByteCodeClass* bytecode);
+
+	// see if the compiler can handle an opcode
+	static bool isSupportedOpcode(OtByteCodeClass::Opcode opcode);
+
+private:
+	// opcode implementations called by native code
+	class Helpers;
+
+	// where native code finds the interpreter's data
+	struct Layout;
+	static const Layout& getLayout();
+
+	// compile bytecode to native code (returns nullptr if that's not possible)
+	static std::shared_ptr<OtJitCode> compile(OtByteCodeClass* bytecode);
+};
@@ -0,0 +1,214 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+//
+//	Include files
+//
+
+#include <cctype>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "OtJit.h"
+#include "OtJitCompare.h"
+#include "OtLibuv.h"
+#include "OtLog.h"
+#include "OtPath.h"
+
+
+//
+//	Run a script in a child process and capture its output
+//
+
+struct OtScriptRun {
+	std::string stdoutText;
+	std::string stderrText;
+	int64_t status = 0;
+	int signal = 0;
+};
+
+static OtScriptRun runScript(const std::string& file, const std::vector<std::string>& options) {
+	OtScriptRun run;
+	uv_loop_t loop;
+	UV_CHECK_ERROR("uv_loop_init", uv_loop_init(&loop));
+
+	uv_pipe_t stdoutPipe;
+	uv_pipe_t stderrPipe;
+	uv_pipe_init(&loop, &stdoutPipe, 0);
+	uv_pipe_init(&loop, &stderrPipe, 0);
+	stdoutPipe.data = &run.stdoutText;
+	stderrPipe.data = &run.stderrText;
+
+	uv_stdio_container_t stdio[3];
+	stdio[0].flags = UV_IGNORE;
+	stdio[1].flags = static_cast<uv_stdio_flags>(UV_CREATE_PIPE | UV_WRITABLE_PIPE);
+	stdio[1].data.stream = reinterpret_cast<uv_stream_t*>(&stdoutPipe);
+	stdio[2].flags = static_cast<uv_stdio_flags>(UV_CREATE_PIPE | UV_WRITABLE_PIPE);
+	stdio[2].data.stream = reinterpret_cast<uv_stream_t*>(&stderrPipe);
+
+	// the child is this executable running the script with the requested options
+	auto executable = OtPath::getExecutable();
+	std::vector<char*> arguments{executable.data()};
+
+	for (auto& option : options) {
+		arguments.emplace_back(const_cast<char*>(option.c_str()));
+	}
+
+	arguments.emplace_back(const_cast<char*>(file.c_str()));
+	arguments.emplace_back(nullptr);
+
+	uv_process_t process;
+	process.data = &run;
+
+	uv_process_options_t processOptions{};
+	processOptions.file = executable.c_str();
+	processOptions.args = arguments.data();
+	processOptions.stdio_count = 3;
+	processOptions.stdio = stdio;
+	processOptions.flags = UV_PROCESS_WINDOWS_HIDE_CONSOLE;
+
+	processOptions.exit_cb = [](uv_process_t* handle, int64_t status, int signal) {
+		auto result = static_cast<OtScriptRun*>(handle->data);
+		result->status = status;
+		result->signal = signal;
+		uv_close(reinterpret_cast<uv_handle_t*>(handle), nullptr);
+	};
+
+	auto status = uv_spawn(&loop, &process, &processOptions);
+	UV_CHECK_ERROR2("uv_spawn", status, executable.c_str());
+
+	auto allocate = []([[maybe_unused]] uv_handle_t* handle, size_t size, uv_buf_t* buffer) {
+		*buffer = uv_buf_init(new char[size], static_cast<unsigned int>(size));
+	};
+
+	auto read = [](uv_stream_t* stream, ssize_t size, const uv_buf_t* buffer) {
+		if (size > 0) {
+			static_cast<std::string*>(stream->data)->append(buffer->base, static_cast<size_t>(size));
+
+		} else if (size < 0) {
+			uv_close(reinterpret_cast<uv_handle_t*>(stream), nullptr);
+		}
+
+		delete [] buffer->base;
+	};
+
+	uv_read_start(reinterpret_cast<uv_stream_t*>(&stdoutPipe), allocate, read);
+	uv_read_start(reinterpret_cast<uv_stream_t*>(&stderrPipe), allocate, read);
+
+	uv_run(&loop, UV_RUN_DEFAULT);
+	uv_loop_close(&loop);
+	return run;
+}
+
+
+//
+//	Remove the timestamps from log output (as they always differ between runs)
+//
+
+static std::string removeTimestamps(const std::string& text) {
+	std::istringstream stream(text);
+	std::string result;
+	std::string line;
+
+	while (std::getline(stream, line)) {
+		auto end = line.find(" [");
+
+		if (line.size() && std::isdigit(static_cast<unsigned char>(line[0])) && end != std::string::npos) {
+			line = line.substr(end + 1);
+		}
+
+		result += line + "\n";
+	}
+
+	return result;
+}
+
+
+//
+//	Compare the output of two runs (returns true if they are the same)
+//
+
+static bool compareOutput(const std::string& name, const std::string& interpreter, const std::string& jit) {
+	if (interpreter == jit) {
+		return true;
+	}
+
+	// report the first line that is different
+	std::istringstream interpreterStream(interpreter);
+	std::istringstream jitStream(jit);
+	std::string interpreterLine;
+	std::string jitLine;
+	size_t line = 1;
+
+	while (true) {
+		bool interpreterMore = static_cast<bool>(std::getline(interpreterStream, interpreterLine));
+		bool jitMore = static_cast<bool>(std::getline(jitStream, jitLine));
+
+		if (!interpreterMore) {
+			interpreterLine = "<end of output>";
+		}
+
+		if (!jitMore) {
+			jitLine = "<end of output>";
+		}
+
+		if (interpreterLine != jitLine || !interpreterMore || !jitMore) {
+			break;
+		}
+
+		line++;
+	}
+
+	std::cerr << "The " << name << " is different on line " << line << ":\n";
+	std::cerr << "  interpreter: " << interpreterLine << "\n";
+	std::cerr << "  jit:         " << jitLine << "\n";
+	return false;
+}
+
+
+//
+//	OtJitCompare::run
+//
+
+int OtJitCompare::run(const std::string& file, bool noCache) {
+	if (!OtJit::isSupported()) {
+		OtLogFatal("Error: the just-in-time compiler is not available on this platform");
+	}
+
+	// compile everything right away so all native code paths are exercised
+	std::vector<std::string> options;
+
+	if (noCache) {
+		options.emplace_back("--no-cache");
+	}
+
+	auto interpreter = runScript(file, options);
+	options.insert(options.end(), {"--jit", "--jit-threshold", "0"});
+	auto jit = runScript(file, options);
+
+	bool same = compareOutput("output", interpreter.stdoutText, jit.stdoutText);
+	same = compareOutput("error output", removeTimestamps(interpreter.stderrText), removeTimestamps(jit.stderrText)) && same;
+
+	if (interpreter.status != jit.status || interpreter.signal != jit.signal) {
+		std::cerr << "The exit status is different (interpreter: " << interpreter.status << ", jit: " << jit.status << ")\n";
+
+		if (interpreter.signal != jit.signal) {
+			std::cerr << "The terminating signal is different (interpreter: " << interpreter.signal << ", jit: " << jit.signal << ")\n";
+		}
+
+		same = false;
+	}
+
+	if (same) {
+		std::cout << "The interpreter and the just-in-time compiler produced the same results\n";
+	}
+
+	return same ? 0 : 1;
+}
@@ -0,0 +1,31 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+#pragma once
+
+
+//
+//	Include files
+//
+
+#include <string>
+
+
+//
+//	OtJitCompare
+//
+//	Differential test mode that runs a script with the interpreter and with
+//	the just-in-time compiler and compares the output, the error output and
+//	the exit status. Each engine runs in its own process so scripts start
+//	from the same state and can't affect each other.
+//
+
+class OtJitCompare {
+public:
+	// run the script with both engines (returns the exit code for the command line)
+	static int run(const std::string& file, bool noCache);
+};
@@ -17,7 +17,7 @@
 //
 
 OtType OtMemberReferenceClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtMemberReferenceClass>("MemberReference", OtReferenceClass::getMeta());
@@ -17,6 +17,7 @@
 #include "OtFunction.h"
 #include "OtGlobal.h"
 #include "OtIdentifier.h"
+#include "OtMethodCache.h"
 #include "OtModule.h"
 #include "OtReference.h"
 
@@ -39,9 +40,15 @@ public:
 
 	// resolve member reference and deal with bound functions if required
 	static inline OtObject resolveMember(OtObject& object, OtID member) {
-		// get the member
-		auto memberObject = object->get(member);
+		return bindMember(object, object->get(member));
+	}
+
+	static inline OtObject resolveMember(OtObject& object, OtID member, OtMethodCache& cache) {
+		return bindMember(object, cache.lookup(object, member));
+	}
 
+	// create bound function for member (if required)
+	static inline OtObject bindMember(OtObject& object, OtObject memberObject) {
 		// never create bound functions for Modules or Globals
 		if (object.isKindOf<OtModuleClass>() || object.isKindOf<OtGlobalClass>()) {
 			return memberObject;
@@ -60,6 +67,10 @@ public:
 	OtObject& getObject() { return object; }
 	OtID getMember() { return member; }
 
+	// cycle collector support
+	inline void traverse(OtObjectTraverser& traverser) override { OtReferenceClass::traverse(traverser); traverser(object); }
+	inline void clearReferences() override { OtReferenceClass::clearReferences(); object = nullptr; }
+
 	// get type definition
 	static OtType getMeta();
 
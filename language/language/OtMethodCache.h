@@ -0,0 +1,120 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+#pragma once
+
+
+//
+//	Include files
+//
+
+#include <cstddef>
+#include <cstdint>
+
+#include "OtObject.h"
+#include "OtType.h"
+
+
+//
+//	OtMethodCache
+//
+//	Polymorphic inline cache for a single call site in the bytecode. Each entry
+//	maps a receiver type to the member that a full lookup found for that type.
+//	Instance members always take precedence so they are checked first and all
+//	entries are dropped as soon as any type changes its members. Instance
+//	members themselves are cached by shape (which maps straight to a slot).
+//
+
+class OtMethodCache {
+public:
+	// find a member on an object (using the cache when possible)
+	inline OtObject lookup(OtObject& object, OtID id) {
+		// clear cache if type members changed since we last looked
+		auto currentVersion = OtTypeClass::getMemberVersion();
+
+		if (version != currentVersion) {
+			used = 0;
+			next = 0;
+			version = currentVersion;
+		}
+
+		// instance members shadow type members (they are found through the object's shape)
+		auto shape = object->getShape();
+
+		if (shape) {
+			if (shape == instanceShape) {
+				hits++;
+				return object->getSlot(instanceSlot);
+			}
+
+			if (object->hasInstanceMember(id)) {
+				misses++;
+				auto slot = shape->find(id);
+
+				if (slot != OtShape::notFound && object->isMemberCacheable(id)) {
+					instanceShape = shape;
+					instanceSlot = slot;
+				}
+
+				return object->get(id);
+			}
+		}
+
+		// find type member
+		auto type = object->getType().raw();
+
+		for (size_t i = 0; i < used; i++) {
+			if (entries[i].type == type) {
+				hits++;
+				return entries[i].member;
+			}
+		}
+
+		// do a full lookup and remember the result (if we can)
+		misses++;
+		auto member = object->get(id);
+
+		if (object->isMemberCacheable(id)) {
+			auto& entry = entries[next];
+			entry.type = type;
+			entry.member = member;
+			next = (next + 1) % size;
+
+			if (used < size) {
+				used++;
+			}
+		}
+
+		return member;
+	}
+
+	// access statistics (per thread)
+	static inline size_t getHits() { return hits; }
+	static inline size_t getMisses() { return misses; }
+	static inline void resetStatistics() { hits = 0; misses = 0; }
+
+private:
+	// cache entries
+	static constexpr size_t size = 4;
+
+	struct Entry {
+		OtTypeClass* type = nullptr;
+		OtObject member;
+	};
+
+	Entry entries[size];
+	size_t used = 0;
+	size_t next = 0;
+	uint64_t version = 0;
+
+	OtShape* instanceShape = nullptr;
+	size_t instanceSlot = 0;
+
+	// statistics
+	static inline thread_local size_t hits = 0;
+	static inline thread_local size_t misses = 0;
+};
@@ -9,7 +9,11 @@
 //	Include files
 //
 
+#include <mutex>
+#include <vector>
+
 #include "OtByteCode.h"
+#include "OtByteCodeCache.h"
 #include "OtCompiler.h"
 #include "OtLog.h"
 #include "OtModule.h"
@@ -26,24 +30,35 @@
 //
 //	OtModuleRegistry
 //
+//	The creators of "internal" modules are registered during static
+//	initialization and are shared by all threads.
+//
 
-struct OtModuleRegistryEntry {
-	std::function<void(OtModule)> creator;
-	OtModule module;
-};
-
-class OtModuleRegistry : public OtSingleton<OtModuleRegistry>, public OtRegistry<OtModuleRegistryEntry> {
+class OtModuleRegistry : public OtSingleton<OtModuleRegistry>, public OtRegistry<std::function<void(OtModule)>> {
 };
 
 
 //
 //	OtModuleCache
 //
+//	Modules are script objects so every thread has its own cache. "Internal"
+//	modules are stored by name and "external" modules by absolute path.
+//
 
-class OtModuleCache : public OtSingleton<OtModuleCache>, public OtRegistry<OtModule> {
+class OtModuleCache : public OtPerThreadSingleton<OtModuleCache>, public OtRegistry<OtModule> {
 };
 
 
+//
+//	Module search path (shared by all threads)
+//
+
+static std::mutex& getModulePathMutex() {
+	static std::mutex mutex;
+	return mutex;
+}
+
+
 //
 //	OtModuleClass::load
 //
@@ -85,7 +100,14 @@ void OtModuleClass::load(const std::string& path, const std::string& code) {
 	localPath.push_back(OtPath::getParent(path));
 
 	try {
-		auto bytecode = compiler.compileSource(source, OtModule(this));
+		// use previously compiled code (if possible)
+		auto bytecode = OtByteCodeCache::load(source, OtModule(this));
+
+		if (!bytecode) {
+			bytecode = compiler.compileSource(source, OtModule(this));
+			OtByteCodeCache::save(bytecode, OtModule(this));
+		}
+
 		OtVM::execute(bytecode);
 
 	} catch (const OtException& e) {
@@ -143,17 +165,25 @@ std::string OtModuleClass::checkPath(const std::string& path) {
 //
 
 std::string OtModuleClass::getFullPath(const std::string& path) {
-	// build module path (if required)
-	if (modulePath.size() == 0) {
-		buildModulePath();
+	// get a copy of the module path (which is built if required)
+	std::vector<std::string> paths;
+
+	{
+		std::lock_guard<std::mutex> lock(getModulePathMutex());
+
+		if (modulePath.size() == 0) {
+			buildModulePath();
+		}
+
+		paths = modulePath;
 	}
 
 	// see if name addresses a module
 	std::string fullName = checkPath(path);
 
 	// find module on paths (if still required)
-	for (size_t i = 0; i < modulePath.size() && fullName.empty(); i++) {
-		fullName = checkPath(OtPath::join(modulePath[i], path));
+	for (size_t i = 0; i < paths.size() && fullName.empty(); i++) {
+		fullName = checkPath(OtPath::join(paths[i], path));
 	}
 
 	// find module in local paths (if still required)
@@ -172,7 +202,7 @@ std::string OtModuleClass::getFullPath(const std::string& path) {
 //
 
 OtType OtModuleClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtModuleClass>("Module", OtInternalClass::getMeta());
@@ -189,18 +219,18 @@ OtType OtModuleClass::getMeta() {
 OtModule OtModuleClass::import(const std::string& name) {
 	// see if this is an "internal" module
 	auto& registry = OtModuleRegistry::instance();
+	auto& cache = OtModuleCache::instance();
 
 	if (registry.has(name)) {
-		OtModuleRegistryEntry& entry = registry.at(name);
-
 		// instantiate the module if required
-		if (!entry.module) {
-			entry.module = OtModule::create();
-			entry.creator(entry.module);
+		if (!cache.has(name)) {
+			OtModule module = OtModule::create();
+			registry.at(name)(module);
+			cache.set(name, module);
 		}
 
 		// return the module
-		return entry.module;
+		return cache.get(name);
 
 	} else {
 		// determine absolute path of module
@@ -212,8 +242,6 @@ OtModule OtModuleClass::import(const std::string& name) {
 		}
 
 		// see if this "external" module is already in the cache
-		auto& cache = OtModuleCache::instance();
-
 		if (cache.has(path)) {
 			return cache.get(path);
 
@@ -234,6 +262,8 @@ OtModule OtModuleClass::import(const std::string& name) {
 
 void OtModuleClass::addPath(const std::string& path) {
 	// build module path (if required)
+	std::lock_guard<std::mutex> lock(getModulePathMutex());
+
 	if (modulePath.size() == 0) {
 		buildModulePath();
 	}
@@ -248,12 +278,7 @@ void OtModuleClass::addPath(const std::string& path) {
 //
 
 void OtModuleClass::clear() {
-	// clear the "internal" module cache
-	OtModuleRegistry::instance().iterateValues([](OtModuleRegistryEntry& entry) {
-		entry.module = nullptr;
-	});
-
-	// clear the "external" module cache
+	// clear this thread's module cache
 	OtModuleCache::instance().clear();
 }
 
@@ -263,7 +288,5 @@ void OtModuleClass::clear() {
 //
 
 OtModuleRegistration::OtModuleRegistration(const char* name, std::function<void(OtModule)> creator) {
-	OtModuleRegistryEntry entry;
-	entry.creator = creator;
-	OtModuleRegistry::instance().set(name, entry);
+	OtModuleRegistry::instance().set(name, creator);
 }
@@ -41,26 +41,29 @@ public:
 	// add a path to search for modules
 	static void addPath(const std::string& path);
 
+	// determine full path name for module (returns an empty string if it can't be found)
+	static std::string getFullPath(const std::string& path);
+
 protected:
 	// constructor
 	OtModuleClass() = default;
 	friend class OtObjectPointer<OtModuleClass>;
 
 private:
-	// clear the internal cache
+	// clear the module cache (of the calling thread)
 	friend class OtFramework;
+	friend class OtWorkerClass;
 	static void clear();
 
 	// list of directories to search for modules in
 	static void buildModulePath();
 
-	// determine full path name for module
+	// see if a path refers to a module
 	static std::string checkPath(const std::string& path);
-	static std::string getFullPath(const std::string& path);
 
-	// module search path
+	// module search path (the local path tracks the modules being loaded by this thread)
 	inline static std::vector<std::string> modulePath;
-	inline static std::vector<std::string> localPath;
+	inline static thread_local std::vector<std::string> localPath;
 };
 
 
@@ -11,9 +11,15 @@
 
 #include <unordered_map>
 
+#include "OtBoolean.h"
+#include "OtException.h"
+#include "OtFunction.h"
+#include "OtGlobal.h"
+#include "OtIdentifier.h"
+#include "OtInteger.h"
 #include "OtMemberReference.h"
 #include "OtOptimizer.h"
-#include "OtIdentifier.h"
+#include "OtReal.h"
 #include "OtStackReference.h"
 
 
@@ -22,6 +28,25 @@
 //
 
 OtByteCode OtOptimizer::optimize(OtByteCode bytecode) {
+	// fold constant expressions (folded results can often be folded again)
+	do {
+		changes = 0;
+		bytecode = rewrite(bytecode, &OtOptimizer::foldConstantsPass);
+	} while (changes);
+
+	// remove branches that are never taken and code that is never reached
+	bytecode = rewrite(bytecode, &OtOptimizer::removeDeadCodePass, &OtOptimizer::findReachableCode);
+
+	// replace opcode sequences with optimized opcodes
+	return rewrite(bytecode, &OtOptimizer::optimizeSequencesPass);
+}
+
+
+//
+//	OtOptimizer::rewrite
+//
+
+OtByteCode OtOptimizer::rewrite(OtByteCode bytecode, Pass pass, Analysis analysis) {
 	// remember the old bytecode and create a new one
 	oldByteCode = bytecode;
 	newByteCode = OtByteCode::create(bytecode->getSource(), bytecode->getID());
@@ -36,27 +61,36 @@ OtByteCode OtOptimizer::optimize(OtByteCode bytecode) {
 		pc += bytecode->getOpcodeSize(pc);
 	}
 
-	// process all opcodes and see if we have a sequence that can be optimized
+	// find all jump targets (sequences that are jumped into can't be replaced)
+	for (auto offset : bytecode->getJumps()) {
+		jumpTargets.insert(offset);
+	}
+
+	// analyze the bytecode (if required)
+	if (analysis) {
+		(this->*analysis)();
+	}
+
+	// process all opcodes
 	size_t opcode = 0;
 	end = opcodes.size();
 
 	std::unordered_map<size_t, size_t> opcodeMapping;
 
 	while (opcode < end) {
-		// update jump mapping
-		opcodeMapping[opcodes[opcode]] = newByteCode->size();
-
-		// try all optimization sequences (in the right order)
-		bool optimized = false;
-		if (!optimized) { optimized = optimizePushStackMemberReferenceSequence(opcode, end - opcode); }
-		if (!optimized) { optimized = optimizePushStackReferenceSequence(opcode, end - opcode); }
-		if (!optimized) { optimized = optimizePushMemberReferenceSequence(opcode, end - opcode); }
-		if (!optimized) { optimized = optimizePushMemberSequence(opcode, end - opcode); }
-		if (!optimized) { optimized = optimizePushStackSwapAssignSequence(opcode, end - opcode); }
-		if (!optimized) { optimized = optimizePushMemberSwapAssignSequence(opcode, end - opcode); }
-		if (!optimized) { newByteCode->copyOpcode(oldByteCode, opcodes[opcode++]); }
+		// let the pass handle the next opcode(s)
+		auto first = opcode;
+		auto position = newByteCode->size();
+		(this->*pass)(opcode, end - opcode);
+
+		// map all processed opcodes to the start of their replacement
+		for (auto i = first; i < opcode; i++) {
+			opcodeMapping[opcodes[i]] = position;
+		}
 	}
 
+	opcodeMapping[oldByteCode->size()] = newByteCode->size();
+
 	// fix all the jumps
 	for (auto& offset : newByteCode->getJumps()) {
 		offset = opcodeMapping[offset];
@@ -76,19 +110,317 @@ OtByteCode OtOptimizer::optimize(OtByteCode bytecode) {
 		newByteCode->addSymbol(symbol);
 	}
 
-	// capture optimized bytecode
+	// capture new bytecode
 	auto result = newByteCode;
 
 	// clear our state
 	oldByteCode = nullptr;
 	newByteCode = nullptr;
 	opcodes.clear();
+	jumpTargets.clear();
+	reachable.clear();
+	opcodeIndex.clear();
+	constantBranches.clear();
 
-	// return optimized code
+	// return new code
 	return result;
 }
 
 
+//
+//	OtOptimizer::foldConstantsPass
+//
+
+void OtOptimizer::foldConstantsPass(size_t& opcode, size_t available) {
+	bool folded = false;
+	if (!folded) { folded = foldBinaryOperatorSequence(opcode, available); }
+	if (!folded) { folded = foldUnaryOperatorSequence(opcode, available); }
+	if (!folded) { newByteCode->copyOpcode(oldByteCode, opcodes[opcode++]); }
+}
+
+
+//
+//	OtOptimizer::removeDeadCodePass
+//
+
+void OtOptimizer::removeDeadCodePass(size_t& opcode, [[maybe_unused]] size_t available) {
+	if (!reachable[opcode]) {
+		// drop code that is never reached
+		opcode++;
+		return;
+	}
+
+	// see if we have an unconditional jump (a branch on a constant is either a jump or nothing at all)
+	size_t length = 1;
+	auto pc = opcodes[opcode];
+	bool jump = oldByteCode->getOpcode(pc) == OtByteCodeClass::Opcode::jump;
+
+	if (constantBranches.count(opcode)) {
+		length = constantBranches[opcode].first;
+		jump = constantBranches[opcode].second;
+	}
+
+	if (jump) {
+		// find target and drop jumps to the next reachable opcode
+		pc = opcodes[opcode + length - 1];
+		oldByteCode->getOpcode(pc);
+		auto target = oldByteCode->getJump(oldByteCode->getNumber(pc));
+		auto next = opcode + length;
+
+		while (next < opcodes.size() && !reachable[next]) {
+			next++;
+		}
+
+		if (opcodeIndex[target] != next) {
+			newByteCode->jump(target);
+		}
+
+		opcode += length;
+
+	} else if (length > 1) {
+		// drop branch that is never taken
+		opcode += length;
+
+	} else {
+		newByteCode->copyOpcode(oldByteCode, opcodes[opcode++]);
+	}
+}
+
+
+//
+//	OtOptimizer::optimizeSequencesPass
+//
+
+void OtOptimizer::optimizeSequencesPass(size_t& opcode, size_t available) {
+	// try all optimization sequences (in the right order)
+	bool optimized = false;
+	if (!optimized) { optimized = optimizePushStackMemberReferenceSequence(opcode, available); }
+	if (!optimized) { optimized = optimizePushStackReferenceSequence(opcode, available); }
+	if (!optimized) { optimized = optimizePushMemberReferenceSequence(opcode, available); }
+	if (!optimized) { optimized = optimizePushMemberSequence(opcode, available); }
+	if (!optimized) { optimized = optimizePushStackSwapAssignSequence(opcode, available); }
+	if (!optimized) { optimized = optimizePushMemberSwapAssignSequence(opcode, available); }
+	if (!optimized) { optimized = optimizeBinaryOperatorSequence(opcode, available); }
+	if (!optimized) { newByteCode->copyOpcode(oldByteCode, opcodes[opcode++]); }
+}
+
+
+//
+//	OtOptimizer::foldBinaryOperatorSequence
+//
+
+bool OtOptimizer::foldBinaryOperatorSequence(size_t& opcode, size_t available) {
+	OtObject operands[2];
+	size_t length1;
+	size_t length2;
+	OtID method;
+	size_t count;
+
+	if (isConstant(opcode, available, operands[0], length1) &&
+		available > length1 &&
+		!isJumpTarget(opcode + length1) &&
+		isConstant(opcode + length1, available - length1, operands[1], length2) &&
+		available > length1 + length2 &&
+		!isJumpTarget(opcode + length1 + length2) &&
+		oldByteCode->isMethod(opcodes[opcode + length1 + length2], method, count) &&
+		count == 1 &&
+		binaryOperators.count(method)) {
+
+		auto result = evaluate(method, 2, operands);
+
+		if (result) {
+			newByteCode->push(result);
+			opcode += length1 + length2 + 1;
+			changes++;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+//
+//	OtOptimizer::foldUnaryOperatorSequence
+//
+
+bool OtOptimizer::foldUnaryOperatorSequence(size_t& opcode, size_t available) {
+	OtObject operand;
+	size_t length;
+	OtID method;
+	size_t count;
+
+	if (isConstant(opcode, available, operand, length) &&
+		available > length &&
+		!isJumpTarget(opcode + length) &&
+		oldByteCode->isMethod(opcodes[opcode + length], method, count) &&
+		count == 0 &&
+		unaryOperators.count(method)) {
+
+		auto result = evaluate(method, 1, &operand);
+
+		if (result) {
+			newByteCode->push(result);
+			opcode += length + 1;
+			changes++;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+//
+//	OtOptimizer::isConstant
+//
+
+bool OtOptimizer::isConstant(size_t opcode, size_t available, OtObject& value, size_t& length) {
+	OtObject object;
+	OtMemberReference reference;
+
+	// literals
+	if (available >= 1 &&
+		oldByteCode->isPush(opcodes[opcode], object) &&
+		(object.isKindOf<OtIntegerClass>() || object.isKindOf<OtRealClass>() || object.isKindOf<OtBooleanClass>())) {
+
+		value = object;
+		length = 1;
+		return true;
+	}
+
+	// the global true and false are treated like literals
+	if (available >= 2 &&
+		oldByteCode->isPushMemberReference(opcodes[opcode], reference) &&
+		oldByteCode->isMethodDeref(opcodes[opcode + 1]) &&
+		!isJumpTarget(opcode + 1) &&
+		reference->getObject().isKindOf<OtGlobalClass>() &&
+		(reference->getMember() == trueID || reference->getMember() == falseID)) {
+
+		value = OtBooleanClass::getShared(reference->getMember() == trueID);
+		length = 2;
+		return true;
+	}
+
+	return false;
+}
+
+
+//
+//	OtOptimizer::evaluate
+//
+
+OtObject OtOptimizer::evaluate(OtID method, size_t count, OtObject* operands) {
+	// only fold operators that are implemented natively (scripts can replace them with anything)
+	auto& object = operands[0];
+	auto type = object->getType();
+
+	if (object->hasMembers() || !type->has(method) || !type->get(method).isKindOf<OtFunctionClass>()) {
+		return nullptr;
+	}
+
+	// a division by zero must be reported when the code runs
+	if (count == 2 && (method == divideID || method == moduloID)) {
+		if (object.isKindOf<OtIntegerClass>() && operands[1]->operator int64_t() == 0) {
+			return nullptr;
+
+		} else if (object.isKindOf<OtRealClass>() && operands[1]->operator double() == 0.0) {
+			return nullptr;
+		}
+	}
+
+	// evaluate the operator (errors are also left for the runtime)
+	try {
+		return type->get(method)->operator()(count, operands);
+
+	} catch (const OtException&) {
+		return nullptr;
+	}
+}
+
+
+//
+//	OtOptimizer::findReachableCode
+//
+
+void OtOptimizer::findReachableCode() {
+	// map bytecode offsets to opcode indices
+	for (size_t i = 0; i < opcodes.size(); i++) {
+		opcodeIndex[opcodes[i]] = i;
+	}
+
+	opcodeIndex[oldByteCode->size()] = opcodes.size();
+
+	// follow all possible paths through the code
+	reachable.assign(opcodes.size(), false);
+	std::vector<size_t> todo{0};
+
+	while (todo.size()) {
+		auto opcode = todo.back();
+		todo.pop_back();
+
+		if (opcode >= opcodes.size() || reachable[opcode]) {
+			continue;
+		}
+
+		// see if we have a branch on a constant (the branch itself can't be a jump target)
+		OtObject value;
+		size_t length;
+
+		if (isConstant(opcode, opcodes.size() - opcode, value, length) &&
+			opcode + length < opcodes.size() &&
+			!isJumpTarget(opcode + length)) {
+
+			auto pc = opcodes[opcode + length];
+			auto branch = oldByteCode->getOpcode(pc);
+
+			if (branch == OtByteCodeClass::Opcode::jumpTrue || branch == OtByteCodeClass::Opcode::jumpFalse) {
+				auto target = oldByteCode->getJump(oldByteCode->getNumber(pc));
+				bool taken = value->operator bool() == (branch == OtByteCodeClass::Opcode::jumpTrue);
+				constantBranches[opcode] = std::make_pair(length + 1, taken);
+
+				for (size_t i = 0; i <= length; i++) {
+					reachable[opcode + i] = true;
+				}
+
+				todo.push_back(taken ? opcodeIndex[target] : opcode + length + 1);
+				continue;
+			}
+		}
+
+		// follow the normal flow
+		reachable[opcode] = true;
+		auto pc = opcodes[opcode];
+
+		switch (oldByteCode->getOpcode(pc)) {
+			case OtByteCodeClass::Opcode::jump:
+				todo.push_back(opcodeIndex[oldByteCode->getJump(oldByteCode->getNumber(pc))]);
+				break;
+
+			case OtByteCodeClass::Opcode::jumpTrue:
+			case OtByteCodeClass::Opcode::jumpFalse:
+			case OtByteCodeClass::Opcode::pushTry:
+				todo.push_back(opcodeIndex[oldByteCode->getJump(oldByteCode->getNumber(pc))]);
+				todo.push_back(opcode + 1);
+				break;
+
+			case OtByteCodeClass::Opcode::iterate:
+				oldByteCode->getNumber(pc);
+				todo.push_back(opcodeIndex[oldByteCode->getJump(oldByteCode->getNumber(pc))]);
+				todo.push_back(opcode + 1);
+				break;
+
+			case OtByteCodeClass::Opcode::exit:
+				break;
+
+			default:
+				todo.push_back(opcode + 1);
+				break;
+		}
+	}
+}
+
+
 //
 //	OtOptimizer::optimizePushStackMemberReferenceSequence
 //
@@ -220,3 +552,23 @@ bool OtOptimizer::optimizePushMemberSwapAssignSequence(size_t& opcode, size_t av
 		return false;
 	}
 }
+
+
+//
+//	OtOptimizer::optimizeBinaryOperatorSequence
+//
+
+bool OtOptimizer::optimizeBinaryOperatorSequence(size_t& opcode, size_t available) {
+	OtByteCodeClass::Opcode binaryOperator;
+
+	if (available >= 1 &&
+		oldByteCode->isBinaryOperator(opcodes[opcode], binaryOperator)) {
+
+		newByteCode->binaryOperator(binaryOperator);
+		opcode += 1;
+		return true;
+
+	} else {
+		return false;
+	}
+}
@@ -13,9 +13,13 @@
 //
 
 #include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "OtByteCode.h"
+#include "OtIdentifier.h"
 
 
 //
@@ -28,6 +32,25 @@ public:
 	OtByteCode optimize(OtByteCode bytecode);
 
 private:
+	// run a single pass over the bytecode and return a new version
+	using Pass = void (OtOptimizer::*)(size_t& opcode, size_t available);
+	using Analysis = void (OtOptimizer::*)();
+	OtByteCode rewrite(OtByteCode bytecode, Pass pass, Analysis analysis=nullptr);
+
+	// the passes
+	void foldConstantsPass(size_t& opcode, size_t available);
+	void removeDeadCodePass(size_t& opcode, size_t available);
+	void optimizeSequencesPass(size_t& opcode, size_t available);
+
+	// constant folding
+	bool foldBinaryOperatorSequence(size_t& opcode, size_t available);
+	bool foldUnaryOperatorSequence(size_t& opcode, size_t available);
+	bool isConstant(size_t opcode, size_t available, OtObject& value, size_t& length);
+	OtObject evaluate(OtID method, size_t count, OtObject* operands);
+
+	// dead code removal
+	void findReachableCode();
+
 	// optimize sequences of opcodes
 	bool optimizePushStackMemberReferenceSequence(size_t& opcode, size_t available);
 	bool optimizePushStackReferenceSequence(size_t& opcode, size_t available);
@@ -35,6 +58,10 @@ private:
 	bool optimizePushMemberSequence(size_t& opcode, size_t available);
 	bool optimizePushStackSwapAssignSequence(size_t& opcode, size_t available);
 	bool optimizePushMemberSwapAssignSequence(size_t& opcode, size_t available);
+	bool optimizeBinaryOperatorSequence(size_t& opcode, size_t available);
+
+	// see if an opcode is the target of a jump
+	inline bool isJumpTarget(size_t opcode) { return jumpTargets.count(opcodes[opcode]) != 0; }
 
 	// old and new bytecodes
 	OtByteCode oldByteCode;
@@ -42,4 +69,49 @@ private:
 
 	// start of each opcode
 	std::vector<size_t> opcodes;
+
+	// bytecode offsets that are jumped to
+	std::unordered_set<size_t> jumpTargets;
+
+	// number of changes made by the current pass
+	size_t changes = 0;
+
+	// results of the reachability analysis (constant branches are indexed by the opcode that starts them)
+	std::vector<bool> reachable;
+	std::unordered_map<size_t, size_t> opcodeIndex;
+	std::unordered_map<size_t, std::pair<size_t, bool>> constantBranches;
+
+	// operators that are side effect free on primitives
+	std::unordered_set<OtID> unaryOperators{
+		OtIdentifier::create("__neg__"),
+		OtIdentifier::create("__plus__"),
+		OtIdentifier::create("__not__"),
+		OtIdentifier::create("__bnot__")
+	};
+
+	std::unordered_set<OtID> binaryOperators{
+		OtIdentifier::create("__add__"),
+		OtIdentifier::create("__sub__"),
+		OtIdentifier::create("__mul__"),
+		OtIdentifier::create("__div__"),
+		OtIdentifier::create("__mod__"),
+		OtIdentifier::create("__eq__"),
+		OtIdentifier::create("__ne__"),
+		OtIdentifier::create("__lt__"),
+		OtIdentifier::create("__le__"),
+		OtIdentifier::create("__gt__"),
+		OtIdentifier::create("__ge__"),
+		OtIdentifier::create("__lshift__"),
+		OtIdentifier::create("__rshift__"),
+		OtIdentifier::create("__band__"),
+		OtIdentifier::create("__bor__"),
+		OtIdentifier::create("__bxor__"),
+		OtIdentifier::create("__and__"),
+		OtIdentifier::create("__or__")
+	};
+
+	OtID divideID = OtIdentifier::create("__div__");
+	OtID moduloID = OtIdentifier::create("__mod__");
+	OtID trueID = OtIdentifier::create("true");
+	OtID falseID = OtIdentifier::create("false");
 };
@@ -0,0 +1,353 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+//
+//	Include files
+//
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "fmt/format.h"
+
+#include "OtIdentifier.h"
+#include "OtLog.h"
+#include "OtPath.h"
+#include "OtProfiler.h"
+#include "OtStack.h"
+
+
+//
+//	Profile state (shared by all threads)
+//
+//	The state is never freed as virtual machines can end (and flush their
+//	samples) during static destruction.
+//
+
+struct OtProfilerCounts {
+	uint64_t self = 0;
+	uint64_t total = 0;
+};
+
+struct OtProfilerState {
+	// sampler thread
+	std::mutex mutex;
+	std::condition_variable changed;
+	std::thread thread;
+	bool running = false;
+	std::chrono::microseconds interval{1000};
+
+	// registered virtual machines
+	std::vector<std::atomic<uint32_t>*> threads;
+
+	// the profile
+	uint64_t samples = 0;
+	std::map<std::string, uint64_t> stacks;
+	std::unordered_map<std::string, OtProfilerCounts> functions;
+	std::unordered_map<std::string, OtProfilerCounts> lines;
+};
+
+static OtProfilerState& getState() {
+	static OtProfilerState* state = new OtProfilerState;
+	return *state;
+}
+
+
+//
+//	Samples of a single thread
+//
+
+struct OtProfilerFrame {
+	OtByteCodeClass* bytecode;
+	size_t pc;
+
+	bool operator<(const OtProfilerFrame& other) const {
+		return std::tie(bytecode, pc) < std::tie(other.bytecode, other.pc);
+	}
+};
+
+struct OtProfilerSamples {
+	std::map<std::vector<OtProfilerFrame>, uint64_t> stacks;
+
+	// keep the bytecode alive until the samples are flushed
+	std::unordered_set<OtByteCodeClass*> seen;
+	std::vector<OtByteCode> bytecodes;
+};
+
+static thread_local OtProfilerSamples* threadSamples = nullptr;
+
+
+//
+//	OtProfiler::start
+//
+
+void OtProfiler::start(int64_t interval) {
+	auto& state = getState();
+	std::lock_guard<std::mutex> lock(state.mutex);
+
+	if (!state.running) {
+		state.running = true;
+		state.interval = std::chrono::microseconds(std::max(interval, int64_t(100)));
+
+		state.thread = std::thread([]() {
+			auto& state = getState();
+			std::unique_lock<std::mutex> lock(state.mutex);
+
+			while (state.running) {
+				state.changed.wait_for(lock, state.interval);
+
+				for (auto hooks : state.threads) {
+					hooks->fetch_or(sampleRequest, std::memory_order_relaxed);
+				}
+			}
+		});
+	}
+}
+
+
+//
+//	OtProfiler::stop
+//
+
+void OtProfiler::stop() {
+	auto& state = getState();
+	std::thread thread;
+
+	{
+		std::lock_guard<std::mutex> lock(state.mutex);
+		state.running = false;
+		thread = std::move(state.thread);
+	}
+
+	state.changed.notify_all();
+
+	if (thread.joinable()) {
+		thread.join();
+	}
+}
+
+
+//
+//	OtProfiler::isRunning
+//
+
+bool OtProfiler::isRunning() {
+	auto& state = getState();
+	std::lock_guard<std::mutex> lock(state.mutex);
+	return state.running;
+}
+
+
+//
+//	OtProfiler::writeCollapsed
+//
+
+void OtProfiler::writeCollapsed(std::ostream& stream) {
+	flush();
+
+	auto& state = getState();
+	std::lock_guard<std::mutex> lock(state.mutex);
+
+	for (auto& [stack, count] : state.stacks) {
+		stream << stack << ' ' << count << '\n';
+	}
+}
+
+
+//
+//	OtProfiler::writeSummary
+//
+
+void OtProfiler::writeSummary(std::ostream& stream, size_t rows) {
+	flush();
+
+	auto& state = getState();
+	std::lock_guard<std::mutex> lock(state.mutex);
+	auto milliseconds = static_cast<double>(state.interval.count()) / 1000.0;
+
+	auto writeTable = [&](const char* title, std::unordered_map<std::string, OtProfilerCounts>& counts) {
+		std::vector<std::pair<std::string, OtProfilerCounts>> sorted(counts.begin(), counts.end());
+
+		std::sort(sorted.begin(), sorted.end(), [](auto& a, auto& b) {
+			return a.second.self != b.second.self ? a.second.self > b.second.self : a.second.total > b.second.total;
+		});
+
+		stream << fmt::format("{:>10} {:>7} {:>10} {:>7}  {}\n", "self (ms)", "self%", "total (ms)", "total%", title);
+
+		for (size_t i = 0; i < sorted.size() && i < rows; i++) {
+			auto& [name, count] = sorted[i];
+
+			stream << fmt::format(
+				"{:>10.1f} {:>6.1f}% {:>10.1f} {:>6.1f}%  {}\n",
+				static_cast<double>(count.self) * milliseconds,
+				100.0 * static_cast<double>(count.self) / static_cast<double>(state.samples),
+				static_cast<double>(count.total) * milliseconds,
+				100.0 * static_cast<double>(count.total) / static_cast<double>(state.samples),
+				name);
+		}
+	};
+
+	stream << fmt::format("Profile: {} samples every {:.1f} ms\n\n", state.samples, milliseconds);
+
+	if (state.samples) {
+		writeTable("function", state.functions);
+		stream << '\n';
+		writeTable("line", state.lines);
+	}
+}
+
+
+//
+//	OtProfiler::save
+//
+
+void OtProfiler::save(const std::string& path) {
+	std::ofstream stream(path);
+
+	if (!stream) {
+		OtLogError("Can't write profile to [{}]", path);
+	}
+
+	writeCollapsed(stream);
+}
+
+
+//
+//	OtProfiler::addThread
+//
+
+void OtProfiler::addThread(std::atomic<uint32_t>* hooks) {
+	auto& state = getState();
+	std::lock_guard<std::mutex> lock(state.mutex);
+	state.threads.push_back(hooks);
+}
+
+
+//
+//	OtProfiler::removeThread
+//
+
+void OtProfiler::removeThread(std::atomic<uint32_t>* hooks) {
+	flush();
+
+	auto& state = getState();
+	std::lock_guard<std::mutex> lock(state.mutex);
+	state.threads.erase(std::remove(state.threads.begin(), state.threads.end(), hooks), state.threads.end());
+}
+
+
+//
+//	OtProfiler::sample
+//
+
+void OtProfiler::sample(OtStack& stack) {
+	if (!threadSamples) {
+		threadSamples = new OtProfilerSamples;
+	}
+
+	auto count = stack.getFrameCount();
+	std::vector<OtProfilerFrame> frames;
+	frames.reserve(count);
+
+	for (size_t i = 0; i < count; i++) {
+		auto& frame = stack.getFrame(i);
+		auto bytecode = frame.bytecode.raw();
+		frames.emplace_back(OtProfilerFrame{bytecode, frame.getPC()});
+
+		if (threadSamples->seen.insert(bytecode).second) {
+			threadSamples->bytecodes.emplace_back(frame.bytecode);
+		}
+	}
+
+	threadSamples->stacks[frames]++;
+}
+
+
+//
+//	OtProfiler::flush
+//
+
+void OtProfiler::flush() {
+	if (!threadSamples) {
+		return;
+	}
+
+	// resolve the frames (line numbers are expensive so they are cached)
+	struct Location {
+		std::string function;
+		std::string line;
+	};
+
+	std::map<OtProfilerFrame, Location> locations;
+
+	auto resolve = [&](const OtProfilerFrame& frame) -> Location& {
+		auto entry = locations.find(frame);
+
+		if (entry == locations.end()) {
+			auto bytecode = frame.bytecode;
+			auto name = OtIdentifier::name(bytecode->getID());
+			auto module = OtPath::getFilename(bytecode->getModule());
+			auto function = fmt::format("{} ({})", name, module);
+			auto line = fmt::format("{} ({}:{})", name, module, bytecode->getLineNumber(frame.pc));
+			entry = locations.emplace(frame, Location{function, line}).first;
+		}
+
+		return entry->second;
+	};
+
+	// add the samples to the profile
+	auto& state = getState();
+	std::lock_guard<std::mutex> lock(state.mutex);
+	std::unordered_set<std::string> functions;
+	std::unordered_set<std::string> lines;
+
+	for (auto& [frames, count] : threadSamples->stacks) {
+		std::string stack;
+		functions.clear();
+		lines.clear();
+
+		for (auto& frame : frames) {
+			auto& location = resolve(frame);
+
+			if (stack.size()) {
+				stack += ';';
+			}
+
+			stack += location.line;
+
+			// total time counts every function and line once per sample (so recursion isn't counted twice)
+			if (functions.insert(location.function).second) {
+				state.functions[location.function].total += count;
+			}
+
+			if (lines.insert(location.line).second) {
+				state.lines[location.line].total += count;
+			}
+		}
+
+		if (frames.size()) {
+			auto& leaf = resolve(frames.back());
+			state.functions[leaf.function].self += count;
+			state.lines[leaf.line].self += count;
+		}
+
+		state.stacks[stack] += count;
+		state.samples += count;
+	}
+
+	delete threadSamples;
+	threadSamples = nullptr;
+}
@@ -0,0 +1,77 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+#pragma once
+
+
+//
+//	Include files
+//
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+
+//
+//	Forward declarations
+//
+
+class OtStack;
+
+
+//
+//	OtProfiler
+//
+//	Sampling profiler for scripts. A timer thread periodically asks every
+//	virtual machine for a sample. Virtual machines only look at the request
+//	when they start a new statement (so stacks are never read while they
+//	change and idle time isn't counted). Time spent in native code that
+//	doesn't call back into scripts is therefore undercounted.
+//
+//	Samples are kept per thread as raw frames and are turned into function
+//	names and line numbers when a thread's samples are flushed into the
+//	profile (when its virtual machine ends or when the profile is written).
+//
+
+class OtProfiler {
+public:
+	// the bit a virtual machine's hook flags get when a sample is requested
+	static constexpr uint32_t sampleRequest = 4;
+
+	// start sampling (the interval is in microseconds)
+	static void start(int64_t interval=1000);
+
+	// stop sampling
+	static void stop();
+
+	// see if the profiler is running
+	static bool isRunning();
+
+	// write the profile in collapsed stack format (as used by flame graph tools)
+	static void writeCollapsed(std::ostream& stream);
+
+	// write tables with the self and total time per function and per line
+	static void writeSummary(std::ostream& stream, size_t rows=25);
+
+	// write the profile to a file (in collapsed stack format)
+	static void save(const std::string& path);
+
+private:
+	// virtual machines register the flags the sampler sets
+	friend class OtVM;
+	static void addThread(std::atomic<uint32_t>* hooks);
+	static void removeThread(std::atomic<uint32_t>* hooks);
+
+	// record the calling thread's stack (called by its virtual machine at a safe point)
+	static void sample(OtStack& stack);
+
+	// move the calling thread's samples into the profile
+	static void flush();
+};
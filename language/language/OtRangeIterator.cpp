@@ -18,7 +18,7 @@
 //
 
 OtType OtRangeIteratorClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtRangeIteratorClass>("RangeIterator", OtIteratorClass::getMeta());
@@ -17,7 +17,7 @@
 //
 
 OtType OtReferenceClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtReferenceClass>("Reference", OtInternalClass::getMeta());
@@ -53,6 +53,9 @@ public:
 	// get module
 	std::string getModule() { return module; }
 
+	// get all source code
+	const std::string& getSource() { return source; }
+
 	// create a new instance
 	static OtSource create(const std::string& module, const std::string& source);
 
@@ -0,0 +1,32 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+//
+//	Include files
+//
+
+#include "OtStack.h"
+
+
+//
+//	OtStack::reserve
+//
+
+void OtStack::reserve(size_t newCapacity) {
+	auto newStack = new OtObject[newCapacity];
+
+	if (stack) {
+		for (size_t i = 0; i < capacity; i++) {
+			newStack[i] = stack[i];
+		}
+
+		delete[] stack;
+	}
+
+	stack = newStack;
+	capacity = newCapacity;
+}
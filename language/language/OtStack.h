@@ -13,6 +13,7 @@
 //
 
 #include <algorithm>
+#include <utility>
 #include <vector>
 
 #include "OtByteCode.h"
@@ -27,12 +28,15 @@ class OtStackFrame {
 public:
 	// constructors
 	OtStackFrame() = default;
-	OtStackFrame(OtByteCode b, size_t o, size_t* p) : bytecode(b), offset(o), pc(p) {}
+	OtStackFrame(OtByteCode b, size_t o, OtByteCodeClass::Instruction** i) : bytecode(b), offset(o), instruction(i) {}
+
+	// get the bytecode offset of the frame's current instruction
+	inline size_t getPC() { return (*instruction)->pc; }
 
 	// frame data
 	OtByteCode bytecode;
 	size_t offset;
-	size_t* pc;
+	OtByteCodeClass::Instruction** instruction;
 };
 
 
@@ -65,9 +69,11 @@ public:
 
 	// stack access functions
 	inline void push(const OtObject& object) { if (sp == capacity) { reserve(capacity * 2); } stack[sp++] = object; }
+	inline void push(OtObject&& object) { if (sp == capacity) { reserve(capacity * 2); } stack[sp++] = std::move(object); }
 	inline void push(size_t count, OtObject* objects) { if (sp + count >= capacity) { reserve(capacity * 2); } while (count--) { stack[sp++] = *objects++; } }
-	inline OtObject pop() { auto result = stack[--sp]; stack[sp] = nullptr; return result; }
+	inline OtObject pop() { return std::move(stack[--sp]); }
 	inline void pop(size_t count) { while (count--) { stack[--sp] = nullptr; } }
+	inline void replace(size_t count, OtObject&& object) { pop(count - 1); stack[sp - 1] = std::move(object); }
 	inline void dup() { if (sp == capacity) { reserve(capacity * 2); } stack[sp] = stack[sp - 1]; sp++; }
 	inline void swap() { std::swap(stack[sp - 1], stack[sp - 2]); }
 	inline void move(size_t count) { stack[sp - count - 1] = stack[sp - 1]; sp -= count; }
@@ -77,7 +83,7 @@ public:
 	inline OtObject top() { return stack[sp - 1]; }
 
 	// frame access functions
-	inline void openFrame(OtByteCode bytecode, size_t callingParameters, size_t* pc) { frames.emplace_back(bytecode, sp - callingParameters, pc); }
+	inline void openFrame(OtByteCode bytecode, size_t callingParameters, OtByteCodeClass::Instruction** instruction) { frames.emplace_back(bytecode, sp - callingParameters, instruction); }
 	inline OtObject getFrameItem(size_t slot) { return stack[frames.back().offset + slot]; }
 	inline OtObject getFrameItem(size_t frame, size_t slot) { return stack[frames[frames.size() - frame - 1].offset + slot]; }
 	inline void setFrameItem(size_t slot, OtObject object) { stack[frames.back().offset + slot] = object; }
@@ -118,21 +124,11 @@ public:
 	}
 
 private:
-	// reserve specified capacity on stack
-	inline void reserve(size_t newCapacity) {
-		auto newStack = new OtObject[newCapacity];
-
-		if (stack) {
-			for (size_t i = 0; i < capacity; i++) {
-				newStack[i] = stack[i];
-			}
+	// the just-in-time compiler pushes, pops and assigns directly
+	friend class OtJit;
 
-			delete[] stack;
-		}
-
-		stack = newStack;
-		capacity = newCapacity;
-	}
+	// reserve specified capacity on stack (not inlined as stacks rarely grow)
+	void reserve(size_t newCapacity);
 
 	// release the stack's memory
 	inline void release() {
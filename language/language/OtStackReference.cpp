@@ -39,7 +39,7 @@ OtObject OtStackReferenceClass::assign(OtObject value) {
 //
 
 OtType OtStackReferenceClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtStackReferenceClass>("StackReference", OtReferenceClass::getMeta());
@@ -51,6 +51,9 @@ protected:
 	OtStackReferenceClass(OtID i, size_t s) : id(i), slot(s) {}
 
 private:
+	// native code assigns directly
+	friend class OtJit;
+
 	// data
 	OtID id;
 	size_t slot;
@@ -28,7 +28,7 @@ void OtThrowClass::call(const std::string& error) {
 //
 
 OtType OtThrowClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtThrowClass>("Throw", OtInternalClass::getMeta());
@@ -9,157 +9,606 @@
 //	Include files
 //
 
+#include <exception>
+#include <iterator>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "fmt/format.h"
 
+#include "OtArrayIterator.h"
 #include "OtAssert.h"
+#include "OtBoolean.h"
 #include "OtClass.h"
+#include "OtConfig.h"
 #include "OtException.h"
 #include "OtFunction.h"
 #include "OtLog.h"
 #include "OtMemberReference.h"
 #include "OtIdentifier.h"
+#include "OtInteger.h"
+#include "OtJit.h"
+#include "OtRangeIterator.h"
+#include "OtReal.h"
 #include "OtString.h"
+#include "OtStringIterator.h"
 #include "OtVM.h"
 
+#if OT_VM_STATISTICS
+#include "OtVMStatistics.h"
+#endif
+
+
+//
+//	OtVM::OtVM
+//
+
+OtVM::OtVM() {
+	// remember how the primitives implement the methods that have their own opcode
+	// (scripts can replace them and we must then take the slow path)
+	auto addMethod = [this](OtType type, OtID id) {
+		primitiveMethods.push_back(PrimitiveMethod{type, id, type->has(id) ? type->get(id) : nullptr});
+	};
+
+	auto addOperators = [&](OtType type, bool ordered) {
+		for (auto i = static_cast<int>(OtByteCodeClass::Opcode::add); i <= static_cast<int>(OtByteCodeClass::Opcode::greaterEqual); i++) {
+			auto opcode = static_cast<OtByteCodeClass::Opcode>(i);
+
+			if (ordered || opcode == OtByteCodeClass::Opcode::equal || opcode == OtByteCodeClass::Opcode::notEqual) {
+				addMethod(type, OtByteCodeClass::getOperatorMethod(opcode));
+			}
+		}
+	};
+
+	addOperators(OtIntegerClass::getMeta(), true);
+	addOperators(OtRealClass::getMeta(), true);
+	addOperators(OtBooleanClass::getMeta(), false);
+
+	for (auto type : {OtRangeIteratorClass::getMeta(), OtArrayIteratorClass::getMeta(), OtStringIteratorClass::getMeta()}) {
+		addMethod(type, endID);
+		addMethod(type, nextID);
+	}
+
+	primitiveMethodsVersion = OtTypeClass::getMemberVersion();
+	primitiveMethodsValid = true;
+
+	// every thread has its own types so they are looked up for each virtual machine
+	booleanType = OtBooleanClass::getMeta().raw();
+	integerType = OtIntegerClass::getMeta().raw();
+	realType = OtRealClass::getMeta().raw();
+	rangeIteratorType = OtRangeIteratorClass::getMeta().raw();
+	arrayIteratorType = OtArrayIteratorClass::getMeta().raw();
+	stringIteratorType = OtStringIteratorClass::getMeta().raw();
+
+	// allow the profiler to sample us
+	OtProfiler::addThread(&hooks);
+}
+
+
+//
+//	OtVM::~OtVM
+//
+
+OtVM::~OtVM() {
+	OtProfiler::removeThread(&hooks);
+
+#if OT_VM_STATISTICS
+	OtVMStatistics::flush();
+#endif
+}
+
+
+//
+//	OtVM::runHooks
+//
+
+void OtVM::runHooks() {
+	if (hooks.fetch_and(~OtProfiler::sampleRequest, std::memory_order_relaxed) & OtProfiler::sampleRequest) {
+		OtProfiler::sample(stack);
+	}
+
+	if (hooks.load(std::memory_order_relaxed) & statementHookRequest) {
+		statementHook();
+	}
+
+	// an interrupt is meant to end the script so it isn't logged as an error
+	if (hooks.load(std::memory_order_relaxed) & interruptRequest) {
+		throw OtException("Script was interrupted");
+	}
+}
+
+
+//
+//	OtVM::primitiveMethodsUnchanged
+//
+
+bool OtVM::primitiveMethodsUnchanged() {
+	// only look again when type members changed
+	auto version = OtTypeClass::getMemberVersion();
+
+	if (version != primitiveMethodsVersion) {
+		primitiveMethodsVersion = version;
+		primitiveMethodsValid = true;
+
+		for (auto& primitiveMethod : primitiveMethods) {
+			auto& type = primitiveMethod.type;
+			auto method = type->has(primitiveMethod.id) ? type->get(primitiveMethod.id) : nullptr;
+
+			if (method.raw() != primitiveMethod.method.raw()) {
+				primitiveMethodsValid = false;
+			}
+		}
+	}
+
+	return primitiveMethodsValid;
+}
+
+
+//
+//	OtVM::primitiveOperator
+//
+
+OtObject OtVM::primitiveOperator(OtByteCodeClass::Opcode opcode, OtObject* operands) {
+	// both operands must be plain primitives (not derived classes or objects with their own members)
+	auto& left = operands[0];
+	auto& right = operands[1];
+	auto leftType = left->getType().raw();
+	auto rightType = right->getType().raw();
+
+	if (left->hasMembers() || right->hasMembers() ||
+		(leftType != integerType && leftType != realType && leftType != booleanType) ||
+		(rightType != integerType && rightType != realType && rightType != booleanType) ||
+		!primitiveMethodsUnchanged()) {
+
+		return nullptr;
+	}
+
+	// the left operand determines the operation and the right operand is converted (just like a method call would)
+	using Opcode = OtByteCodeClass::Opcode;
+
+	if (leftType == integerType) {
+		auto object = static_cast<OtIntegerClass*>(left.raw());
+		auto operand = right->operator int64_t();
+
+		switch (opcode) {
+			case Opcode::add: return OtInteger::create(object->add(operand));
+			case Opcode::subtract: return OtInteger::create(object->subtract(operand));
+			case Opcode::multiply: return OtInteger::create(object->multiply(operand));
+			case Opcode::divide: return OtInteger::create(object->divide(operand));
+			case Opcode::modulo: return OtInteger::create(object->modulo(operand));
+			case Opcode::equal: return OtBooleanClass::getShared(object->equal(operand));
+			case Opcode::notEqual: return OtBooleanClass::getShared(object->notEqual(operand));
+			case Opcode::lessThan: return OtBooleanClass::getShared(object->lessThan(operand));
+			case Opcode::lessEqual: return OtBooleanClass::getShared(object->lessEqual(operand));
+			case Opcode::greaterThan: return OtBooleanClass::getShared(object->greaterThan(operand));
+			case Opcode::greaterEqual: return OtBooleanClass::getShared(object->greaterEqual(operand));
+			default: return nullptr;
+		}
+
+	} else if (leftType == realType) {
+		auto object = static_cast<OtRealClass*>(left.raw());
+		auto operand = right->operator double();
+
+		switch (opcode) {
+			case Opcode::add: return OtReal::create(object->add(operand));
+			case Opcode::subtract: return OtReal::create(object->subtract(operand));
+			case Opcode::multiply: return OtReal::create(object->multiply(operand));
+			case Opcode::divide: return OtReal::create(object->divide(operand));
+			case Opcode::modulo: return OtReal::create(object->modulo(operand));
+			case Opcode::equal: return OtBooleanClass::getShared(object->equal(operand));
+			case Opcode::notEqual: return OtBooleanClass::getShared(object->notEqual(operand));
+			case Opcode::lessThan: return OtBooleanClass::getShared(object->lessThan(operand));
+			case Opcode::lessEqual: return OtBooleanClass::getShared(object->lessEqual(operand));
+			case Opcode::greaterThan: return OtBooleanClass::getShared(object->greaterThan(operand));
+			case Opcode::greaterEqual: return OtBooleanClass::getShared(object->greaterEqual(operand));
+			default: return nullptr;
+		}
+
+	} else {
+		auto object = static_cast<OtBooleanClass*>(left.raw());
+		auto operand = right->operator bool();
+
+		switch (opcode) {
+			case Opcode::equal: return OtBooleanClass::getShared(object->equal(operand));
+			case Opcode::notEqual: return OtBooleanClass::getShared(object->notEqual(operand));
+			default: return nullptr;
+		}
+	}
+}
+
+
+//
+//	OtVM::iterate
+//
+
+bool OtVM::iterate(size_t slot, OtMethodCache* caches) {
+	// the iterator sits on top of the stack (copy it as method calls can grow the stack)
+	auto iterator = stack.top();
+	auto type = iterator->getType().raw();
+
+	// the built-in iterators are advanced directly (unless scripts changed them)
+	if ((type == rangeIteratorType || type == arrayIteratorType || type == stringIteratorType) &&
+		!iterator->hasMembers() &&
+		primitiveMethodsUnchanged()) {
+
+		if (type == rangeIteratorType) {
+			auto range = static_cast<OtRangeIteratorClass*>(iterator.raw());
+
+			if (range->end()) {
+				return false;
+			}
+
+			stack.setFrameItem(slot, OtInteger::create(range->next()));
+
+		} else if (type == arrayIteratorType) {
+			auto array = static_cast<OtArrayIteratorClass*>(iterator.raw());
+
+			if (array->end()) {
+				return false;
+			}
+
+			stack.setFrameItem(slot, array->next());
+
+		} else {
+			auto string = static_cast<OtStringIteratorClass*>(iterator.raw());
+
+			if (string->end()) {
+				return false;
+			}
+
+			stack.setFrameItem(slot, OtString::create(string->next()));
+		}
+
+		return true;
+	}
+
+	// other iterators are asked through their methods (using the call site's inline caches)
+	if (caches[0].lookup(iterator, endID)->operator()(1, &iterator)->operator bool()) {
+		return false;
+	}
+
+	auto value = caches[1].lookup(iterator, nextID)->operator()(1, &iterator);
+	stack.setFrameItem(slot, value ? value : null);
+	return true;
+}
+
 
 //
-//	OtTryCatch
+//	OtVMErrorLocation
 //
 
-class OtTryCatch {
+class OtVMErrorLocation : public OtException::Location {
 public:
-	OtTryCatch(size_t p, OtStackState s) : pc(p), stack(s) {}
+	OtVMErrorLocation(OtByteCode b, size_t p) : bytecode(b), pc(p) {}
+
+	std::string getModule() override { return bytecode->getModule(); }
+	size_t getLineNumber() override { return bytecode->getLineNumber(pc); }
+	size_t getStart() override { return bytecode->getStatementStart(pc); }
+	size_t getEnd() override { return bytecode->getStatementEnd(pc); }
+	std::string getSourceCode() override { return bytecode->getStatementSourceCode(pc); }
+
+private:
+	OtByteCode bytecode;
 	size_t pc;
-	OtStackState stack;
 };
 
 
+//
+//	Instruction dispatch
+//
+//	Compilers that support labels as values (GCC and Clang) get a threaded
+//	interpreter where every handler jumps straight to the next handler. All
+//	others use a classic switch statement in a loop. Computed gotos don't run
+//	destructors so handlers dispatch after their local variables are gone.
+//
+//	Builds with OT_VM_STATISTICS count every opcode at the start of its handler.
+//
+
+#if OT_VM_STATISTICS
+#define OT_COUNT_OPCODE(name) statistics.countOpcode(previous, OtByteCodeClass::Opcode::name);
+#else
+#define OT_COUNT_OPCODE(name)
+#endif
+
+#if defined(__GNUC__)
+#define OT_THREADED_DISPATCH 1
+#else
+#define OT_THREADED_DISPATCH 0
+#endif
+
+#if OT_THREADED_DISPATCH
+#define OT_OPCODE(name) opcode_##name: OT_COUNT_OPCODE(name)
+#define OT_DISPATCH() goto *instruction->handler
+#define OT_NEXT() instruction++; goto *instruction->handler
+#define OT_JUMP(target) instruction = instructions + (target); goto *instruction->handler
+
+#else
+#define OT_OPCODE(name) case OtByteCodeClass::Opcode::name: OT_COUNT_OPCODE(name)
+#define OT_NEXT() instruction++; continue
+#define OT_JUMP(target) instruction = instructions + (target); continue
+#endif
+
+// binary operators try the primitive fast path before they fall back to a method call
+#define OT_BINARY_OPERATOR(name) \
+	OT_OPCODE(name) { \
+		auto operands = stack.getSP(2); \
+		auto result = primitiveOperator(OtByteCodeClass::Opcode::name, operands); \
+		\
+		if (!result) { \
+			result = instruction->cache->lookup(operands[0], static_cast<OtID>(instruction->operand1))->operator()(2, operands); \
+		} \
+		\
+		stack.replace(2, result ? std::move(result) : null); \
+	} \
+	\
+	OT_NEXT();
+
+
 //
 //	OtVM::executeByteCode
 //
 
+// labels as values are an extension (only allow them in the dispatch loop)
+#if OT_THREADED_DISPATCH
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wgnu-label-as-value"
+#else
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+#endif
+
 OtObject OtVM::executeByteCode(OtByteCode bytecode, size_t callingParameters) {
+#if OT_THREADED_DISPATCH
+	// dispatch table (must be in the same order as the opcodes)
+	static const void* handlers[] = {
+		&&opcode_statement,
+		&&opcode_push,
+		&&opcode_pushNull,
+		&&opcode_pop,
+		&&opcode_popCount,
+		&&opcode_dup,
+		&&opcode_swap,
+		&&opcode_move,
+		&&opcode_jump,
+		&&opcode_jumpTrue,
+		&&opcode_jumpFalse,
+		&&opcode_member,
+		&&opcode_super,
+		&&opcode_method,
+		&&opcode_exit,
+		&&opcode_pushTry,
+		&&opcode_popTry,
+		&&opcode_iterate,
+		&&opcode_pushStackObject,
+		&&opcode_pushStackMember,
+		&&opcode_pushObjectMember,
+		&&opcode_pushMember,
+		&&opcode_assignStack,
+		&&opcode_assignMember,
+		&&opcode_add,
+		&&opcode_subtract,
+		&&opcode_multiply,
+		&&opcode_divide,
+		&&opcode_modulo,
+		&&opcode_equal,
+		&&opcode_notEqual,
+		&&opcode_lessThan,
+		&&opcode_lessEqual,
+		&&opcode_greaterThan,
+		&&opcode_greaterEqual
+	};
+
+	static_assert(std::size(handlers) == OtByteCodeClass::opcodeCount);
+#else
+	static const void* const* handlers = nullptr;
+#endif
+
 	// try/catch stack
 	std::vector<OtTryCatch> tryCatch;
 
-	// local variables
-	size_t pc = 0;
-	size_t end = bytecode->size();
+#if OT_VM_STATISTICS
+	// execution statistics
+	auto& statistics = OtVMStatistics::get();
+	size_t previous = OtVMStatistics::noOpcode;
+#endif
+
+	// get pre-decoded instructions
+	auto instructions = bytecode->getInstructions(handlers);
+	auto instruction = instructions;
 
 #if OT_DEBUG
 	size_t sp = stack.size();
 #endif
 
 	// open a new stack frame
-	stack.openFrame(bytecode, callingParameters, &pc);
+	stack.openFrame(bytecode, callingParameters, &instruction);
 
 	// save the current stack state (so we can restore it in case of an uncaught exception)
 	OtStackState state = stack.getState();
 
-	// execute all instructions
-	while (pc < end) {
+	// exception handler (resumes at a try/catch handler or adds our location to the exception and throws it)
+	auto handleException = [&](OtException& e) {
+		// do we have an exception handler
+		if (tryCatch.size()) {
+			// yes, use it
+			OtTryCatch tc = tryCatch.back();
+			tryCatch.pop_back();
+
+			// restore instruction pointer and stack
+			instruction = instructions + tc.instruction;
+			stack.restoreState(tc.stack);
+
+			// put exception on the stack
+			auto message = OtString::create(e.getShortErrorMessage());
+			stack.push(message);
+
+		} else {
+			// the location is only resolved if the exception is reported
+			// (instructions record the offset after themselves so we step back into the one that failed)
+			e.addLocation(std::make_shared<OtVMErrorLocation>(bytecode, instruction->pc - 1));
+
+			// restore the stack state
+			stack.restoreState(state);
+			stack.closeFrame();
+
+			// pass the exception on
+			throw std::move(e);
+		}
+	};
+
+	// hot functions run as native code that shares our frame, instruction pointer and try/catch stack
+#if OT_VM_STATISTICS
+	const bool jit = false;
+#else
+	const bool jit = OtConfig::useJit();
+#endif
+
+	OtJitCode* native = jit ? OtJit::getCode(bytecode.raw()) : nullptr;
+
+	// execute instructions (we only get back to the top of this loop after an exception was handled)
+	while (true) {
+	runNative:
+		if (native) {
+			OtJitContext context{this, &hooks, &instruction, &tryCatch, stack.getFrame().offset * sizeof(OtObject), {}, nullptr};
+
+			if (native->run(context, static_cast<size_t>(instruction - instructions))) {
+				goto finished;
+
+			} else if (context.exception) {
+				std::rethrow_exception(context.exception);
+
+			} else {
+				handleException(context.error);
+				continue;
+			}
+		}
+
 		try {
-			switch (bytecode->getOpcode(pc)) {
+#if OT_THREADED_DISPATCH
+			OT_DISPATCH();
+			{
+#else
+			while (true) {
+				switch (instruction->opcode) {
+#endif
 
 				// opcodes generated by the compiler
 
-				case OtByteCodeClass::Opcode::statement:
-					// call statement hook (if required)
-					if (callHook) {
-						statementHook();
+				OT_OPCODE(statement) {
+					// call statement hook, take a profiler sample or handle an interrupt (if required)
+					if (hooks.load(std::memory_order_relaxed)) {
+						runHooks();
 					}
+				}
 
-					break;
+				OT_NEXT();
 
-				case OtByteCodeClass::Opcode::push:
+				OT_OPCODE(push) {
 					// push an object onto the stack
-					stack.push(bytecode->getConstant(bytecode->getNumber(pc)));
-					break;
+					stack.push(*instruction->constant);
+				}
 
-				case OtByteCodeClass::Opcode::pushNull:
+				OT_NEXT();
+
+				OT_OPCODE(pushNull) {
 					// push null object onto the stack
 					stack.push(null);
-					break;
+				}
 
-				case OtByteCodeClass::Opcode::pop:
+				OT_NEXT();
+
+				OT_OPCODE(pop) {
 					// pop an object from the stack
 					stack.pop();
-					break;
+				}
+
+				OT_NEXT();
 
-				case OtByteCodeClass::Opcode::popCount:
+				OT_OPCODE(popCount) {
 					// pop specified number of objects from the stack
-					stack.pop(bytecode->getNumber(pc));
-					break;
+					stack.pop(instruction->operand1);
+				}
+
+				OT_NEXT();
 
-				case OtByteCodeClass::Opcode::dup:
+				OT_OPCODE(dup) {
 					// duplicate top object on the stack
 					stack.dup();
-					break;
+				}
 
-				case OtByteCodeClass::Opcode::swap:
+				OT_NEXT();
+
+				OT_OPCODE(swap) {
 					// swap the top two objects on the stack
 					stack.swap();
-					break;
+				}
 
-				case OtByteCodeClass::Opcode::move:
-					// move the top stack object back a specifed number of slots and shorten stack
-					stack.move(bytecode->getNumber(pc));
-					break;
+				OT_NEXT();
 
-				case OtByteCodeClass::Opcode::jump:
-					// jump to the specified bytecode location
-					pc = bytecode->getJump(bytecode->getNumber(pc));
-					break;
+				OT_OPCODE(move) {
+					// move the top stack object back a specifed number of slots and shorten stack
+					stack.move(instruction->operand1);
+				}
 
-				case OtByteCodeClass::Opcode::jumpTrue: {
-					// jump to the specified bytecode location if the top stack object is true
-					auto jump = bytecode->getJump(bytecode->getNumber(pc));
-					auto value = stack.pop();
+				OT_NEXT();
 
-					if (value->operator bool()) {
-						pc = jump;
+				OT_OPCODE(jump) {
+					// jump to the specified instruction (hot loops continue as native code)
+					if (jit && instructions + instruction->operand1 < instruction && (native = OtJit::getCode(bytecode.raw()))) {
+						instruction = instructions + instruction->operand1;
+						goto runNative;
 					}
 
-					break;
+					OT_JUMP(instruction->operand1);
 				}
 
-				case OtByteCodeClass::Opcode::jumpFalse: {
-					// jump to the specified bytecode location if the top stack object is false
-					auto jump = bytecode->getJump(bytecode->getNumber(pc));
-					auto value = stack.pop();
+				OT_OPCODE(jumpTrue) {
+					// jump to the specified instruction if the top stack object is true
+					if (stack.pop()->operator bool()) {
+						OT_JUMP(instruction->operand1);
+					}
+
+					OT_NEXT();
+				}
 
-					if (!value->operator bool()) {
-						pc = jump;
+				OT_OPCODE(jumpFalse) {
+					// jump to the specified instruction if the top stack object is false
+					if (!stack.pop()->operator bool()) {
+						OT_JUMP(instruction->operand1);
 					}
 
-					break;
+					OT_NEXT();
 				}
 
-				case OtByteCodeClass::Opcode::member: {
+				OT_OPCODE(member) {
 					// create an object member reference
 					auto object = stack.pop();
-					auto member = bytecode->getID(pc);
+					auto member = static_cast<OtID>(instruction->operand1);
 					auto reference = OtMemberReference::create(object, member);
-					stack.push(reference);
-					break;
+					stack.push(std::move(reference));
 				}
 
-				case OtByteCodeClass::Opcode::super: {
+				OT_NEXT();
+
+				OT_OPCODE(super) {
 					// get a specifed member in a superclass
 					auto cls = OtClass(stack.pop());
-					auto member = bytecode->getID(pc);
+					auto member = static_cast<OtID>(instruction->operand1);
 					auto result = cls->getSuper(member);
-					stack.push(result);
-					break;
+					stack.push(std::move(result));
 				}
 
-				case OtByteCodeClass::Opcode::method: {
+				OT_NEXT();
+
+				OT_OPCODE(method) {
 					// call a method on a specified object
 					// get method and number of calling parameters
-					auto method = bytecode->getID(pc);
-					auto count = bytecode->getNumber(pc);
+					auto method = static_cast<OtID>(instruction->operand1);
+					auto count = instruction->operand2;
 
 					// get a pointer to the calling parameters and target object
 					auto parameters = stack.getSP(count + 1);
@@ -169,136 +618,128 @@ OtObject OtVM::executeByteCode(OtByteCode bytecode, size_t callingParameters) {
 						OtLogFatal("Internal error: can't call method [{}] with [{}] parameters on nullptr", OtIdentifier::name(method), count);
 					}
 
-					// call method
-					auto result = parameters[0]->get(method)->operator()(count + 1, parameters);
+					// call method (using the call site's inline cache to find it)
+#if OT_VM_STATISTICS
+					auto callee = instruction->cache->lookup(parameters[0], method);
+					statistics.countCall(bytecode, instruction->pc, method, parameters[0], callee);
+					auto result = callee->operator()(count + 1, parameters);
+#else
+					auto result = instruction->cache->lookup(parameters[0], method)->operator()(count + 1, parameters);
+#endif
 
-					// remove arguments from stack and put result back on it
-					stack.pop(count + 1);
-					stack.push(result ? result : null);
-					break;
+					// replace target and arguments on the stack with the result
+					stack.replace(count + 1, result ? std::move(result) : null);
 				}
 
-				case OtByteCodeClass::Opcode::exit:
+				OT_NEXT();
+
+				OT_OPCODE(exit) {
 					// exit instructions
-					pc = end;
-					break;
+					goto finished;
+				}
 
-				case OtByteCodeClass::Opcode::pushTry:
+				OT_OPCODE(pushTry) {
 					// start a new try/catch cycle
-					tryCatch.push_back(OtTryCatch(bytecode->getJump(bytecode->getNumber(pc)), stack.getState()));
-					break;
+					tryCatch.push_back(OtTryCatch(instruction->operand1, stack.getState()));
+				}
 
-				case OtByteCodeClass::Opcode::popTry:
+				OT_NEXT();
+
+				OT_OPCODE(popTry) {
 					// start a new try/catch cycle
 					tryCatch.pop_back();
-					break;
+				}
+
+				OT_NEXT();
+
+				OT_OPCODE(iterate) {
+					// advance the iterator on the stack into the loop variable or leave the loop
+					if (!iterate(instruction->operand1, instruction->cache)) {
+						OT_JUMP(instruction->operand2);
+					}
+				}
+
+				OT_NEXT();
 
 				// opcodes generated by the optimizer
 
-				case OtByteCodeClass::Opcode::pushStackObject: {
+				OT_OPCODE(pushStackObject) {
 					// push a stack-based object back onto the stack
-					auto slot = bytecode->getNumber(pc);
-					auto object  = stack.getFrameItem(slot);
-					stack.push(object);
-					break;
+					stack.push(stack.getFrameItem(instruction->operand1));
 				}
 
-				case OtByteCodeClass::Opcode::pushStackMember: {
+				OT_NEXT();
+
+				OT_OPCODE(pushStackMember) {
 					// push a stack-based object member back onto the stack
-					auto slot = bytecode->getNumber(pc);
-					auto member = bytecode->getID(pc);
-					auto object  = stack.getFrameItem(slot);
-					auto resolvedMember = OtMemberReferenceClass::resolveMember(object, member);
-					stack.push(resolvedMember);
-					break;
+					auto object  = stack.getFrameItem(instruction->operand1);
+					auto member = static_cast<OtID>(instruction->operand2);
+					auto resolvedMember = OtMemberReferenceClass::resolveMember(object, member, *instruction->cache);
+					stack.push(std::move(resolvedMember));
 				}
 
-				case OtByteCodeClass::Opcode::pushObjectMember: {
+				OT_NEXT();
+
+				OT_OPCODE(pushObjectMember) {
 					// push a constant object member onto the stack
-					auto object = bytecode->getConstant(bytecode->getNumber(pc));
-					auto member = bytecode->getID(pc);
+					auto object = *instruction->constant;
+					auto member = static_cast<OtID>(instruction->operand1);
 					auto resolvedMember = OtMemberReferenceClass::resolveMember(object, member);
-					stack.push(resolvedMember);
-					break;
+					stack.push(std::move(resolvedMember));
 				}
 
-				case OtByteCodeClass::Opcode::pushMember: {
+				OT_NEXT();
+
+				OT_OPCODE(pushMember) {
 					// push a heap-based object member onto the stack
 					auto object = stack.pop();
-					auto member = bytecode->getID(pc);
-					auto resolvedMember = OtMemberReferenceClass::resolveMember(object, member);
-					stack.push(resolvedMember);
-					break;
+					auto member = static_cast<OtID>(instruction->operand1);
+					auto resolvedMember = OtMemberReferenceClass::resolveMember(object, member, *instruction->cache);
+					stack.push(std::move(resolvedMember));
 				}
 
-				case OtByteCodeClass::Opcode::assignStack: {
+				OT_NEXT();
+
+				OT_OPCODE(assignStack) {
 					// put the top stack object into a stack-based slot
-					auto slot = bytecode->getNumber(pc);
 					auto value = stack.top();
-					stack.setFrameItem(slot, value);
-					break;
+					stack.setFrameItem(instruction->operand1, value);
 				}
 
-				case OtByteCodeClass::Opcode::assignMember: {
+				OT_NEXT();
+
+				OT_OPCODE(assignMember) {
 					// put the top stack object into a heap-based object member
-					auto object = bytecode->getConstant(bytecode->getNumber(pc));
-					auto member = bytecode->getID(pc);
+					auto& object = *instruction->constant;
+					auto member = static_cast<OtID>(instruction->operand1);
 					auto value = stack.top();
 					object->set(member, value);
-					break;
 				}
-			}
-
-		} catch (const OtException& e) {
-			// do we have an exception handler
-			if (tryCatch.size()) {
-				// yes, use it
-				OtTryCatch tc = tryCatch.back();
-				tryCatch.pop_back();
 
-				// restore program counter and stack
-				pc = tc.pc;
-				stack.restoreState(tc.stack);
-
-				// put exception on the stack
-				auto message = OtString::create(e.getShortErrorMessage());
-				stack.push(message);
-
-			} else {
-				// format long message
-				auto fullMessage = fmt::format(
-					"{}\nModule: {}\n{}",
-					e.getLongErrorMessage(),
-					bytecode->getModule(),
-					bytecode->getStatementSourceCode(pc));
-
-				// restore the stack state
-				stack.restoreState(state);
-				stack.closeFrame();
-
-				// throw exception
-				if (e.getLineNumber()) {
-					throw OtException(
-						e.getModule(),
-						e.getLineNumber(),
-						e.getStart(),
-						e.getEnd(),
-						e.getShortErrorMessage(),
-						fullMessage);
-
-				} else {
-					throw OtException(
-						bytecode->getModule(),
-						bytecode->getLineNumber(pc),
-						bytecode->getStatementStart(pc),
-						bytecode->getStatementEnd(pc),
-						e.getShortErrorMessage(),
-						fullMessage);
+				OT_NEXT();
+
+				OT_BINARY_OPERATOR(add)
+				OT_BINARY_OPERATOR(subtract)
+				OT_BINARY_OPERATOR(multiply)
+				OT_BINARY_OPERATOR(divide)
+				OT_BINARY_OPERATOR(modulo)
+				OT_BINARY_OPERATOR(equal)
+				OT_BINARY_OPERATOR(notEqual)
+				OT_BINARY_OPERATOR(lessThan)
+				OT_BINARY_OPERATOR(lessEqual)
+				OT_BINARY_OPERATOR(greaterThan)
+				OT_BINARY_OPERATOR(greaterEqual)
+#if !OT_THREADED_DISPATCH
 				}
+#endif
 			}
+
+		} catch (OtException& e) {
+			handleException(e);
 		}
 	}
 
+finished:
 	// get result
 	auto result = stack.pop();
 
@@ -312,3 +753,11 @@ OtObject OtVM::executeByteCode(OtByteCode bytecode, size_t callingParameters) {
 	// return execution result
 	return result;
 }
+
+#if OT_THREADED_DISPATCH
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#else
+#pragma GCC diagnostic pop
+#endif
+#endif
@@ -12,23 +12,43 @@
 //	Include files
 //
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
+#include <vector>
 
 #include "OtObject.h"
 #include "OtByteCode.h"
 #include "OtClosure.h"
 #include "OtGlobal.h"
 #include "OtIdentifier.h"
+#include "OtProfiler.h"
 #include "OtSingleton.h"
 #include "OtStack.h"
 
 
+//
+//	OtTryCatch
+//
+
+class OtTryCatch {
+public:
+	OtTryCatch(size_t i, OtStackState s) : instruction(i), stack(s) {}
+	size_t instruction;
+	OtStackState stack;
+};
+
+
 //
 //	The ObjectTalk Virtual Machine
 //
 
 class OtVM : OtPerThreadSingleton<OtVM> {
 public:
+	// constructor/destructor
+	OtVM();
+	~OtVM();
+
 	// execute bytecode in the virtual machine
 	static inline OtObject execute(OtByteCode bytecode, size_t callingParameters=0) { return instance().executeByteCode(bytecode, callingParameters); }
 
@@ -78,10 +98,22 @@ public:
 
 	// debugging functions
 	static inline void setStatementHook(std::function<void()> hook) {
-		instance().statementHook = hook;
-		instance().callHook = hook != nullptr;
+		auto& vm = instance();
+		vm.statementHook = hook;
+
+		if (hook) {
+			vm.hooks.fetch_or(statementHookRequest, std::memory_order_relaxed);
+
+		} else {
+			vm.hooks.fetch_and(~statementHookRequest, std::memory_order_relaxed);
+		}
 	}
 
+	// interrupt the script running on a virtual machine (can be called from any thread)
+	// it raises an exception at every statement from then on so it can't catch its way out
+	static inline void interrupt(std::atomic<uint32_t>* hooks) { hooks->fetch_or(interruptRequest, std::memory_order_relaxed); }
+	static inline std::atomic<uint32_t>* getHooks() { return &instance().hooks; }
+
 	// get engine parameters
 	static inline OtStack* getStack() { return &instance().stack; }
 	static inline OtGlobal getGlobal() { return instance().global; }
@@ -89,20 +121,33 @@ public:
 
 	static inline OtClosure getClosure() { return instance().stack.getClosure(); }
 	static inline OtByteCode getByteCode() { return instance().stack.getFrame().bytecode; }
-	static inline size_t getPC() { return *instance().stack.getFrame().pc; }
+	static inline size_t getPC() { return instance().stack.getFrame().getPC(); }
 
 private:
 	// execute bytecode in the virtual machine
 	OtObject executeByteCode(OtByteCode bytecode, size_t callingParameters);
 
+	// apply a binary operator to primitive operands without a method call (returns nullptr if that's not possible)
+	OtObject primitiveOperator(OtByteCodeClass::Opcode opcode, OtObject* operands);
+
+	// advance an iterator into a stack slot (returns false at the end of the iteration)
+	bool iterate(size_t slot, OtMethodCache* caches);
+
+	// see if the primitive methods are still the ones we started with
+	bool primitiveMethodsUnchanged();
+
+	// the just-in-time compiler runs opcodes on our behalf
+	friend class OtJit;
+
 	// clear the virtual machine (releases any memory still used by the engine)
 	// virtual machine is no longer usable after this call
 
 	// it is only here to destruct objects that might possibly allocate UI resources
 	// VMs are thread singletons that are destructed when the thread ends (which is to late to release UI resources)
 
-	// it should only be called by the UI framework
+	// it should only be called by the UI framework (and by workers that are about to end)
 	friend class OtFramework;
+	friend class OtWorkerClass;
 
 	static inline void clear() {
 		auto& vm = instance();
@@ -116,7 +161,33 @@ private:
 	OtGlobal global = OtGlobal::create();
 	OtObject null = OtObject::create();
 
-	// debugging support
+	// debugging, profiling and interrupt support (the hooks are checked at the start of every statement)
+	static constexpr uint32_t statementHookRequest = 1;
+	static constexpr uint32_t interruptRequest = 2;
 	std::function<void()> statementHook;
-	bool callHook = false;
+	std::atomic<uint32_t> hooks{0};
+	void runHooks();
+
+	// original implementations of the primitive methods that opcodes bypass
+	struct PrimitiveMethod {
+		OtType type;
+		OtID id;
+		OtObject method;
+	};
+
+	std::vector<PrimitiveMethod> primitiveMethods;
+	uint64_t primitiveMethodsVersion = 0;
+	bool primitiveMethodsValid = false;
+
+	// the types that opcodes handle directly
+	OtTypeClass* booleanType;
+	OtTypeClass* integerType;
+	OtTypeClass* realType;
+	OtTypeClass* rangeIteratorType;
+	OtTypeClass* arrayIteratorType;
+	OtTypeClass* stringIteratorType;
+
+	// iteration method identifiers
+	OtID endID = OtIdentifier::create("__end__");
+	OtID nextID = OtIdentifier::create("__next__");
 };
@@ -0,0 +1,300 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+#if OT_VM_STATISTICS
+
+
+//
+//	Include files
+//
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+
+#include "fmt/format.h"
+#include "nlohmann/json.hpp"
+
+#include "OtFunction.h"
+#include "OtLog.h"
+#include "OtPath.h"
+#include "OtVMStatistics.h"
+
+
+//
+//	Opcode names (must be in the same order as the opcodes)
+//
+
+static const char* opcodeNames[] = {
+	"statement",
+	"push",
+	"pushNull",
+	"pop",
+	"popCount",
+	"dup",
+	"swap",
+	"move",
+	"jump",
+	"jumpTrue",
+	"jumpFalse",
+	"member",
+	"super",
+	"method",
+	"exit",
+	"pushTry",
+	"popTry",
+	"iterate",
+	"pushStackObject",
+	"pushStackMember",
+	"pushObjectMember",
+	"pushMember",
+	"assignStack",
+	"assignMember",
+	"add",
+	"subtract",
+	"multiply",
+	"divide",
+	"modulo",
+	"equal",
+	"notEqual",
+	"lessThan",
+	"lessEqual",
+	"greaterThan",
+	"greaterEqual"
+};
+
+static_assert(std::size(opcodeNames) == OtByteCodeClass::opcodeCount);
+
+
+//
+//	The report (shared by all threads)
+//
+
+struct OtVMStatisticsReport {
+	std::mutex mutex;
+	uint64_t opcodes[OtByteCodeClass::opcodeCount] = {};
+	uint64_t pairs[OtByteCodeClass::opcodeCount + 1][OtByteCodeClass::opcodeCount] = {};
+
+	struct CallSite {
+		std::string module;
+		size_t line;
+		std::string method;
+		uint64_t count = 0;
+		std::map<std::string, uint64_t> receivers;
+	};
+
+	std::map<std::string, CallSite> callSites;
+	std::map<std::string, uint64_t> natives;
+};
+
+static OtVMStatisticsReport& getReport() {
+	// never freed as threads can end during static destruction
+	static OtVMStatisticsReport* report = new OtVMStatisticsReport;
+	return *report;
+}
+
+static thread_local OtVMStatistics* threadStatistics = nullptr;
+
+
+//
+//	OtVMStatistics::get
+//
+
+OtVMStatistics& OtVMStatistics::get() {
+	if (!threadStatistics) {
+		threadStatistics = new OtVMStatistics;
+	}
+
+	return *threadStatistics;
+}
+
+
+//
+//	OtVMStatistics::countCall
+//
+
+void OtVMStatistics::countCall(OtByteCode& bytecode, size_t pc, OtID method, OtObject& receiver, OtObject& callee) {
+	auto [entry, inserted] = callSites.try_emplace(std::make_pair(bytecode.raw(), pc));
+	auto& site = entry->second;
+
+	if (inserted) {
+		site.method = method;
+		bytecodes.emplace_back(bytecode);
+	}
+
+	auto type = receiver->getType().raw();
+	site.count++;
+	site.receivers[type]++;
+
+	if (callee.isKindOf<OtFunctionClass>()) {
+		natives[std::make_pair(type, method)]++;
+	}
+}
+
+
+//
+//	OtVMStatistics::flush
+//
+
+void OtVMStatistics::flush() {
+	if (!threadStatistics) {
+		return;
+	}
+
+	auto& statistics = *threadStatistics;
+	auto& report = getReport();
+	std::lock_guard<std::mutex> lock(report.mutex);
+
+	for (size_t i = 0; i < OtByteCodeClass::opcodeCount; i++) {
+		report.opcodes[i] += statistics.opcodes[i];
+	}
+
+	for (size_t i = 0; i <= OtByteCodeClass::opcodeCount; i++) {
+		for (size_t j = 0; j < OtByteCodeClass::opcodeCount; j++) {
+			report.pairs[i][j] += statistics.pairs[i][j];
+		}
+	}
+
+	// call sites are identified by their source location (which is resolved here as it's expensive)
+	for (auto& [key, site] : statistics.callSites) {
+		auto bytecode = key.first;
+		auto module = OtPath::getFilename(bytecode->getModule());
+		auto line = bytecode->getLineNumber(key.second);
+		auto method = std::string(OtIdentifier::name(site.method));
+		auto& entry = report.callSites[fmt::format("{}:{}:{}", module, line, method)];
+
+		entry.module = module;
+		entry.line = line;
+		entry.method = method;
+		entry.count += site.count;
+
+		for (auto& [type, count] : site.receivers) {
+			entry.receivers[type->getName()] += count;
+		}
+	}
+
+	for (auto& [key, count] : statistics.natives) {
+		report.natives[fmt::format("{}.{}", key.first->getName(), OtIdentifier::name(key.second))] += count;
+	}
+
+	delete threadStatistics;
+	threadStatistics = nullptr;
+}
+
+
+//
+//	OtVMStatistics::writeJSON
+//
+
+void OtVMStatistics::writeJSON(std::ostream& stream) {
+	flush();
+
+	auto& report = getReport();
+	std::lock_guard<std::mutex> lock(report.mutex);
+
+	// opcodes and opcode pairs (ordered by frequency)
+	std::vector<std::pair<std::string, uint64_t>> opcodes;
+	std::vector<std::pair<std::string, uint64_t>> pairs;
+
+	for (size_t i = 0; i < OtByteCodeClass::opcodeCount; i++) {
+		if (report.opcodes[i]) {
+			opcodes.emplace_back(opcodeNames[i], report.opcodes[i]);
+		}
+	}
+
+	// the first instruction of a function forms a pair with "(start)"
+	for (size_t i = 0; i <= OtByteCodeClass::opcodeCount; i++) {
+		for (size_t j = 0; j < OtByteCodeClass::opcodeCount; j++) {
+			if (report.pairs[i][j]) {
+				auto first = i == noOpcode ? "(start)" : opcodeNames[i];
+				pairs.emplace_back(fmt::format("{}+{}", first, opcodeNames[j]), report.pairs[i][j]);
+			}
+		}
+	}
+
+	auto byCount = [](auto& a, auto& b) { return a.second > b.second; };
+	std::sort(opcodes.begin(), opcodes.end(), byCount);
+	std::sort(pairs.begin(), pairs.end(), byCount);
+
+	uint64_t total = 0;
+	auto opcodeList = nlohmann::json::array();
+
+	for (auto& [name, count] : opcodes) {
+		opcodeList.push_back({{"opcode", name}, {"count", count}});
+		total += count;
+	}
+
+	auto pairList = nlohmann::json::array();
+
+	for (auto& [name, count] : pairs) {
+		pairList.push_back({{"pair", name}, {"count", count}});
+	}
+
+	// method call sites (ordered by frequency)
+	std::vector<OtVMStatisticsReport::CallSite*> sites;
+
+	for (auto& [key, site] : report.callSites) {
+		sites.emplace_back(&site);
+	}
+
+	std::sort(sites.begin(), sites.end(), [](auto a, auto b) { return a->count > b->count; });
+	auto siteList = nlohmann::json::array();
+
+	for (auto site : sites) {
+		auto receivers = nlohmann::json::object();
+
+		for (auto& [type, count] : site->receivers) {
+			receivers[type] = count;
+		}
+
+		siteList.push_back({
+			{"module", site->module},
+			{"line", site->line},
+			{"method", site->method},
+			{"count", site->count},
+			{"receivers", receivers},
+			{"polymorphic", site->receivers.size() > 1}
+		});
+	}
+
+	// native functions (ordered by frequency)
+	std::vector<std::pair<std::string, uint64_t>> natives(report.natives.begin(), report.natives.end());
+	std::sort(natives.begin(), natives.end(), byCount);
+	auto nativeList = nlohmann::json::array();
+
+	for (auto& [name, count] : natives) {
+		nativeList.push_back({{"function", name}, {"count", count}});
+	}
+
+	nlohmann::json data = {
+		{"instructions", total},
+		{"opcodes", opcodeList},
+		{"pairs", pairList},
+		{"callSites", siteList},
+		{"natives", nativeList}
+	};
+
+	stream << data.dump(1, '\t') << '\n';
+}
+
+
+//
+//	OtVMStatistics::save
+//
+
+void OtVMStatistics::save(const std::string& path) {
+	std::ofstream stream(path);
+
+	if (!stream) {
+		OtLogError("Can't write VM statistics to [{}]", path);
+	}
+
+	writeJSON(stream);
+}
+
+#endif
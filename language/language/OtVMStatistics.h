@@ -0,0 +1,84 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+#pragma once
+
+
+//
+//	Include files
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "OtByteCode.h"
+#include "OtIdentifier.h"
+#include "OtObject.h"
+
+
+//
+//	OtVMStatistics
+//
+//	Execution statistics for tuning the compiler and the optimizer. They are
+//	only collected when the OT_VM_STATISTICS build option is enabled (the
+//	virtual machine contains no trace of them otherwise). The interpreter
+//	counts every executed opcode, every pair of consecutive opcodes
+//	(candidates for superinstructions), the receiver types at every method
+//	call site and the calls to native functions. Every thread counts on its
+//	own and adds its numbers to the report when its virtual machine ends.
+//
+
+class OtVMStatistics {
+public:
+	// marks the start of an instruction sequence in the opcode pairs
+	static constexpr size_t noOpcode = OtByteCodeClass::opcodeCount;
+
+	// get the counters for the calling thread
+	static OtVMStatistics& get();
+
+	// count an opcode (and the pair it forms with the previous one)
+	inline void countOpcode(size_t& previous, OtByteCodeClass::Opcode opcode) {
+		auto current = static_cast<size_t>(opcode);
+		opcodes[current]++;
+		pairs[previous][current]++;
+		previous = current;
+	}
+
+	// count a method call
+	void countCall(OtByteCode& bytecode, size_t pc, OtID method, OtObject& receiver, OtObject& callee);
+
+	// add the calling thread's counters to the report
+	static void flush();
+
+	// write the report as JSON
+	static void writeJSON(std::ostream& stream);
+	static void save(const std::string& path);
+
+private:
+	// opcode counters
+	uint64_t opcodes[OtByteCodeClass::opcodeCount] = {};
+	uint64_t pairs[OtByteCodeClass::opcodeCount + 1][OtByteCodeClass::opcodeCount] = {};
+
+	// call sites (the bytecode is kept alive until the counters are flushed)
+	struct CallSite {
+		OtID method;
+		uint64_t count = 0;
+		std::unordered_map<OtTypeClass*, uint64_t> receivers;
+	};
+
+	std::map<std::pair<OtByteCodeClass*, size_t>, CallSite> callSites;
+	std::vector<OtByteCode> bytecodes;
+
+	// native function calls (by receiver type and member)
+	std::map<std::pair<OtTypeClass*, OtID>, uint64_t> natives;
+};
@@ -13,6 +13,8 @@
 //
 
 #include <string>
+#include <string_view>
+#include <utility>
 
 #include "OtBoolean.h"
 #include "OtInteger.h"
@@ -37,54 +39,98 @@ struct OtValue<void> {
 
 template <>
 struct OtValue<bool> {
-	static inline OtObject encode(bool value) { return OtBoolean::create(value); }
-	static inline bool decode(OtObject object) { return object->operator bool(); }
+	static inline OtObject encode(bool value) { return OtBooleanClass::getShared(value); }
+	static inline bool decode(OtObject& object) { return object->operator bool(); }
 };
 
 template <>
 struct OtValue<int> {
 	static inline OtObject encode(int value) { return OtInteger::create(value); }
-	static inline int decode(OtObject object) { return object->operator int(); }
+	static inline int decode(OtObject& object) { return object->operator int(); }
 };
 
 template <>
 struct OtValue<int64_t> {
 	static inline OtObject encode(int64_t value) { return OtInteger::create(value); }
-	static inline int64_t decode(OtObject object) { return object->operator int64_t(); }
+	static inline int64_t decode(OtObject& object) { return object->operator int64_t(); }
 };
 
 template <>
 struct OtValue<size_t> {
 	static inline OtObject encode(size_t value) { return OtInteger::create(static_cast<int64_t>(value)); }
-	static inline size_t decode(OtObject object) { return object->operator size_t(); }
+	static inline size_t decode(OtObject& object) { return object->operator size_t(); }
 };
 
 template <>
 struct OtValue<float> {
 	static inline OtObject encode(float value) { return OtReal::create(value); }
-	static inline float decode(OtObject object) { return object->operator float(); }
+	static inline float decode(OtObject& object) { return object->operator float(); }
 };
 
 template <>
 struct OtValue<double> {
 	static inline OtObject encode(double value) { return OtReal::create(value); }
-	static inline double decode(OtObject object) { return object->operator double(); }
+	static inline double decode(OtObject& object) { return object->operator double(); }
 };
 
 template <>
 struct OtValue<std::string> {
 	static inline OtObject encode(const std::string& value) { return OtString::create(value); }
-	static inline std::string decode(OtObject object) { return object->operator std::string(); }
+	static inline std::string decode(OtObject& object) { return object->operator std::string(); }
 };
 
 template <>
 struct OtValue<const std::string&> {
 	static inline OtObject encode(const std::string& value) { return OtString::create(value); }
-	static inline std::string decode(OtObject object) { return object->operator std::string(); }
+	static inline std::string decode(OtObject& object) { return object->operator std::string(); }
+};
+
+template <>
+struct OtValue<std::string_view> {
+	static inline OtObject encode(std::string_view value) { return OtString::create(std::string(value)); }
 };
 
 template <>
 struct OtValue<OtObject> {
 	static inline OtObject encode(OtObject value) { return value; }
-	static inline OtObject decode(OtObject object) { return object; }
+	static inline OtObject decode(OtObject& object) { return object; }
+};
+
+
+//
+//	OtArgument
+//
+//	Holds a decoded argument for the duration of a native call. Strings
+//	passed by reference or view use the String object's own storage so
+//	they are not copied.
+//
+
+template <class T>
+struct OtArgument {
+	inline OtArgument(OtObject& object) : value(OtValue<T>::decode(object)) {}
+	inline auto&& get() { return std::move(value); }
+	decltype(OtValue<T>::decode(std::declval<OtObject&>())) value;
+};
+
+template <>
+struct OtArgument<const std::string&> {
+	inline OtArgument(OtObject& object) {
+		if (object.isKindOf<OtStringClass>()) {
+			pointer = &static_cast<OtStringClass*>(object.raw())->getValue();
+
+		} else {
+			copy = object->operator std::string();
+			pointer = &copy;
+		}
+	}
+
+	inline const std::string& get() { return *pointer; }
+	const std::string* pointer;
+	std::string copy;
+};
+
+template <>
+struct OtArgument<std::string_view> : OtArgument<const std::string&> {
+	inline OtArgument(OtObject& object) : OtArgument<const std::string&>(object) {}
+	inline std::string_view get() { return *pointer; }
 };
@@ -13,15 +13,28 @@
 #include "OtFunction.h"
 
 
+//
+//	OtBooleanClass::getShared
+//
+
+OtBoolean OtBooleanClass::getShared(bool value) {
+	// reference counting is not thread safe so every thread gets its own pair
+	thread_local OtBoolean trueValue = OtBoolean::create(true);
+	thread_local OtBoolean falseValue = OtBoolean::create(false);
+	return value ? trueValue : falseValue;
+}
+
+
 //
 //	OtBooleanClass::getMeta
 //
 
 OtType OtBooleanClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtBooleanClass>("Boolean", OtPrimitiveClass::getMeta());
+		type->setAcyclic();
 
 		type->set("boolean", OtFunction::create(&OtBooleanClass::operator bool));
 		type->set("integer", OtFunction::create(&OtBooleanClass::operator int64_t));
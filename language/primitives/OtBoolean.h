@@ -38,6 +38,7 @@ public:
 
 	// comparison
 	inline bool operator==(OtObject operand) override { return value == operand->operator bool(); }
+	inline size_t hash() override { return std::hash<bool>{}(value); }
 	inline bool operator<(OtObject operand) override { return value < operand->operator bool(); }
 
 	inline bool equal(bool operand) { return value == operand; }
@@ -53,6 +54,9 @@ public:
 	inline bool bitwiseXor(bool operand) { return value ^ operand; }
 	inline bool bitwiseNot() { return !value; }
 
+	// get the shared instance for a value (booleans are immutable so one instance per value will do)
+	static OtBoolean getShared(bool value);
+
 	// get type definition
 	static OtType getMeta();
 
@@ -29,7 +29,7 @@ OtObject OtBoundFunctionClass::operator()(size_t count, [[maybe_unused]] OtObjec
 //
 
 OtType OtBoundFunctionClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtBoundFunctionClass>("BoundFunction", OtInternalClass::getMeta());
@@ -30,6 +30,10 @@ public:
 	// call bound function
 	OtObject operator()(size_t count, OtObject* parameters) override;
 
+	// cycle collector support
+	inline void traverse(OtObjectTraverser& traverser) override { OtInternalClass::traverse(traverser); traverser(object); traverser(function); }
+	inline void clearReferences() override { OtInternalClass::clearReferences(); object = nullptr; function = nullptr; }
+
 	// get type definition
 	static OtType getMeta();
 
@@ -28,7 +28,7 @@ OtObject OtFunctionClass::operator()(size_t count, OtObject* parameters) {
 		}
 	}
 
-	return caller(count, parameters);
+	return thunk(storage, count, parameters);
 }
 
 
@@ -37,10 +37,11 @@ OtObject OtFunctionClass::operator()(size_t count, OtObject* parameters) {
 //
 
 OtType OtFunctionClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtFunctionClass>("Function", OtPrimitiveClass::getMeta());
+		type->setAcyclic();
 		type->set("__call__", OtFunction::create(&OtFunctionClass::operator()));
 	}
 
@@ -12,7 +12,12 @@
 //	Include files
 //
 
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 
 #include "OtPrimitive.h"
@@ -28,136 +33,42 @@ using OtFunction = OtObjectPointer<OtFunctionClass>;
 
 class OtFunctionClass : public OtPrimitiveClass {
 public:
-	template <typename Args, std::size_t... I>
-	static inline auto functionArgs(OtObject* parameters, std::index_sequence<I...>) {
-		return std::make_tuple(OtValue<std::tuple_element_t<I, Args>>::decode(parameters[I])...);
-	}
-
-	template<typename ...Args>
-	inline OtFunctionClass(void (*function)(Args...)) {
-		caller = [function]([[maybe_unused]] size_t count, OtObject* parameters) {
-			std::apply(
-				function,
-				functionArgs<typename std::tuple<Args...>>(
-					parameters,
-					std::make_index_sequence<sizeof...(Args)>()));
-
-			return nullptr;
-		};
-
-		parameterCount = sizeof...(Args);
-	}
-
 	template<typename Result, typename ...Args>
 	inline OtFunctionClass(Result (*function)(Args...)) {
-		caller = [function]([[maybe_unused]] size_t count, OtObject* parameters) {
-			return OtValue<Result>::encode(
-				std::apply(
-					function,
-					functionArgs<typename std::tuple<Args...>>(
-						parameters,
-						std::make_index_sequence<sizeof...(Args)>())));
-		};
-
-		parameterCount = sizeof...(Args);
-	}
-
-	template<typename ...Args>
-	inline OtFunctionClass(std::function<void(Args...)> function) {
-		caller = [function]([[maybe_unused]] size_t count, OtObject* parameters) {
-			std::apply(function,
-				functionArgs<typename std::tuple<Args...>>(
-					parameters,
-					std::make_index_sequence<sizeof...(Args)>()));
-
-			return nullptr;
-		};
-
+		bind(function, &callFunction<decltype(function), Result, Args...>);
 		parameterCount = sizeof...(Args);
 	}
 
 	template<typename Result, typename ...Args>
 	inline OtFunctionClass(std::function<Result(Args...)> function) {
-		caller = [function]([[maybe_unused]] size_t count, OtObject* parameters) {
-			return OtValue<Result>::encode(
-				std::apply(
-					function,
-					functionArgs<typename std::tuple<Args...>>(
-						parameters,
-						std::make_index_sequence<sizeof...(Args)>())));
-		};
-
+		// function objects can carry state so they live on the heap
+		auto holder = std::make_shared<std::function<Result(Args...)>>(std::move(function));
+		bind(holder.get(), &callFunctionObject<std::function<Result(Args...)>, Result, Args...>);
+		state = holder;
 		parameterCount = sizeof...(Args);
 	}
 
 	template<typename Class>
 	inline OtFunctionClass(void (Class::*method)(size_t, OtObject*)) {
-		caller = [method](size_t count, OtObject* parameters) {
-			OtObjectPointer<Class> object = parameters[0];
-			((*object).*method)(count - 1, parameters + 1);
-			return nullptr;
-		};
-
+		bind(method, &callRawMethod<Class, void>);
 		parameterCount = SIZE_MAX;
 	}
 
 	template<typename Class>
 	inline OtFunctionClass(OtObject (Class::*method)(size_t, OtObject*)) {
-		caller = [method](size_t count, OtObject* parameters) {
-			OtObjectPointer<Class> object = parameters[0];
-			return ((*object).*method)(count - 1, parameters + 1);
-		};
-
+		bind(method, &callRawMethod<Class, OtObject>);
 		parameterCount = SIZE_MAX;
 	}
 
-	template <typename Class, typename Args, std::size_t... I>
-	static inline auto methodArgs(OtObject* parameters, std::index_sequence<I...>) {
-		return std::make_tuple(
-			OtObjectPointer<Class>(parameters[0]),
-			OtValue<std::tuple_element_t<I, Args>>::decode(parameters[I + 1])...);
-	}
-
-	template<typename Class, typename ...Args>
-	inline OtFunctionClass(void (Class::*method)(Args...)) {
-		caller = [method]([[maybe_unused]] size_t count, OtObject* parameters) {
-			std::apply(
-				method,
-				methodArgs<Class, typename std::tuple<Args...>>(
-					parameters,
-					std::make_index_sequence<sizeof...(Args)>()));
-
-			return nullptr;
-		};
-
-		parameterCount = sizeof...(Args) + 1;
-	}
-
 	template<typename Class, typename Result, typename ...Args>
 	inline OtFunctionClass(Result (Class::*method)(Args...)) {
-		caller = [method]([[maybe_unused]] size_t count, OtObject* parameters) {
-			return OtValue<Result>::encode(
-				std::apply(
-					method,
-					methodArgs<Class, typename std::tuple<Args...>>(
-						parameters,
-						std::make_index_sequence<sizeof...(Args)>())));
-		};
-
+		bind(method, &callMethod<Class, decltype(method), Result, Args...>);
 		parameterCount = sizeof...(Args) + 1;
 	}
 
 	template<typename Class, typename Result, typename ...Args>
 	inline OtFunctionClass(Result (Class::*method)(Args...) const) {
-		caller = [method]([[maybe_unused]] size_t count, OtObject* parameters) {
-			return OtValue<Result>::encode(
-				std::apply(
-					method,
-					methodArgs<Class, typename std::tuple<Args...>>(
-						parameters,
-						std::make_index_sequence<sizeof...(Args)>())));
-		};
-
+		bind(method, &callMethod<Class, decltype(method), Result, Args...>);
 		parameterCount = sizeof...(Args) + 1;
 	}
 
@@ -176,24 +87,123 @@ protected:
 	OtFunctionClass() = default;
 
 	inline OtFunctionClass(void (*function)(size_t, OtObject*)) {
-		caller = [function](size_t count, OtObject* parameters) {
-			function(count, parameters);
-			return nullptr;
-		};
-
+		bind(function, &callRawFunction<void>);
 		parameterCount = SIZE_MAX;
 	}
 
 	inline OtFunctionClass(OtObject (*function)(size_t, OtObject*)) {
-		caller = [function](size_t count, OtObject* parameters) {
-			return function(count, parameters);
-		};
-
+		bind(function, &callRawFunction<OtObject>);
 		parameterCount = SIZE_MAX;
 	}
 
 private:
+	// a thunk is generated for every bound signature and calls the target directly
+	// (the target is a function or method pointer stored in this object)
+	using Thunk = OtObject (*)(const void* target, size_t count, OtObject* parameters);
+
+	template <typename Target>
+	inline void bind(Target target, Thunk t) {
+		static_assert(sizeof(Target) <= sizeof(storage), "Function target is too large");
+		static_assert(std::is_trivially_copyable_v<Target>, "Function target must be trivially copyable");
+		std::memcpy(storage, &target, sizeof(Target));
+		thunk = t;
+	}
+
+	template <typename Target>
+	static inline Target getTarget(const void* storage) {
+		Target target;
+		std::memcpy(&target, storage, sizeof(Target));
+		return target;
+	}
+
+	// invoke a callable with decoded arguments and encode its result
+	template <typename Result, typename Args, typename Callable, std::size_t... I>
+	static inline OtObject invoke(Callable&& callable, OtObject* parameters, std::index_sequence<I...>) {
+		[[maybe_unused]] Args arguments{parameters[I]...};
+
+		if constexpr (std::is_void_v<Result>) {
+			callable(std::get<I>(arguments).get()...);
+			return nullptr;
+
+		} else {
+			return OtValue<Result>::encode(callable(std::get<I>(arguments).get()...));
+		}
+	}
+
+	// get the target object of a method call
+	template <typename Class>
+	static inline Class* getInstance(OtObject& object) {
+		auto instance = dynamic_cast<Class*>(object.raw());
+
+		if (!instance) {
+			OtLogError("Method called on an instance of the wrong class [{}]", object.getTypeName());
+		}
+
+		return instance;
+	}
+
+	// the thunks
+	template <typename Function, typename Result, typename ...Args>
+	static OtObject callFunction(const void* target, size_t, OtObject* parameters) {
+		auto function = getTarget<Function>(target);
+
+		return invoke<Result, std::tuple<OtArgument<Args>...>>(
+			function,
+			parameters,
+			std::make_index_sequence<sizeof...(Args)>());
+	}
+
+	template <typename Function, typename Result, typename ...Args>
+	static OtObject callFunctionObject(const void* target, size_t, OtObject* parameters) {
+		auto function = getTarget<const Function*>(target);
+
+		return invoke<Result, std::tuple<OtArgument<Args>...>>(
+			*function,
+			parameters,
+			std::make_index_sequence<sizeof...(Args)>());
+	}
+
+	template <typename Class, typename Method, typename Result, typename ...Args>
+	static OtObject callMethod(const void* target, size_t, OtObject* parameters) {
+		auto method = getTarget<Method>(target);
+		auto object = getInstance<Class>(parameters[0]);
+
+		return invoke<Result, std::tuple<OtArgument<Args>...>>(
+			[object, method](auto&&... args) -> decltype(auto) { return (object->*method)(std::forward<decltype(args)>(args)...); },
+			parameters + 1,
+			std::make_index_sequence<sizeof...(Args)>());
+	}
+
+	template <typename Result>
+	static OtObject callRawFunction(const void* target, size_t count, OtObject* parameters) {
+		auto function = getTarget<Result (*)(size_t, OtObject*)>(target);
+
+		if constexpr (std::is_void_v<Result>) {
+			function(count, parameters);
+			return nullptr;
+
+		} else {
+			return function(count, parameters);
+		}
+	}
+
+	template <typename Class, typename Result>
+	static OtObject callRawMethod(const void* target, size_t count, OtObject* parameters) {
+		auto method = getTarget<Result (Class::*)(size_t, OtObject*)>(target);
+		auto object = getInstance<Class>(parameters[0]);
+
+		if constexpr (std::is_void_v<Result>) {
+			(object->*method)(count - 1, parameters + 1);
+			return nullptr;
+
+		} else {
+			return (object->*method)(count - 1, parameters + 1);
+		}
+	}
+
 	// data
-	std::function<OtObject(size_t, OtObject*)> caller;
+	alignas(std::max_align_t) unsigned char storage[4 * sizeof(void*)];
+	Thunk thunk = nullptr;
+	std::shared_ptr<void> state;
 	size_t parameterCount = 0;
 };
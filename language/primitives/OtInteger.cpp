@@ -18,10 +18,11 @@
 //
 
 OtType OtIntegerClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtIntegerClass>("Integer", OtPrimitiveClass::getMeta());
+		type->setAcyclic();
 
 		type->set("boolean", OtFunction::create(&OtIntegerClass::operator bool));
 		type->set("integer", OtFunction::create(&OtIntegerClass::operator int64_t));
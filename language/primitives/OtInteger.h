@@ -44,6 +44,7 @@ public:
 
 	// comparison
 	inline bool operator==(OtObject operand) override { return value == operand->operator int64_t(); }
+	inline size_t hash() override { return std::hash<int64_t>{}(value); }
 	inline bool operator<(OtObject operand) override { return value < operand->operator int64_t(); }
 
 	inline bool equal(int64_t operand) { return value == operand; }
@@ -92,6 +93,9 @@ protected:
 	OtIntegerClass(int64_t integer) : value(integer) {}
 
 private:
+	// native code reads the value directly
+	friend class OtJit;
+
 	// data
 	int64_t value = 0;
 };
@@ -17,7 +17,7 @@
 //
 
 OtType OtPrimitiveClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtPrimitiveClass>("Primitive", OtObjectClass::getMeta());
@@ -32,10 +32,11 @@ std::string OtRealClass::toFixed(int precision) {
 //
 
 OtType OtRealClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtRealClass>("Real", OtPrimitiveClass::getMeta());
+		type->setAcyclic();
 
 		type->set("boolean", OtFunction::create(&OtRealClass::operator bool));
 		type->set("integer", OtFunction::create(&OtRealClass::operator int64_t));
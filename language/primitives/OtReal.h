@@ -43,6 +43,7 @@ public:
 
 	// comparison
 	inline bool operator==(OtObject operand) override { return value == operand->operator double(); }
+	inline size_t hash() override { return std::hash<double>{}(value); }
 	inline bool operator<(OtObject operand) override { return value < operand->operator double(); }
 
 	inline bool equal(double operand) { return value == operand; }
@@ -106,6 +107,9 @@ protected:
 	OtRealClass(double real) : value(real) {}
 
 private:
+	// native code reads the value directly
+	friend class OtJit;
+
 	// data
 	double value = 0.0;
 };
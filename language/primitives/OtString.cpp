@@ -48,6 +48,7 @@ std::string OtStringClass::setEntry(size_t index, const std::string& string) {
 	}
 
 	value = OtText::set(value, index, string);
+	hashValue = 0;
 	return value;
 }
 
@@ -316,10 +317,11 @@ OtObject OtStringClass::format(size_t count, OtObject* objects) {
 //
 
 OtType OtStringClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtStringClass>("String", OtPrimitiveClass::getMeta());
+		type->setAcyclic();
 
 		type->set("boolean", OtFunction::create(&OtStringClass::operator bool));
 		type->set("integer", OtFunction::create(&OtStringClass::operator int64_t));
@@ -41,11 +41,24 @@ public:
 
 	inline std::string json() override { return OtText::toJSON(value); }
 
+	// access value without copying it (only valid while the string object lives)
+	inline const std::string& getValue() { return value; }
+
+	// get hash of value (cached as string constants are often used as keys)
+	inline size_t getHash() {
+		if (!hashValue) {
+			hashValue = std::hash<std::string>{}(value);
+		}
+
+		return hashValue;
+	}
+
 	// debugging support
 	inline std::string describe() override { return "\"" + (len() > 32 ? left(32) + "...\"" : value) + "\""; }
 
 	// comparison
 	inline bool operator==(OtObject operand) override { return value == operand->operator std::string(); }
+	inline size_t hash() override { return getHash(); }
 	inline bool operator<(OtObject operand) override { return value < operand->operator std::string(); }
 
 	inline bool equal(const std::string& operand) { return value == operand; }
@@ -110,4 +123,5 @@ protected:
 private:
 	// data
 	std::string value = "";
+	size_t hashValue = 0;
 };
@@ -18,7 +18,7 @@
 //
 
 OtType OtStringIteratorClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtStringIteratorClass>("StringIterator", OtIteratorClass::getMeta());
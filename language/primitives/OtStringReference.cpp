@@ -18,7 +18,7 @@
 //
 
 OtType OtStringReferenceClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtStringReferenceClass>("StringReference", OtReferenceClass::getMeta());
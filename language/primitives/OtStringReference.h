@@ -43,6 +43,10 @@ public:
 			value->operator std::string()));
 	}
 
+	// cycle collector support
+	inline void traverse(OtObjectTraverser& traverser) override { OtReferenceClass::traverse(traverser); traverser(string); }
+	inline void clearReferences() override { OtReferenceClass::clearReferences(); string = nullptr; }
+
 	// get type definition
 	static OtType getMeta();
 
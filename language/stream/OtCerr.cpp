@@ -44,7 +44,7 @@ void OtCerrClass::write(const std::string& string) {
 //
 
 OtType OtCerrClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtCerrClass>("Cerr", OtStreamClass::getMeta());
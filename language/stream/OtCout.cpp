@@ -44,7 +44,7 @@ void OtCoutClass::write(const std::string& string) {
 //
 
 OtType OtCoutClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtCoutClass>("Cout", OtStreamClass::getMeta());
@@ -17,7 +17,7 @@
 //
 
 OtType OtStreamClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtStreamClass>("Stream", OtObjectClass::getMeta());
@@ -379,7 +379,7 @@ size_t OtFSClass::available(const std::string& path) {
 //
 
 OtType OtFSClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtFSClass>("FS", OtSystemClass::getMeta());
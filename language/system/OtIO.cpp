@@ -9,15 +9,14 @@
 //	Include files
 //
 
-#include "OtByteCode.h"
-#include "OtCompiler.h"
+#include <fstream>
+
 #include "OtFunction.h"
 #include "OtIO.h"
+#include "OtJson.h"
 #include "OtLog.h"
-#include "OtSource.h"
 #include "OtString.h"
 #include "OtText.h"
-#include "OtVM.h"
 
 
 //
@@ -25,14 +24,16 @@
 //
 
 OtObject OtIOClass::readJSON(const std::string& name) {
-	std::string text;
-	OtText::load(name, text);
+	std::ifstream stream(name, std::ios::binary);
 
-	OtCompiler compiler;
-	OtSource source = OtSourceClass::create(name, text);
-	OtByteCode bytecode = compiler.compileExpression(source);
+	if (stream.fail()) {
+		OtLogError("Can't open file [{}] for reading", name);
+	}
 
-	return OtVM::execute(bytecode);
+	OtJsonParser parser(stream, name);
+	OtJsonBuilder builder;
+	parser.parse(builder);
+	return builder.getResult();
 }
 
 
@@ -41,7 +42,19 @@ OtObject OtIOClass::readJSON(const std::string& name) {
 //
 
 void OtIOClass::writeJSON(const std::string& name, OtObject object) {
-	OtText::save(name, object->json());
+	std::ofstream stream(name, std::ios::binary);
+
+	if (stream.fail()) {
+		OtLogError("Can't open file [{}] for writing", name);
+	}
+
+	OtJsonWriter writer(stream);
+	writer.write(object);
+	writer.flush();
+
+	if (stream.fail()) {
+		OtLogError("Can't write to file [{}]", name);
+	}
 }
 
 
@@ -70,7 +83,7 @@ void OtIOClass::writeText(const std::string& name, OtObject object) {
 //
 
 OtType OtIOClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtIOClass>("IO", OtSystemClass::getMeta());
@@ -0,0 +1,591 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+//
+//	Include files
+//
+
+#include <charconv>
+#include <cstdlib>
+
+#include "OtArray.h"
+#include "OtBoolean.h"
+#include "OtCodePoint.h"
+#include "OtDict.h"
+#include "OtInteger.h"
+#include "OtJson.h"
+#include "OtLog.h"
+#include "OtReal.h"
+#include "OtString.h"
+#include "OtText.h"
+
+
+//
+//	OtJsonParser::parse
+//
+
+void OtJsonParser::parse(OtJsonHandler& handler) {
+	buffer.resize(bufferSize);
+	skipWhitespace();
+	parseValue(handler);
+	skipWhitespace();
+
+	if (peek() >= 0) {
+		error("unexpected data after value");
+	}
+}
+
+
+//
+//	OtJsonParser::fill
+//
+
+bool OtJsonParser::fill() {
+	if (!stream) {
+		return false;
+	}
+
+	// keep track of where we are in the input
+	if (end) {
+		offset += static_cast<size_t>(end - buffer.data());
+	}
+
+	stream.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+	auto size = static_cast<size_t>(stream.gcount());
+	current = buffer.data();
+	end = current + size;
+	return size != 0;
+}
+
+
+//
+//	OtJsonParser::skipWhitespace
+//
+
+void OtJsonParser::skipWhitespace() {
+	while (true) {
+		auto ch = peek();
+
+		if (ch == '\n') {
+			line++;
+			lineStart = position() + 1;
+
+		} else if (ch != ' ' && ch != '\t' && ch != '\r') {
+			return;
+		}
+
+		current++;
+	}
+}
+
+
+//
+//	OtJsonParser::expect
+//
+
+void OtJsonParser::expect(char ch) {
+	if (get() != ch) {
+		error(std::string("expected [") + ch + "]");
+	}
+}
+
+
+//
+//	OtJsonParser::parseValue
+//
+
+void OtJsonParser::parseValue(OtJsonHandler& handler) {
+	switch (peek()) {
+		case '{':
+			parseObject(handler);
+			break;
+
+		case '[':
+			parseArray(handler);
+			break;
+
+		case '"':
+			parseString(text);
+			handler.string(text);
+			break;
+
+		case 't':
+			parseLiteral("true");
+			handler.boolean(true);
+			break;
+
+		case 'f':
+			parseLiteral("false");
+			handler.boolean(false);
+			break;
+
+		case 'n':
+			parseLiteral("null");
+			handler.null();
+			break;
+
+		case '-':
+		case '0': case '1': case '2': case '3': case '4':
+		case '5': case '6': case '7': case '8': case '9':
+			parseNumber(handler);
+			break;
+
+		case -1:
+			error("unexpected end of file");
+			break;
+
+		default:
+			error("unexpected character");
+	}
+}
+
+
+//
+//	OtJsonParser::parseObject
+//
+
+void OtJsonParser::parseObject(OtJsonHandler& handler) {
+	if (++depth > maxDepth) {
+		error("nesting too deep");
+	}
+
+	current++;
+	handler.startObject();
+	skipWhitespace();
+
+	if (peek() == '}') {
+		current++;
+
+	} else {
+		while (true) {
+			if (peek() != '"') {
+				error("expected member name");
+			}
+
+			parseString(text);
+			handler.key(text);
+			skipWhitespace();
+			expect(':');
+			skipWhitespace();
+			parseValue(handler);
+			skipWhitespace();
+
+			auto ch = get();
+
+			if (ch == '}') {
+				break;
+
+			} else if (ch != ',') {
+				error("expected [,] or [}]");
+			}
+
+			skipWhitespace();
+		}
+	}
+
+	handler.endObject();
+	depth--;
+}
+
+
+//
+//	OtJsonParser::parseArray
+//
+
+void OtJsonParser::parseArray(OtJsonHandler& handler) {
+	if (++depth > maxDepth) {
+		error("nesting too deep");
+	}
+
+	current++;
+	handler.startArray();
+	skipWhitespace();
+
+	if (peek() == ']') {
+		current++;
+
+	} else {
+		while (true) {
+			parseValue(handler);
+			skipWhitespace();
+
+			auto ch = get();
+
+			if (ch == ']') {
+				break;
+
+			} else if (ch != ',') {
+				error("expected [,] or []]");
+			}
+
+			skipWhitespace();
+		}
+	}
+
+	handler.endArray();
+	depth--;
+}
+
+
+//
+//	OtJsonParser::parseString
+//
+
+void OtJsonParser::parseString(std::string& value) {
+	value.clear();
+	current++;
+
+	while (true) {
+		// copy runs of plain characters in one go
+		if (current == end && !fill()) {
+			error("unterminated string");
+		}
+
+		auto start = current;
+
+		while (current < end && *current != '"' && *current != '\\' && static_cast<unsigned char>(*current) >= 0x20) {
+			current++;
+		}
+
+		value.append(start, current);
+
+		if (current == end) {
+			continue;
+		}
+
+		// control characters must be escaped
+		if (static_cast<unsigned char>(*current) < 0x20) {
+			error("control character in string");
+		}
+
+		auto ch = *current++;
+
+		if (ch == '"') {
+			return;
+
+		} else {
+			switch (get()) {
+				case '"': value.push_back('"'); break;
+				case '\\': value.push_back('\\'); break;
+				case '/': value.push_back('/'); break;
+				case 'b': value.push_back('\b'); break;
+				case 'f': value.push_back('\f'); break;
+				case 'n': value.push_back('\n'); break;
+				case 'r': value.push_back('\r'); break;
+				case 't': value.push_back('\t'); break;
+
+				case 'u': {
+					auto codepoint = parseHex();
+
+					// surrogates are only valid as a high/low pair (which is combined into one code point)
+					if (codepoint >= 0xdc00 && codepoint <= 0xdfff) {
+						error("unpaired surrogate");
+
+					} else if (codepoint >= 0xd800 && codepoint <= 0xdbff) {
+						if (get() != '\\' || get() != 'u') {
+							error("unpaired surrogate");
+						}
+
+						auto low = parseHex();
+
+						if (low < 0xdc00 || low > 0xdfff) {
+							error("unpaired surrogate");
+						}
+
+						codepoint = 0x10000 + ((codepoint - 0xd800) << 10) + (low - 0xdc00);
+					}
+
+					std::string utf8(4, 0);
+					auto last = OtCodePoint::write(utf8.begin(), codepoint);
+					value.append(utf8.begin(), last);
+					break;
+				}
+
+				default:
+					error("invalid escape sequence");
+			}
+		}
+	}
+}
+
+
+//
+//	OtJsonParser::parseNumber
+//
+
+void OtJsonParser::parseNumber(OtJsonHandler& handler) {
+	// collect the characters of the number (-?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?)
+	char number[64];
+	size_t size = 0;
+	bool isReal = false;
+
+	if (peek() == '-') {
+		number[size++] = static_cast<char>(get());
+	}
+
+	// leading zeros are not allowed
+	if (peek() == '0') {
+		number[size++] = static_cast<char>(get());
+
+		if (peek() >= '0' && peek() <= '9') {
+			error("leading zero in number");
+		}
+
+	} else {
+		parseDigits(number, size, sizeof(number));
+	}
+
+	if (peek() == '.') {
+		isReal = true;
+		number[size++] = static_cast<char>(get());
+		parseDigits(number, size, sizeof(number));
+	}
+
+	if (peek() == 'e' || peek() == 'E') {
+		isReal = true;
+		number[size++] = static_cast<char>(get());
+
+		if (peek() == '+' || peek() == '-') {
+			number[size++] = static_cast<char>(get());
+		}
+
+		parseDigits(number, size, sizeof(number));
+	}
+
+	number[size] = 0;
+
+	// integers that don't fit are treated as reals
+	if (!isReal) {
+		int64_t value;
+		auto [last, status] = std::from_chars(number, number + size, value);
+
+		if (status == std::errc() && last == number + size) {
+			handler.integer(value);
+			return;
+
+		} else if (status != std::errc::result_out_of_range) {
+			error("invalid number");
+		}
+	}
+
+	char* last;
+	auto value = std::strtod(number, &last);
+
+	if (last != number + size) {
+		error("invalid number");
+	}
+
+	handler.real(value);
+}
+
+
+//
+//	OtJsonParser::parseDigits
+//
+
+void OtJsonParser::parseDigits(char* number, size_t& size, size_t capacity) {
+	// there must be at least one digit (and room for the rest of the number)
+	if (peek() < '0' || peek() > '9') {
+		error("expected digit in number");
+	}
+
+	while (peek() >= '0' && peek() <= '9') {
+		if (size >= capacity - 4) {
+			error("number too long");
+		}
+
+		number[size++] = static_cast<char>(get());
+	}
+}
+
+
+//
+//	OtJsonParser::parseLiteral
+//
+
+void OtJsonParser::parseLiteral(const char* literal) {
+	for (auto c = literal; *c; c++) {
+		if (get() != *c) {
+			error("invalid literal");
+		}
+	}
+}
+
+
+//
+//	OtJsonParser::parseHex
+//
+
+char32_t OtJsonParser::parseHex() {
+	char32_t value = 0;
+
+	for (auto i = 0; i < 4; i++) {
+		auto ch = get();
+		value <<= 4;
+
+		if (ch >= '0' && ch <= '9') {
+			value |= ch - '0';
+
+		} else if (ch >= 'a' && ch <= 'f') {
+			value |= ch - 'a' + 10;
+
+		} else if (ch >= 'A' && ch <= 'F') {
+			value |= ch - 'A' + 10;
+
+		} else {
+			error("invalid unicode escape");
+		}
+	}
+
+	return value;
+}
+
+
+//
+//	OtJsonParser::error
+//
+
+void OtJsonParser::error(const std::string& message) {
+	OtLogError("Invalid JSON in [{}] at line [{}], column [{}]: {}", name, line, position() - lineStart + 1, message);
+}
+
+
+//
+//	OtJsonBuilder::add
+//
+
+void OtJsonBuilder::add(OtObject value) {
+	if (stack.empty()) {
+		result = value;
+
+	} else {
+		auto& container = stack.back();
+
+		if (container.isObject) {
+			OtDict(container.object)->setEntry(container.key, value);
+
+		} else {
+			OtArray(container.object)->append(value);
+		}
+	}
+}
+
+
+//
+//	OtJsonBuilder event handlers
+//
+
+void OtJsonBuilder::null() {
+	add(OtObject::create());
+}
+
+void OtJsonBuilder::boolean(bool value) {
+	add(OtBooleanClass::getShared(value));
+}
+
+void OtJsonBuilder::integer(int64_t value) {
+	add(OtInteger::create(value));
+}
+
+void OtJsonBuilder::real(double value) {
+	add(OtReal::create(value));
+}
+
+void OtJsonBuilder::string(std::string& value) {
+	add(OtString::create(value));
+}
+
+void OtJsonBuilder::startObject() {
+	stack.push_back(Container{OtDict::create(), "", true});
+}
+
+void OtJsonBuilder::key(std::string& name) {
+	stack.back().key.swap(name);
+}
+
+void OtJsonBuilder::endObject() {
+	auto object = stack.back().object;
+	stack.pop_back();
+	add(object);
+}
+
+void OtJsonBuilder::startArray() {
+	stack.push_back(Container{OtArray::create(), "", false});
+}
+
+void OtJsonBuilder::endArray() {
+	auto object = stack.back().object;
+	stack.pop_back();
+	add(object);
+}
+
+
+//
+//	OtJsonWriter::write
+//
+
+void OtJsonWriter::write(OtObject object) {
+	if (object.isKindOf<OtArrayClass>()) {
+		buffer.push_back('[');
+		bool first = true;
+
+		for (auto& entry : OtArray(object)->raw()) {
+			if (first) {
+				first = false;
+
+			} else {
+				buffer.push_back(',');
+			}
+
+			write(entry);
+		}
+
+		buffer.push_back(']');
+
+	} else if (object.isKindOf<OtDictClass>()) {
+		buffer.push_back('{');
+		bool first = true;
+
+		OtDict(object)->each([&](const std::string& name, OtObject& entry) {
+			if (first) {
+				first = false;
+
+			} else {
+				buffer.push_back(',');
+			}
+
+			OtText::toJSON(buffer, name);
+			buffer.push_back(':');
+			write(entry);
+		});
+
+		buffer.push_back('}');
+
+	} else if (object.isKindOf<OtStringClass>()) {
+		OtText::toJSON(buffer, OtString(object)->getValue());
+
+	} else if (!object || object->getType() == OtObjectClass::getMeta()) {
+		buffer.append("null");
+
+	} else {
+		buffer.append(object->json());
+	}
+
+	if (buffer.size() >= bufferSize) {
+		flush();
+	}
+}
+
+
+//
+//	OtJsonWriter::flush
+//
+
+void OtJsonWriter::flush() {
+	stream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+	buffer.clear();
+}
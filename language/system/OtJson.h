@@ -0,0 +1,186 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+#pragma once
+
+
+//
+//	Include files
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "OtObject.h"
+
+
+//
+//	OtJsonHandler
+//
+//	Receives the events generated by the JSON parser.
+//
+
+class OtJsonHandler {
+public:
+	// destructor
+	virtual ~OtJsonHandler() = default;
+
+	// scalar values
+	virtual void null() = 0;
+	virtual void boolean(bool value) = 0;
+	virtual void integer(int64_t value) = 0;
+	virtual void real(double value) = 0;
+	virtual void string(std::string& value) = 0;
+
+	// objects and arrays
+	virtual void startObject() = 0;
+	virtual void key(std::string& name) = 0;
+	virtual void endObject() = 0;
+	virtual void startArray() = 0;
+	virtual void endArray() = 0;
+};
+
+
+//
+//	OtJsonParser
+//
+//	Event based JSON parser that reads its input from a stream in chunks
+//	so documents don't have to be loaded in memory first.
+//
+
+class OtJsonParser {
+public:
+	// constructor
+	OtJsonParser(std::istream& s, const std::string& n) : stream(s), name(n) {}
+
+	// parse a single JSON document
+	void parse(OtJsonHandler& handler);
+
+private:
+	// input buffer
+	static constexpr size_t bufferSize = 64 * 1024;
+	static constexpr size_t maxDepth = 512;
+
+	std::istream& stream;
+	std::string name;
+	std::vector<char> buffer;
+	const char* current = nullptr;
+	const char* end = nullptr;
+	size_t line = 1;
+	size_t lineStart = 0;
+	size_t offset = 0;
+	size_t depth = 0;
+	std::string text;
+
+	// access input
+	bool fill();
+
+	inline int peek() {
+		return (current < end || fill()) ? static_cast<unsigned char>(*current) : -1;
+	}
+
+	inline int get() {
+		auto ch = peek();
+
+		if (ch >= 0) {
+			current++;
+		}
+
+		return ch;
+	}
+
+	// get the position in the input (for error messages)
+	inline size_t position() { return offset + static_cast<size_t>(current - buffer.data()); }
+
+	void skipWhitespace();
+	void expect(char ch);
+
+	// parse elements
+	void parseValue(OtJsonHandler& handler);
+	void parseObject(OtJsonHandler& handler);
+	void parseArray(OtJsonHandler& handler);
+	void parseString(std::string& value);
+	void parseNumber(OtJsonHandler& handler);
+	void parseDigits(char* number, size_t& size, size_t capacity);
+	void parseLiteral(const char* literal);
+	char32_t parseHex();
+
+	// report an error (raises an exception)
+	void error(const std::string& message);
+};
+
+
+//
+//	OtJsonBuilder
+//
+//	Handler that turns parser events into ObjectTalk objects.
+//
+
+class OtJsonBuilder : public OtJsonHandler {
+public:
+	// event handlers
+	void null() override;
+	void boolean(bool value) override;
+	void integer(int64_t value) override;
+	void real(double value) override;
+	void string(std::string& value) override;
+
+	void startObject() override;
+	void key(std::string& name) override;
+	void endObject() override;
+	void startArray() override;
+	void endArray() override;
+
+	// get the resulting object
+	inline OtObject getResult() { return result; }
+
+private:
+	// add a value to the current container (or make it the result)
+	void add(OtObject value);
+
+	// containers under construction
+	struct Container {
+		OtObject object;
+		std::string key;
+		bool isObject;
+	};
+
+	std::vector<Container> stack;
+	OtObject result;
+};
+
+
+//
+//	OtJsonWriter
+//
+//	Writes objects as JSON to a stream without building the whole document
+//	in memory first.
+//
+
+class OtJsonWriter {
+public:
+	// constructor/destructor
+	OtJsonWriter(std::ostream& s) : stream(s) {}
+	~OtJsonWriter() { flush(); }
+
+	// write an object
+	void write(OtObject object);
+
+	// write the buffered output to the stream
+	void flush();
+
+private:
+	// output buffer
+	static constexpr size_t bufferSize = 64 * 1024;
+
+	std::ostream& stream;
+	std::string buffer;
+};
@@ -19,10 +19,12 @@
 #include <random>
 
 #include "OtArray.h"
+#include "OtCycleCollector.h"
 #include "OtDict.h"
 #include "OtFunction.h"
 #include "OtLibuv.h"
 #include "OtOS.h"
+#include "OtSlabAllocator.h"
 
 
 //
@@ -171,6 +173,69 @@ int64_t OtOSClass::freeMemory() {
 }
 
 
+//
+//	OtOSClass::heapStatistics
+//
+
+OtObject OtOSClass::heapStatistics() {
+	auto statistics = OtSlabAllocator::getStatistics();
+	OtDict result = OtDict::create();
+	result->setEntry("blocks", OtInteger::create(static_cast<int64_t>(statistics.liveBlocks)));
+	result->setEntry("bytes", OtInteger::create(static_cast<int64_t>(statistics.liveBytes)));
+	result->setEntry("largeBlocks", OtInteger::create(static_cast<int64_t>(statistics.largeBlocks)));
+	result->setEntry("largeBytes", OtInteger::create(static_cast<int64_t>(statistics.largeBytes)));
+	result->setEntry("slabs", OtInteger::create(static_cast<int64_t>(statistics.slabs)));
+	result->setEntry("slabBytes", OtInteger::create(static_cast<int64_t>(statistics.slabBytes)));
+
+	OtDict types = OtDict::create();
+	int64_t typeCount = 0;
+
+	OtType::each([&](OtType type) {
+		auto count = type->getInstanceCount();
+		typeCount++;
+
+		if (count) {
+			// every thread has its own types so counts are added up by name
+			auto name = type->getName();
+			auto previous = types->contains(name) ? types->getEntry(name)->operator int64_t() : 0;
+			types->setEntry(name, OtInteger::create(previous + static_cast<int64_t>(count)));
+		}
+	});
+
+	result->setEntry("types", types);
+	result->setEntry("typeCount", OtInteger::create(typeCount));
+	return result;
+}
+
+
+//
+//	OtOSClass::collectCycles
+//
+
+int64_t OtOSClass::collectCycles() {
+	return static_cast<int64_t>(OtCycleCollector::collect());
+}
+
+
+//
+//	OtOSClass::cycleStatistics
+//
+
+OtObject OtOSClass::cycleStatistics() {
+	auto statistics = OtCycleCollector::getStatistics();
+	OtDict result = OtDict::create();
+	result->setEntry("candidates", OtInteger::create(static_cast<int64_t>(statistics.candidates)));
+	result->setEntry("collections", OtInteger::create(static_cast<int64_t>(statistics.collections)));
+	result->setEntry("slices", OtInteger::create(static_cast<int64_t>(statistics.slices)));
+	result->setEntry("cycles", OtInteger::create(static_cast<int64_t>(statistics.cyclesCollected)));
+	result->setEntry("objects", OtInteger::create(static_cast<int64_t>(statistics.objectsCollected)));
+	result->setEntry("lastPause", OtReal::create(statistics.lastPause));
+	result->setEntry("maxPause", OtReal::create(statistics.maxPause));
+	result->setEntry("totalPause", OtReal::create(statistics.totalPause));
+	return result;
+}
+
+
 //
 //	OtOSClass::uuid
 //
@@ -415,7 +480,7 @@ void OtOSClass::stopServer() {
 //
 
 OtType OtOSClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtOSClass>("OS", OtSystemClass::getMeta());
@@ -438,6 +503,9 @@ OtType OtOSClass::getMeta() {
 
 		type->set("totalMemory", OtFunction::create(&OtOSClass::totalMemory));
 		type->set("freeMemory", OtFunction::create(&OtOSClass::freeMemory));
+		type->set("heapStatistics", OtFunction::create(&OtOSClass::heapStatistics));
+		type->set("collectCycles", OtFunction::create(&OtOSClass::collectCycles));
+		type->set("cycleStatistics", OtFunction::create(&OtOSClass::cycleStatistics));
 
 		type->set("clock", OtFunction::create(&OtOSClass::clock));
 		type->set("sleep", OtFunction::create(&OtOSClass::sleep));
@@ -52,6 +52,13 @@ public:
 	int64_t totalMemory();
 	int64_t freeMemory();
 
+	// get object heap statistics (live instances per type, bytes and slabs)
+	OtObject heapStatistics();
+
+	// cycle collector
+	int64_t collectCycles();
+	OtObject cycleStatistics();
+
 	// generate a UUID
 	std::string uuid();
 
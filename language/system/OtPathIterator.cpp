@@ -18,7 +18,7 @@
 //
 
 OtType OtPathIteratorClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtPathIteratorClass>("PathIterator", OtIteratorClass::getMeta());
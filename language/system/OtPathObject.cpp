@@ -45,7 +45,7 @@ OtObject OtPathObjectClass::iterate() {
 //
 
 OtType OtPathObjectClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtPathObjectClass>("Path", OtSystemClass::getMeta());
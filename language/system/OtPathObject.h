@@ -43,6 +43,7 @@ public:
 
 	// operators
 	inline bool operator==(OtObject operand) override { return path == operand->operator std::string(); }
+	inline size_t hash() override { return std::filesystem::hash_value(path); }
 	inline bool operator<(OtObject operand) override { return path < operand->operator std::string(); }
 
 	inline OtObject join(OtObject operand) { return OtPathObject::create(path / operand->operator std::string()); }
@@ -0,0 +1,265 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+//
+//	Include files
+//
+
+#include <algorithm>
+#include <cstring>
+
+#include "OtArray.h"
+#include "OtBoolean.h"
+#include "OtDict.h"
+#include "OtInteger.h"
+#include "OtLog.h"
+#include "OtReal.h"
+#include "OtSet.h"
+#include "OtString.h"
+#include "OtStructuredClone.h"
+
+
+//
+//	Limits
+//
+
+static constexpr size_t maxDepth = 512;
+
+
+//
+//	OtStructuredClone::OtStructuredClone
+//
+
+OtStructuredClone::OtStructuredClone(OtObject object, OtObject transfer) {
+	// determine which typed arrays give up their storage
+	Context context;
+
+	if (transfer) {
+		if (!transfer.isKindOf<OtArrayClass>()) {
+			OtLogError("Transfer list must be an [Array], not a [{}]", transfer.getTypeName());
+		}
+
+		for (auto& entry : OtArray(transfer)->raw()) {
+			if (!entry.isKindOf<OtTypedArrayClass>()) {
+				OtLogError("Only typed arrays can be transferred, not a [{}]", entry.getTypeName());
+			}
+
+			context.transferList.push_back(entry.raw());
+		}
+	}
+
+	// convert the object graph
+	serialize(object, context);
+
+	// arrays are only emptied once the whole graph could be converted
+	for (auto& [node, array] : context.transfers) {
+		nodes[node].storage = array->detach();
+	}
+}
+
+
+//
+//	OtStructuredClone::deserialize
+//
+
+OtObject OtStructuredClone::deserialize() {
+	std::vector<OtObject> containers;
+	size_t position = 0;
+	return rebuild(position, containers);
+}
+
+
+//
+//	OtStructuredClone::serialize
+//
+
+void OtStructuredClone::serialize(OtObject& object, Context& context) {
+	if (++context.depth > maxDepth) {
+		OtLogError("Object graph is nested too deeply to send to another thread");
+	}
+
+	if (!object || object->getType() == OtObjectClass::getMeta()) {
+		nodes.emplace_back().kind = Kind::null;
+
+	} else if (object.isKindOf<OtBooleanClass>()) {
+		auto& node = nodes.emplace_back();
+		node.kind = Kind::boolean;
+		node.integer = object->operator bool();
+
+	} else if (object.isKindOf<OtIntegerClass>()) {
+		auto& node = nodes.emplace_back();
+		node.kind = Kind::integer;
+		node.integer = object->operator int64_t();
+
+	} else if (object.isKindOf<OtRealClass>()) {
+		auto& node = nodes.emplace_back();
+		node.kind = Kind::real;
+		node.real = object->operator double();
+
+	} else if (object.isKindOf<OtStringClass>()) {
+		auto& node = nodes.emplace_back();
+		node.kind = Kind::string;
+		node.string = OtString(object)->getValue();
+
+	} else if (object.isKindOf<OtArrayClass>()) {
+		if (!isDuplicate(object, context)) {
+			auto& array = OtArray(object)->raw();
+			auto& node = nodes.emplace_back();
+			node.kind = Kind::array;
+			node.integer = static_cast<int64_t>(array.size());
+
+			for (auto& entry : array) {
+				serialize(entry, context);
+			}
+		}
+
+	} else if (object.isKindOf<OtDictClass>()) {
+		if (!isDuplicate(object, context)) {
+			auto dict = OtDict(object);
+			auto& node = nodes.emplace_back();
+			node.kind = Kind::dict;
+			node.integer = static_cast<int64_t>(dict->size());
+
+			// keys are stored in the member nodes
+			dict->each([&](const std::string& name, OtObject& value) {
+				auto key = nodes.size();
+				serialize(value, context);
+				nodes[key].key = name;
+			});
+		}
+
+	} else if (object.isKindOf<OtSetClass>()) {
+		if (!isDuplicate(object, context)) {
+			auto& members = OtSet(object)->raw();
+			auto& node = nodes.emplace_back();
+			node.kind = Kind::set;
+			node.integer = static_cast<int64_t>(members.size());
+
+			for (auto& member : members) {
+				serialize(member, context);
+			}
+		}
+
+	} else if (object.isKindOf<OtTypedArrayClass>()) {
+		if (!isDuplicate(object, context)) {
+			auto array = OtTypedArray(object);
+			auto& node = nodes.emplace_back();
+			node.kind = Kind::typedArray;
+			node.integer = static_cast<int64_t>(array->size());
+			node.elementType = array->getElementType();
+
+			if (std::find(context.transferList.begin(), context.transferList.end(), object.raw()) != context.transferList.end()) {
+				context.transfers.emplace_back(nodes.size() - 1, array);
+
+			} else {
+				auto size = array->size() * array->getElementSize();
+				std::shared_ptr<uint8_t[]> copy(new uint8_t[size]);
+				std::memcpy(copy.get(), array->getRawData(), size);
+				node.storage = copy;
+			}
+		}
+
+	} else {
+		OtLogError("Can't send a [{}] to another thread", object.getTypeName());
+	}
+
+	context.depth--;
+}
+
+
+//
+//	OtStructuredClone::isDuplicate
+//
+
+bool OtStructuredClone::isDuplicate(OtObject& object, Context& context) {
+	auto [entry, inserted] = context.containers.try_emplace(object.raw(), context.containers.size());
+
+	if (inserted) {
+		return false;
+
+	} else {
+		auto& node = nodes.emplace_back();
+		node.kind = Kind::reference;
+		node.integer = static_cast<int64_t>(entry->second);
+		return true;
+	}
+}
+
+
+//
+//	OtStructuredClone::rebuild
+//
+
+OtObject OtStructuredClone::rebuild(size_t& position, std::vector<OtObject>& containers) {
+	auto& node = nodes[position++];
+
+	switch (node.kind) {
+		case Kind::null:
+			return OtObject::create();
+
+		case Kind::boolean:
+			return OtBooleanClass::getShared(node.integer != 0);
+
+		case Kind::integer:
+			return OtInteger::create(node.integer);
+
+		case Kind::real:
+			return OtReal::create(node.real);
+
+		case Kind::string:
+			return OtString::create(node.string);
+
+		case Kind::array: {
+			// register containers before their members are created so references can be resolved
+			auto array = OtArray::create();
+			containers.emplace_back(array);
+			auto& entries = array->raw();
+			entries.reserve(static_cast<size_t>(node.integer));
+
+			for (int64_t i = 0; i < node.integer; i++) {
+				entries.emplace_back(rebuild(position, containers));
+			}
+
+			return array;
+		}
+
+		case Kind::dict: {
+			auto dict = OtDict::create();
+			containers.emplace_back(dict);
+			dict->reserve(static_cast<size_t>(node.integer));
+
+			for (int64_t i = 0; i < node.integer; i++) {
+				auto& key = nodes[position].key;
+				dict->setEntry(key, rebuild(position, containers));
+			}
+
+			return dict;
+		}
+
+		case Kind::set: {
+			auto set = OtSet::create();
+			containers.emplace_back(set);
+
+			for (int64_t i = 0; i < node.integer; i++) {
+				set->insert(rebuild(position, containers));
+			}
+
+			return set;
+		}
+
+		case Kind::typedArray: {
+			auto array = OtTypedArrayClass::adopt(node.elementType, std::move(node.storage), static_cast<size_t>(node.integer));
+			containers.emplace_back(array);
+			return array;
+		}
+
+		case Kind::reference:
+			return containers[static_cast<size_t>(node.integer)];
+	}
+
+	return nullptr;
+}
@@ -0,0 +1,87 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+#pragma once
+
+
+//
+//	Include files
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "OtObject.h"
+#include "OtTypedArray.h"
+
+
+//
+//	OtStructuredClone
+//
+//	Objects can't be shared between threads as their reference counts aren't
+//	atomic. A structured clone is a flat, object free copy of an object graph
+//	that is created on the sending thread and turned back into objects on the
+//	receiving thread. Primitives, strings, arrays, dictionaries, sets and typed
+//	arrays are supported. Containers that are referenced more than once
+//	(including cycles) are recreated once. Typed arrays in the transfer list
+//	hand their storage over instead of being copied (and are empty afterwards).
+//
+
+class OtStructuredClone {
+public:
+	// constructor
+	OtStructuredClone(OtObject object, OtObject transfer=nullptr);
+
+	// recreate the object graph (on the receiving thread)
+	OtObject deserialize();
+
+private:
+	// node types
+	enum class Kind {
+		null,
+		boolean,
+		integer,
+		real,
+		string,
+		array,
+		dict,
+		set,
+		typedArray,
+		reference
+	};
+
+	// nodes are stored in depth first order (containers are followed by their members)
+	struct Node {
+		Kind kind;
+		int64_t integer = 0;
+		double real = 0.0;
+		std::string string;
+		std::string key;
+		OtTypedArrayClass::ElementType elementType = OtTypedArrayClass::ElementType::uint8;
+		std::shared_ptr<void> storage;
+	};
+
+	std::vector<Node> nodes;
+
+	// state while an object graph is serialized
+	struct Context {
+		std::unordered_map<OtObjectClass*, size_t> containers;
+		std::vector<OtObjectClass*> transferList;
+		std::vector<std::pair<size_t, OtTypedArray>> transfers;
+		size_t depth = 0;
+	};
+
+	// convert objects to nodes and back
+	void serialize(OtObject& object, Context& context);
+	bool isDuplicate(OtObject& object, Context& context);
+	OtObject rebuild(size_t& position, std::vector<OtObject>& containers);
+};
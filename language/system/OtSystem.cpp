@@ -17,7 +17,7 @@
 //
 
 OtType OtSystemClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtSystemClass>("System", OtObjectClass::getMeta());
@@ -0,0 +1,459 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+//
+//	Include files
+//
+
+#include "OtCallback.h"
+#include "OtCycleCollector.h"
+#include "OtException.h"
+#include "OtFunction.h"
+#include "OtLog.h"
+#include "OtModule.h"
+#include "OtString.h"
+#include "OtVM.h"
+#include "OtWorker.h"
+
+
+//
+//	OtWorkerChannel::signalWorker
+//
+
+void OtWorkerChannel::signalWorker() {
+	std::lock_guard<std::mutex> lock(mutex);
+
+	if (workerHandle) {
+		uv_async_send(workerHandle);
+	}
+}
+
+
+//
+//	OtWorkerChannel::interruptWorker
+//
+
+void OtWorkerChannel::interruptWorker() {
+	std::lock_guard<std::mutex> lock(mutex);
+
+	if (workerHooks) {
+		OtVM::interrupt(workerHooks);
+	}
+}
+
+
+//
+//	OtWorkerChannel::signalParent
+//
+
+void OtWorkerChannel::signalParent() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		parentSignals++;
+
+		if (parentHandle) {
+			uv_async_send(parentHandle);
+		}
+	}
+
+	signalled.notify_all();
+}
+
+
+//
+//	OtWorkerClass::~OtWorkerClass
+//
+
+OtWorkerClass::~OtWorkerClass() {
+	closeHandle();
+
+	if (thread.joinable()) {
+		terminate();
+		thread.join();
+	}
+}
+
+
+//
+//	OtWorkerClass::init
+//
+
+void OtWorkerClass::init(const std::string& path) {
+	if (channel) {
+		OtLogError("Worker is already started");
+	}
+
+	// modules are resolved relative to the caller
+	auto fullPath = OtModuleClass::getFullPath(path);
+
+	if (fullPath.empty()) {
+		OtLogError("Can't find module [{}]", path);
+	}
+
+	// the async handle delivers the worker's messages on our loop
+	channel = std::make_shared<OtWorkerChannel>();
+	handle = new Handle;
+	handle->worker = this;
+	handle->async.data = handle;
+
+	auto status = uv_async_init(OtLibUv::getLoop(), &handle->async, [](uv_async_t* async) {
+		auto handle = static_cast<Handle*>(async->data);
+
+		if (handle->worker) {
+			handle->worker->receive();
+		}
+	});
+
+	UV_CHECK_ERROR("uv_async_init", status);
+	channel->parentHandle = &handle->async;
+
+	// start the thread
+	thread = std::thread(run, channel, fullPath);
+}
+
+
+//
+//	OtWorkerClass::post
+//
+
+OtObject OtWorkerClass::post(size_t count, OtObject* parameters) {
+	if (count < 1 || count > 2) {
+		OtLogError("Worker post expects [1] or [2] parameters, [{}] given", count);
+	}
+
+	if (!channel || channel->finished) {
+		OtLogError("Can't post a message to a worker that isn't running");
+	}
+
+	channel->inbox.push(std::make_unique<OtStructuredClone>(parameters[0], count == 2 ? parameters[1] : nullptr));
+	channel->signalWorker();
+	return OtObject(this);
+}
+
+
+//
+//	OtWorkerClass::onMessage
+//
+
+OtObject OtWorkerClass::onMessage(OtObject callback) {
+	OtCallbackValidate(callback, 1);
+	messageCallback = callback;
+
+	// deliver messages that arrived before we had a callback
+	if (handle) {
+		uv_async_send(&handle->async);
+	}
+
+	return OtObject(this);
+}
+
+
+//
+//	OtWorkerClass::onError
+//
+
+OtObject OtWorkerClass::onError(OtObject callback) {
+	OtCallbackValidate(callback, 1);
+	errorCallback = callback;
+	return OtObject(this);
+}
+
+
+//
+//	OtWorkerClass::terminate
+//
+
+void OtWorkerClass::terminate() {
+	if (channel) {
+		channel->terminating = true;
+		channel->interruptWorker();
+		channel->signalWorker();
+	}
+}
+
+
+//
+//	OtWorkerClass::wait
+//
+
+void OtWorkerClass::wait() {
+	// callbacks could drop the last reference to the worker
+	OtObject self(this);
+
+	while (thread.joinable()) {
+		{
+			std::unique_lock<std::mutex> lock(channel->mutex);
+
+			channel->signalled.wait(lock, [this]() {
+				return channel->parentSignals != signalsSeen;
+			});
+
+			signalsSeen = channel->parentSignals;
+		}
+
+		receive();
+	}
+}
+
+
+//
+//	OtWorkerClass::receive
+//
+
+void OtWorkerClass::receive() {
+	// callbacks could drop the last reference to the worker
+	OtObject self(this);
+
+	// messages posted before the worker finished are in the queue by now
+	auto finished = channel->finished.load();
+	OtWorkerChannel::Message message;
+
+	while (messageCallback && channel->outbox.pop(message)) {
+		OtVM::callMemberFunction(messageCallback, "__call__", message->deserialize());
+	}
+
+	if (finished) {
+		finish();
+	}
+
+	// report errors
+	std::string error;
+
+	while (channel->errors.pop(error)) {
+		if (errorCallback) {
+			OtVM::callMemberFunction(errorCallback, "__call__", OtString::create(error));
+
+		} else {
+			OtLogError("Error in worker: {}", error);
+		}
+	}
+}
+
+
+//
+//	OtWorkerClass::finish
+//
+
+void OtWorkerClass::finish() {
+	if (thread.joinable()) {
+		thread.join();
+	}
+
+	closeHandle();
+}
+
+
+//
+//	OtWorkerClass::closeHandle
+//
+
+void OtWorkerClass::closeHandle() {
+	if (handle) {
+		{
+			std::lock_guard<std::mutex> lock(channel->mutex);
+			channel->parentHandle = nullptr;
+		}
+
+		// the handle could already be closing if the loop was shut down
+		handle->worker = nullptr;
+
+		if (!uv_is_closing(reinterpret_cast<uv_handle_t*>(&handle->async))) {
+			uv_close(reinterpret_cast<uv_handle_t*>(&handle->async), [](uv_handle_t* async) {
+				delete static_cast<Handle*>(async->data);
+			});
+		}
+
+		handle = nullptr;
+	}
+}
+
+
+//
+//	OtWorkerClass::run
+//
+
+void OtWorkerClass::run(std::shared_ptr<OtWorkerChannel> channel, std::string path) {
+	// no objects outlive the worker so its types can go when the thread ends
+	OtType::releaseAtThreadExit();
+
+	// give this thread its own event loop
+	uv_loop_t loop;
+	uv_loop_init(&loop);
+	OtLibUv::setLoop(&loop);
+	OtCycleCollector::start();
+
+	// messages from the parent wake up the loop (which only waits for them if the module has a callback)
+	uv_async_t inbox;
+
+	uv_async_init(&loop, &inbox, [](uv_async_t* async) {
+		static_cast<OtWorkerPortClass*>(async->data)->receive();
+	});
+
+	uv_unref(reinterpret_cast<uv_handle_t*>(&inbox));
+
+	// the port is kept alive until the handles are closed
+	auto port = OtWorkerPort::create(channel, &inbox);
+	inbox.data = port.raw();
+
+	try {
+		OtVM::getGlobal()->set("parent", port);
+
+		// pick up messages and requests that were sent before we were listening
+		{
+			std::lock_guard<std::mutex> lock(channel->mutex);
+			channel->workerHooks = OtVM::getHooks();
+			channel->workerHandle = &inbox;
+		}
+
+		uv_async_send(&inbox);
+
+		// run the module and its event loop
+		if (!channel->terminating) {
+			auto module = OtModule::create();
+			module->load(path);
+
+			if (!channel->terminating) {
+				OtLibUv::run();
+			}
+		}
+
+	} catch (const std::exception& e) {
+		// a terminated worker was interrupted on purpose
+		if (!channel->terminating) {
+			channel->errors.push(e.what());
+		}
+	}
+
+	// close all handles and release the script objects
+	{
+		std::lock_guard<std::mutex> lock(channel->mutex);
+		channel->workerHooks = nullptr;
+		channel->workerHandle = nullptr;
+	}
+
+	OtLibUv::end();
+	port->handle = nullptr;
+	port = nullptr;
+
+	// drop what the worker's scripts still hold and collect the cycles that leaves behind
+	OtModuleClass::clear();
+	OtVM::clear();
+	OtCycleCollector::end();
+	uv_loop_close(&loop);
+	OtLibUv::setLoop(nullptr);
+
+	// tell the parent we're done
+	channel->finished = true;
+	channel->signalParent();
+}
+
+
+//
+//	OtWorkerClass::getMeta
+//
+
+OtType OtWorkerClass::getMeta() {
+	thread_local OtType type;
+
+	if (!type) {
+		type = OtType::create<OtWorkerClass>("Worker", OtSystemClass::getMeta());
+
+		type->set("__init__", OtFunction::create(&OtWorkerClass::init));
+		type->set("post", OtFunction::create(&OtWorkerClass::post));
+		type->set("onMessage", OtFunction::create(&OtWorkerClass::onMessage));
+		type->set("onError", OtFunction::create(&OtWorkerClass::onError));
+		type->set("terminate", OtFunction::create(&OtWorkerClass::terminate));
+		type->set("wait", OtFunction::create(&OtWorkerClass::wait));
+		type->set("isRunning", OtFunction::create(&OtWorkerClass::isRunning));
+	}
+
+	return type;
+}
+
+
+//
+//	OtWorkerPortClass::post
+//
+
+OtObject OtWorkerPortClass::post(size_t count, OtObject* parameters) {
+	if (count < 1 || count > 2) {
+		OtLogError("Worker post expects [1] or [2] parameters, [{}] given", count);
+	}
+
+	channel->outbox.push(std::make_unique<OtStructuredClone>(parameters[0], count == 2 ? parameters[1] : nullptr));
+	channel->signalParent();
+	return OtObject(this);
+}
+
+
+//
+//	OtWorkerPortClass::onMessage
+//
+
+OtObject OtWorkerPortClass::onMessage(OtObject cb) {
+	OtCallbackValidate(cb, 1);
+	callback = cb;
+
+	if (handle) {
+		uv_ref(reinterpret_cast<uv_handle_t*>(handle));
+		uv_async_send(handle);
+	}
+
+	return OtObject(this);
+}
+
+
+//
+//	OtWorkerPortClass::close
+//
+
+void OtWorkerPortClass::close() {
+	callback = nullptr;
+
+	if (handle) {
+		uv_unref(reinterpret_cast<uv_handle_t*>(handle));
+	}
+}
+
+
+//
+//	OtWorkerPortClass::receive
+//
+
+void OtWorkerPortClass::receive() {
+	if (channel->terminating) {
+		uv_stop(handle->loop);
+
+	} else {
+		// callbacks could drop the last reference to the port
+		OtObject self(this);
+		OtWorkerChannel::Message message;
+
+		while (callback && channel->inbox.pop(message)) {
+			OtVM::callMemberFunction(callback, "__call__", message->deserialize());
+		}
+	}
+}
+
+
+//
+//	OtWorkerPortClass::getMeta
+//
+
+OtType OtWorkerPortClass::getMeta() {
+	thread_local OtType type;
+
+	if (!type) {
+		type = OtType::create<OtWorkerPortClass>("WorkerPort", OtSystemClass::getMeta());
+
+		type->set("post", OtFunction::create(&OtWorkerPortClass::post));
+		type->set("onMessage", OtFunction::create(&OtWorkerPortClass::onMessage));
+		type->set("close", OtFunction::create(&OtWorkerPortClass::close));
+	}
+
+	return type;
+}
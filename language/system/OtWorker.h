@@ -0,0 +1,190 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+#pragma once
+
+
+//
+//	Include files
+//
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "OtLibuv.h"
+#include "OtMpscQueue.h"
+#include "OtStructuredClone.h"
+#include "OtSystem.h"
+
+
+//
+//	OtWorkerChannel
+//
+//	State shared by a worker object and its thread. Messages travel through
+//	lock-free queues. The async handles that wake up the receiving loops are
+//	owned by the receiving thread, so signalling them is guarded by a mutex
+//	that allows the owner to take a handle away before closing it.
+//
+
+struct OtWorkerChannel {
+	using Message = std::unique_ptr<OtStructuredClone>;
+
+	// messages to the worker and to its parent (plus errors raised by the worker)
+	OtMpscQueue<Message> inbox;
+	OtMpscQueue<Message> outbox;
+	OtMpscQueue<std::string> errors;
+
+	// wake up the worker or the parent
+	void signalWorker();
+	void signalParent();
+
+	// interrupt the worker's script (if it is running)
+	void interruptWorker();
+
+	std::mutex mutex;
+	std::condition_variable signalled;
+	std::atomic<uint32_t>* workerHooks = nullptr;
+	uv_async_t* workerHandle = nullptr;
+	uv_async_t* parentHandle = nullptr;
+	size_t parentSignals = 0;
+
+	// lifecycle
+	std::atomic<bool> terminating{false};
+	std::atomic<bool> finished{false};
+};
+
+
+//
+//	OtWorker
+//
+//	Runs a module on its own thread with its own virtual machine and event
+//	loop. The module talks to its creator through the "parent" global.
+//	Dropping the last reference to a worker terminates it (a busy script is
+//	interrupted at its next statement).
+//
+
+class OtWorkerClass;
+using OtWorker = OtObjectPointer<OtWorkerClass>;
+
+class OtWorkerClass : public OtSystemClass {
+public:
+	// destructor
+	~OtWorkerClass();
+
+	// start the worker
+	void init(const std::string& path);
+
+	// send a message (and optionally an array of typed arrays to transfer)
+	OtObject post(size_t count, OtObject* parameters);
+
+	// set callbacks for messages and errors
+	OtObject onMessage(OtObject callback);
+	OtObject onError(OtObject callback);
+
+	// ask the worker to stop (a busy script is interrupted at its next statement)
+	void terminate();
+
+	// wait for the worker to finish (delivering its messages while waiting)
+	void wait();
+
+	// see if the worker is still running
+	inline bool isRunning() { return thread.joinable(); }
+
+	// cycle collector support (callbacks are only reported once the worker has finished)
+	inline void traverse(OtObjectTraverser& traverser) override {
+		if (!thread.joinable()) {
+			traverser(messageCallback);
+			traverser(errorCallback);
+		}
+	}
+
+	inline void clearReferences() override { messageCallback = nullptr; errorCallback = nullptr; }
+
+	// get type definition
+	static OtType getMeta();
+
+protected:
+	// constructor
+	friend class OtObjectPointer<OtWorkerClass>;
+	OtWorkerClass() = default;
+
+private:
+	// the worker thread
+	static void run(std::shared_ptr<OtWorkerChannel> channel, std::string path);
+
+	// deliver pending messages and errors (and clean up when the worker has finished)
+	void receive();
+	void finish();
+
+	// properties
+	std::shared_ptr<OtWorkerChannel> channel;
+	std::thread thread;
+	size_t signalsSeen = 0;
+
+	OtObject messageCallback;
+	OtObject errorCallback;
+
+	// the async handle outlives the worker until libuv has closed it
+	struct Handle {
+		uv_async_t async;
+		OtWorkerClass* worker;
+	};
+
+	Handle* handle = nullptr;
+	void closeHandle();
+};
+
+
+//
+//	OtWorkerPort
+//
+//	The worker's end of the channel.
+//
+
+class OtWorkerPortClass;
+using OtWorkerPort = OtObjectPointer<OtWorkerPortClass>;
+
+class OtWorkerPortClass : public OtSystemClass {
+public:
+	// send a message (and optionally an array of typed arrays to transfer) to the parent
+	OtObject post(size_t count, OtObject* parameters);
+
+	// set message callback (this keeps the worker alive)
+	OtObject onMessage(OtObject callback);
+
+	// stop listening for messages (which allows the worker to finish)
+	void close();
+
+	// cycle collector support
+	inline void traverse(OtObjectTraverser& traverser) override { traverser(callback); }
+	inline void clearReferences() override { callback = nullptr; }
+
+	// get type definition
+	static OtType getMeta();
+
+protected:
+	// constructor
+	friend class OtObjectPointer<OtWorkerPortClass>;
+	friend class OtWorkerClass;
+	OtWorkerPortClass() = default;
+	OtWorkerPortClass(std::shared_ptr<OtWorkerChannel> c, uv_async_t* h) : channel(c), handle(h) {}
+
+private:
+	// deliver pending messages (or stop the loop when the parent wants us to terminate)
+	void receive();
+
+	// properties
+	std::shared_ptr<OtWorkerChannel> channel;
+	uv_async_t* handle = nullptr;
+	OtObject callback;
+};
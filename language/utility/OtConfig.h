@@ -12,6 +12,8 @@
 //	Include files
 //
 
+#include <cstddef>
+
 #include "OtSingleton.h"
 
 
@@ -25,7 +27,20 @@ public:
 	static inline void setSubprocessMode(bool flag) { instance().subprocessMode = flag; }
 	static inline bool inSubprocessMode() { return instance().subprocessMode; }
 
+	// access compiled bytecode cache usage
+	static inline void setByteCodeCache(bool flag) { instance().bytecodeCache = flag; }
+	static inline bool useByteCodeCache() { return instance().bytecodeCache; }
+
+	// access just-in-time compiler usage (functions are compiled once calls and loop iterations reach the threshold)
+	static inline void setJit(bool flag) { instance().jit = flag; }
+	static inline bool useJit() { return instance().jit; }
+	static inline void setJitThreshold(size_t threshold) { instance().jitThreshold = threshold; }
+	static inline size_t getJitThreshold() { return instance().jitThreshold; }
+
 private:
 	// configuration
 	bool subprocessMode = false;
+	bool bytecodeCache = true;
+	bool jit = false;
+	size_t jitThreshold = 1000;
 };
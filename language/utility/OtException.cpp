@@ -19,6 +19,7 @@
 //
 
 std::string OtException::serialize() {
+	resolve();
 	auto data = nlohmann::json::object();
 	data["module"] = module;
 	data["lineNumber"] = lineNumber;
@@ -42,4 +43,31 @@ void OtException::deserialize(const std::string& string) {
 	end = data.value("end", 0);
 	shortMessage = data.value("shortMessage", "");
 	longMessage = data.value("longMessage", "");
+	locations.clear();
+}
+
+
+//
+//	OtException::resolveLocations
+//
+
+void OtException::resolveLocations() const noexcept {
+	try {
+		for (auto& location : locations) {
+			// the innermost location is where the error happened (unless the error already has one)
+			if (!lineNumber) {
+				module = location->getModule();
+				lineNumber = location->getLineNumber();
+				start = location->getStart();
+				end = location->getEnd();
+			}
+
+			longMessage = fmt::format("{}\nModule: {}\n{}", longMessage, location->getModule(), location->getSourceCode());
+		}
+
+	} catch (...) {
+		// a failing lookup just leaves out the remaining details
+	}
+
+	locations.clear();
 }
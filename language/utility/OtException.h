@@ -13,7 +13,9 @@
 //
 
 #include <exception>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "fmt/format.h"
 
@@ -21,9 +23,25 @@
 //
 //	OtException
 //
+//	Script errors are often caught by the script itself, so exceptions are
+//	cheap to create and propagate. The virtual machine adds the locations the
+//	exception passes through and those are only turned into a module, line
+//	number and long error message when somebody asks for them.
+//
 
 class OtException : public std::exception {
 public:
+	// a script location (resolved when the error is reported)
+	class Location {
+	public:
+		virtual ~Location() = default;
+		virtual std::string getModule() = 0;
+		virtual size_t getLineNumber() = 0;
+		virtual size_t getStart() = 0;
+		virtual size_t getEnd() = 0;
+		virtual std::string getSourceCode() = 0;
+	};
+
 	// constructors
 	OtException() = default;
 
@@ -44,34 +62,44 @@ public:
 
 	OtException(std::string m) : shortMessage(m), longMessage(m) {}
 
-	inline const char* what() const noexcept { return longMessage.c_str(); }
+	inline const char* what() const noexcept { resolve(); return longMessage.c_str(); }
+
+	// add the location the exception passes through (from the innermost outwards)
+	inline void addLocation(std::shared_ptr<Location> location) { locations.emplace_back(location); }
 
 	// access properties
-	inline std::string getModule() const { return module; }
-	inline size_t getLineNumber() const { return lineNumber; }
-	inline size_t getStart() const { return start; }
-	inline size_t getEnd() const { return end; }
+	inline std::string getModule() const { resolve(); return module; }
+	inline size_t getLineNumber() const { resolve(); return lineNumber; }
+	inline size_t getStart() const { resolve(); return start; }
+	inline size_t getEnd() const { resolve(); return end; }
 	inline std::string getShortErrorMessage() const { return shortMessage; }
-	inline std::string getLongErrorMessage() const { return longMessage; }
+	inline std::string getLongErrorMessage() const { resolve(); return longMessage; }
 
 	// (de)serializer
 	std::string serialize();
 	void deserialize(const std::string& string);
 
 private:
+	// turn the locations into properties
+	inline void resolve() const noexcept { if (locations.size()) { resolveLocations(); } }
+	void resolveLocations() const noexcept;
+
 	// the module in which the error happened
-	std::string module;
+	mutable std::string module;
 
 	// line number causing the error (starting at 1)
-	size_t lineNumber = 0;
+	mutable size_t lineNumber = 0;
 
 	// start of token causing the error (in bytes from start of source)
-	size_t start = 0;
+	mutable size_t start = 0;
 
 	// end of token causing the error (in bytes from start of source)
-	size_t end = 0;
+	mutable size_t end = 0;
 
 	// the short and long error message
 	std::string shortMessage;
-	std::string longMessage;
+	mutable std::string longMessage;
+
+	// unresolved locations
+	mutable std::vector<std::shared_ptr<Location>> locations;
 };
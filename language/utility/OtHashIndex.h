@@ -0,0 +1,173 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+#pragma once
+
+
+//
+//	Include files
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+
+//
+//	OtHashIndex
+//
+//	Open addressing (linear probing) index for containers that keep their
+//	entries in a dense vector. The index only stores entry positions so the
+//	container decides the entry layout and the iteration order. Hashes are
+//	provided by the container (which is expected to cache them) and are
+//	scrambled here so weak hashes (like integer identity) still spread well.
+//	Removals use backward shifting so there are no tombstones.
+//
+
+class OtHashIndex {
+public:
+	// returned when an entry can't be found
+	static constexpr size_t notFound = std::numeric_limits<size_t>::max();
+
+	// find an entry with the specified hash (equal(index) confirms a match)
+	template <typename Equal>
+	size_t find(size_t hash, Equal equal) const {
+		if (slots.empty()) {
+			return notFound;
+		}
+
+		for (auto slot = home(hash);; slot = (slot + 1) & mask) {
+			auto entry = slots[slot];
+
+			if (entry == empty) {
+				return notFound;
+
+			} else if (equal(entry - 1)) {
+				return entry - 1;
+			}
+		}
+	}
+
+	// add an entry (which must not be in the index yet), hashOf(index) returns the hash of existing entries
+	template <typename HashOf>
+	void insert(size_t hash, size_t index, size_t count, HashOf hashOf) {
+		if ((count + 1) * 4 > slots.size() * 3) {
+			resize((count + 1) * 2, count, hashOf);
+		}
+
+		auto slot = home(hash);
+
+		while (slots[slot] != empty) {
+			slot = (slot + 1) & mask;
+		}
+
+		slots[slot] = static_cast<uint32_t>(index + 1);
+	}
+
+	// remove an entry from the index
+	template <typename HashOf>
+	void erase(size_t hash, size_t index, HashOf hashOf) {
+		auto hole = locate(hash, index);
+		auto slot = hole;
+
+		// shift later entries in the same cluster back so lookups don't stop early
+		while (true) {
+			slot = (slot + 1) & mask;
+			auto entry = slots[slot];
+
+			if (entry == empty) {
+				break;
+			}
+
+			auto ideal = home(hashOf(entry - 1));
+
+			if (((slot - ideal) & mask) >= ((slot - hole) & mask)) {
+				slots[hole] = entry;
+				hole = slot;
+			}
+		}
+
+		slots[hole] = empty;
+	}
+
+	// an entry moved to a new position in the container
+	inline void move(size_t hash, size_t from, size_t to) {
+		slots[locate(hash, from)] = static_cast<uint32_t>(to + 1);
+	}
+
+	// recreate the index for the specified number of entries
+	template <typename HashOf>
+	inline void rebuild(size_t count, HashOf hashOf) {
+		resize(count, count, hashOf);
+	}
+
+	// reserve space for the specified number of entries
+	template <typename HashOf>
+	inline void reserve(size_t capacity, size_t count, HashOf hashOf) {
+		if (capacity * 4 > slots.size() * 3) {
+			resize(capacity, count, hashOf);
+		}
+	}
+
+	// remove all entries
+	inline void clear() {
+		slots.clear();
+		mask = 0;
+	}
+
+private:
+	// size the table for the specified number of entries and index the current ones
+	template <typename HashOf>
+	void resize(size_t capacity, size_t count, HashOf hashOf) {
+		size_t size = 8;
+
+		while (size * 3 < capacity * 4) {
+			size *= 2;
+		}
+
+		slots.assign(size, empty);
+		mask = size - 1;
+		shift = 64;
+
+		for (auto c = size; c > 1; c >>= 1) {
+			shift--;
+		}
+
+		for (size_t i = 0; i < count; i++) {
+			auto slot = home(hashOf(i));
+
+			while (slots[slot] != empty) {
+				slot = (slot + 1) & mask;
+			}
+
+			slots[slot] = static_cast<uint32_t>(i + 1);
+		}
+	}
+
+	// find the slot that refers to the specified entry
+	inline size_t locate(size_t hash, size_t index) const {
+		auto slot = home(hash);
+
+		while (slots[slot] != index + 1) {
+			slot = (slot + 1) & mask;
+		}
+
+		return slot;
+	}
+
+	// determine the preferred slot for a hash (fibonacci hashing)
+	inline size_t home(size_t hash) const {
+		return static_cast<size_t>((static_cast<uint64_t>(hash) * 0x9e3779b97f4a7c15ull) >> shift) & mask;
+	}
+
+	// slots contain an entry position plus one (zero means empty)
+	static constexpr uint32_t empty = 0;
+	std::vector<uint32_t> slots;
+	size_t mask = 0;
+	unsigned int shift = 64;
+};
@@ -20,6 +20,7 @@
 
 #include <uv.h>
 
+#include "OtCycleCollector.h"
 #include "OtLog.h"
 
 
@@ -41,22 +42,36 @@ public:
 	static inline void init(int argc, char* argv[]) {
 		// setup the calling arguments
 		uv_setup_args(argc, argv);
+
+		// collect reference cycles while the loop is idle
+		OtCycleCollector::start();
+	}
+
+	// get the event loop for the calling thread (threads that don't set their own use the default loop)
+	static inline uv_loop_t* getLoop() {
+		auto loop = threadLoop();
+		return loop ? loop : uv_default_loop();
+	}
+
+	// set the event loop for the calling thread
+	static inline void setLoop(uv_loop_t* loop) {
+		threadLoop() = loop;
 	}
 
 	// run the libUV loop
 	static inline void run() {
-		uv_run(uv_default_loop(), UV_RUN_DEFAULT);
+		uv_run(getLoop(), UV_RUN_DEFAULT);
 	}
 
 	// stop the libUV loop
 	static inline void stop() {
 		// use timer so "stop" transaction can complete
-		static uv_timer_t uv_shutdown;
-		uv_timer_init(uv_default_loop(), &uv_shutdown);
+		static thread_local uv_timer_t uv_shutdown;
+		uv_timer_init(getLoop(), &uv_shutdown);
 
-		uv_timer_start(&uv_shutdown, []([[maybe_unused]] uv_timer_t* handle) {
+		uv_timer_start(&uv_shutdown, [](uv_timer_t* handle) {
 			// close all handles which will end libuv's loop
-			uv_walk(uv_default_loop(), [](uv_handle_t* handle, [[maybe_unused]] void* arg) {
+			uv_walk(handle->loop, [](uv_handle_t* handle, [[maybe_unused]] void* arg) {
 				if (!uv_is_closing(handle)) {
 					uv_close(handle, nullptr);
 				}
@@ -67,15 +82,26 @@ public:
 	// terminate LibUV
 	static inline void end() {
 		// properly close all libuv handles
-		uv_walk(uv_default_loop(), [](uv_handle_t* handle, [[maybe_unused]] void* arg) {
+		auto loop = getLoop();
+
+		uv_walk(loop, [](uv_handle_t* handle, [[maybe_unused]] void* arg) {
 			if (!uv_is_closing(handle))
 				uv_close(handle, nullptr);
 		}, nullptr);
 
-		uv_run(uv_default_loop(), UV_RUN_DEFAULT);
-		uv_loop_close(uv_default_loop());
+		uv_run(loop, UV_RUN_DEFAULT);
+
+		// close the library (threads with their own loop close it themselves)
+		if (loop == uv_default_loop()) {
+			uv_loop_close(loop);
+			uv_library_shutdown();
+		}
+	}
 
-		// close the library
-		uv_library_shutdown();
+private:
+	// the calling thread's own loop (if it has one)
+	static inline uv_loop_t*& threadLoop() {
+		thread_local uv_loop_t* loop = nullptr;
+		return loop;
 	}
 };
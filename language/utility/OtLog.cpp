@@ -9,21 +9,25 @@
 //	Include files
 //
 
-#if _WIN32
-#define _CRT_SECURE_NO_WARNINGS // for localtime
-#endif
-
+#include <algorithm>
+#include <cerrno>
 #include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
-#include <iostream>
 
 #if _WIN32
+#include <fcntl.h>
 #include <intrin.h>
+#include <io.h>
+#include <sys/stat.h>
 #else
+#include <climits>
+#include <fcntl.h>
 #include <signal.h>
+#include <sys/uio.h>
+#include <unistd.h>
 #endif
 
 #include "fmt/format.h"
@@ -56,11 +60,18 @@ static std::string GetTimestamp() {
 	// get current time
 	auto now = std::chrono::system_clock::now();
 	auto nowTime = std::chrono::system_clock::to_time_t(now);
-	auto localTime = localtime(&nowTime);
+	std::tm localTime;
+
+	// (threads format their own messages so we need the reentrant versions)
+#if _WIN32
+	localtime_s(&localTime, &nowTime);
+#else
+	localtime_r(&nowTime, &localTime);
+#endif
 
 	// convert to a string
 	char buffer[256];
-	strftime(buffer, sizeof(buffer), "%Y-%m-%d %H-%M-%S", localTime);
+	strftime(buffer, sizeof(buffer), "%Y-%m-%d %H-%M-%S", &localTime);
 
 	// add milliseconds
 	int ms = std::chrono::time_point_cast<std::chrono::milliseconds>(now).time_since_epoch().count() % 1000;
@@ -71,6 +82,95 @@ static std::string GetTimestamp() {
 }
 
 
+//
+//	Write text to a file descriptor
+//
+
+static constexpr int stderrFile = 2;
+
+static void writeText(int fd, const std::vector<std::pair<OtLog::Type, std::string>>& messages, size_t first, size_t count) {
+#if _WIN32
+	std::string text;
+
+	for (size_t i = first; i < first + count; i++) {
+		text += messages[i].second;
+	}
+
+	_write(fd, text.data(), static_cast<unsigned int>(text.size()));
+
+#else
+	// write as many messages as possible with a single system call
+	std::vector<iovec> buffers;
+	buffers.reserve(count);
+
+	for (size_t i = first; i < first + count; i++) {
+		buffers.push_back({const_cast<char*>(messages[i].second.data()), messages[i].second.size()});
+	}
+
+#if defined(IOV_MAX)
+	const size_t limit = IOV_MAX;
+#else
+	const size_t limit = 16;
+#endif
+
+	size_t done = 0;
+
+	while (done < buffers.size()) {
+		auto written = writev(fd, buffers.data() + done, static_cast<int>(std::min(buffers.size() - done, limit)));
+
+		if (written < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+
+			// there is nobody to tell about failing logs
+			return;
+		}
+
+		// skip what was written (partial writes leave the rest of a buffer)
+		auto remaining = static_cast<size_t>(written);
+
+		while (done < buffers.size() && remaining >= buffers[done].iov_len) {
+			remaining -= buffers[done++].iov_len;
+		}
+
+		if (remaining) {
+			buffers[done].iov_base = static_cast<char*>(buffers[done].iov_base) + remaining;
+			buffers[done].iov_len -= remaining;
+		}
+	}
+#endif
+}
+
+
+//
+//	OtLog::OtLog
+//
+
+OtLog::OtLog() : queue(queueSize) {
+}
+
+
+//
+//	OtLog::~OtLog
+//
+
+OtLog::~OtLog() {
+	if (writer.joinable()) {
+		{
+			std::lock_guard<std::mutex> lock(writerMutex);
+			writerStopping = true;
+		}
+
+		writerSignal.notify_one();
+		writer.join();
+	}
+
+	writeQueuedMessages();
+	openLogFile("");
+}
+
+
 //
 //	OtLog::logMessage
 //
@@ -82,38 +182,207 @@ void OtLog::logMessage(const char* filename, int lineno, Type type, const std::s
 	auto messageType = messageTypes[static_cast<int>(type)];
 	auto output = fmt::format("{} [{}] {} ({}): {}\n", timestamp, messageType, shortname, lineno, message);
 
+	if (type < Type::error) {
+		// leave less important messages to the writer (or drop them if they come in too fast)
+		if (overRateLimit(type) || !queueMessage(type, std::move(output))) {
+			dropped.fetch_add(1, std::memory_order_relaxed);
+		}
+
+	} else {
+		// write everything that is queued and then this message
+		std::lock_guard<std::mutex> lock(outputMutex);
+		std::vector<std::pair<Type, std::string>> messages;
+		takeQueuedMessages(messages);
+		messages.emplace_back(type, std::move(output));
+		writeMessages(messages);
+	}
+
+	// terminate program (if required)
+	if (type == Type::fatal) {
+
+#if OT_DEBUG
+
+#if _WIN32
+	__debugbreak();
+
+#else
+	raise(SIGTRAP);
+#endif
+
+#else
+		std::_Exit(EXIT_FAILURE);
+#endif
+	}
+}
+
+
+//
+//	OtLog::queueMessage
+//
+
+bool OtLog::queueMessage(Type type, std::string&& text) {
+	std::call_once(writerStarted, [this]() { startWriter(); });
+
+	if (!queue.tryPush(std::make_pair(type, std::move(text)))) {
+		// the queue is full
+		writerSignal.notify_one();
+		return false;
+	}
+
+	// wake up the writer early when the queue is filling up
+	if (queue.size() > queueSize / 2 && writerSleeping.load(std::memory_order_acquire)) {
+		writerSignal.notify_one();
+	}
+
+	return true;
+}
+
+
+//
+//	OtLog::overRateLimit
+//
+
+bool OtLog::overRateLimit(Type type) {
+	auto& rate = rateLimits[static_cast<size_t>(type)];
+	auto limit = rate.limit.load(std::memory_order_relaxed);
+
+	if (!limit) {
+		return false;
+	}
+
+	// start counting again every second (threads racing here just make the limit a little less exact)
+	auto second = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+	if (rate.second.load(std::memory_order_relaxed) != second) {
+		rate.second.store(second, std::memory_order_relaxed);
+		rate.count.store(0, std::memory_order_relaxed);
+	}
+
+	return rate.count.fetch_add(1, std::memory_order_relaxed) >= limit;
+}
+
+
+//
+//	OtLog::takeQueuedMessages
+//
+
+void OtLog::takeQueuedMessages(std::vector<std::pair<Type, std::string>>& messages) {
+	std::pair<Type, std::string> message;
+
+	while (queue.tryPop(message)) {
+		messages.emplace_back(std::move(message));
+	}
+
+	// report lost messages
+	if (auto count = dropped.exchange(0, std::memory_order_relaxed)) {
+		auto output = fmt::format(
+			"{} [{}] {} ({}): {} log message(s) dropped (rate limit exceeded or log buffer full)\n",
+			GetTimestamp(), messageTypes[static_cast<int>(Type::warning)], OtPath::getFilename(__FILE__), __LINE__, count);
+
+		messages.emplace_back(Type::warning, output);
+	}
+}
+
+
+//
+//	OtLog::writeMessages
+//
+
+void OtLog::writeMessages(std::vector<std::pair<Type, std::string>>& messages) {
+	if (messages.empty()) {
+		return;
+	}
+
 	// send to IDE (if required)
 	if (OtConfig::inSubprocessMode()) {
-		OtStderrMultiplexer::multiplex(type, output);
+		std::vector<std::pair<Type, std::string>> encoded;
+
+		for (auto& [type, text] : messages) {
+			encoded.emplace_back(type, OtStderrMultiplexer::encode(type, text));
+		}
+
+		writeText(stderrFile, encoded, 0, encoded.size());
 
 	// send to STDERR (if required)
-	} else if (logToStderr) {
-		std::cerr << output << std::flush;
+	} else if (logToStderr.load(std::memory_order_relaxed)) {
+		writeText(stderrFile, messages, 0, messages.size());
 	}
 
 	// send to log file (if required)
-	if (ofs.is_open()) {
-		ofs << output << std::flush;
+	if (logFile >= 0) {
+		writeText(logFile, messages, 0, messages.size());
 	}
+}
 
-	// throw exception (if required)
-	if (type == Type::error) {
-		throw OtException(message);
 
-	// terminate program (if required)
-	} else if (type == Type::fatal) {
+//
+//	OtLog::writeQueuedMessages
+//
 
-#if OT_DEBUG
+void OtLog::writeQueuedMessages() {
+	std::lock_guard<std::mutex> lock(outputMutex);
+	std::vector<std::pair<Type, std::string>> messages;
+	takeQueuedMessages(messages);
+	writeMessages(messages);
+}
 
-#if _WIN32
-	__debugbreak();
 
+//
+//	OtLog::openLogFile
+//
+
+void OtLog::openLogFile(const std::string& name) {
+	std::lock_guard<std::mutex> lock(outputMutex);
+
+	if (logFile >= 0) {
+#if _WIN32
+		_close(logFile);
 #else
-	raise(SIGTRAP);
+		close(logFile);
 #endif
 
+		logFile = -1;
+	}
+
+	if (!name.empty()) {
+#if _WIN32
+		logFile = _open(name.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
 #else
-		std::_Exit(EXIT_FAILURE);
+		logFile = open(name.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
 #endif
 	}
 }
+
+
+//
+//	OtLog::startWriter
+//
+
+void OtLog::startWriter() {
+	writer = std::thread([this]() {
+		runWriter();
+	});
+}
+
+
+//
+//	OtLog::runWriter
+//
+
+void OtLog::runWriter() {
+	while (true) {
+		// sleep until it's time to write a batch
+		{
+			std::unique_lock<std::mutex> lock(writerMutex);
+			writerSleeping.store(true, std::memory_order_release);
+			writerSignal.wait_for(lock, std::chrono::milliseconds(20));
+			writerSleeping.store(false, std::memory_order_relaxed);
+
+			if (writerStopping) {
+				return;
+			}
+		}
+
+		writeQueuedMessages();
+	}
+}
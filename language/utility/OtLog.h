@@ -12,17 +12,35 @@
 //	Include files
 //
 
-#include <fstream>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "fmt/format.h"
 
+#include "OtException.h"
+#include "OtMpmcQueue.h"
 #include "OtSingleton.h"
 
 
 //
 //	OtLog
 //
+//	Debug, info and warning messages are formatted by the calling thread and
+//	put in a bounded lock-free queue. A background thread writes them in
+//	batches so threads that log a lot don't wait for I/O or for each other.
+//	When the queue is full or a message type exceeds its rate limit, messages
+//	are dropped and the writer reports how many were lost. Caught errors and
+//	fatal messages first write everything that is queued and are then written
+//	synchronously, so they are never lost or reordered. Logging an error never
+//	raises it (that is what OtLogError does).
+//
 
 class OtLog : OtSingleton<OtLog> {
 public:
@@ -35,6 +53,10 @@ public:
 		fatal
 	};
 
+	// constructor/destructor (the destructor writes the remaining messages)
+	OtLog();
+	~OtLog();
+
 	// log a message
 	static inline void log(const char* filename, int lineno, Type type, const std::string& message) {
 		instance().logMessage(filename, lineno, type, message);
@@ -46,22 +68,85 @@ public:
 		instance().logMessage(filename, lineno, type, message);
 	}
 
+	// raise an error (errors are only logged when nobody catches them, so this doesn't touch the log)
+	// code that catches an error and carries on should log it with OtLogCaughtError
+	[[noreturn]] static inline void error(const std::string& message) {
+		throw OtException(message);
+	}
+
+	template<typename... ARGS>
+	[[noreturn]] static inline void error(const char* format, ARGS... args) {
+		throw OtException(fmt::format(format, args...));
+	}
+
 	// set logging targets
-	static inline void setStderrLogging(bool flag) { instance().logToStderr = flag; }
+	static inline void setStderrLogging(bool flag) { instance().logToStderr.store(flag, std::memory_order_relaxed); }
+	static inline void setFileLogging(const std::string& name) { instance().openLogFile(name); }
 
-	static inline void setFileLogging(const std::string& name) {
-		auto& ofs = instance().ofs;
-		if (ofs.is_open()) { ofs.close(); }
-		if (!name.empty()) { ofs.open(name); }
+	// limit the number of messages per second for a message type (0 means unlimited, errors are never limited)
+	static inline void setRateLimit(Type type, size_t messagesPerSecond) {
+		instance().rateLimits[static_cast<size_t>(type)].limit.store(messagesPerSecond, std::memory_order_relaxed);
 	}
 
+	// write all queued messages
+	static inline void flush() { instance().writeQueuedMessages(); }
+
 private:
 	// log the message
 	void logMessage(const char* filename, int lineno, Type type, const std::string& message);
 
+	// queue a message for the writer (returns false if the queue is full)
+	bool queueMessage(Type type, std::string&& text);
+
+	// see if a message type is over its rate limit
+	bool overRateLimit(Type type);
+
+	// write messages (the output mutex must be locked)
+	void writeMessages(std::vector<std::pair<Type, std::string>>& messages);
+
+	// take messages from the queue (the output mutex must be locked)
+	void takeQueuedMessages(std::vector<std::pair<Type, std::string>>& messages);
+
+	// write all queued messages
+	void writeQueuedMessages();
+
+	// open or close the log file
+	void openLogFile(const std::string& name);
+
+	// the background writer
+	void startWriter();
+	void runWriter();
+
 	// logging targets
-	bool logToStderr = true;
-	std::ofstream ofs;
+	std::atomic<bool> logToStderr{true};
+	int logFile = -1;
+
+	// the queue between logging threads and the writer
+	static constexpr size_t queueSize = 4096;
+	OtMpmcQueue<std::pair<Type, std::string>> queue;
+
+	// number of messages lost because the queue was full or rate limits were exceeded
+	std::atomic<size_t> dropped{0};
+
+	// rate limiting (per message type and per second)
+	struct RateLimit {
+		std::atomic<size_t> limit{1000};
+		std::atomic<int64_t> second{0};
+		std::atomic<size_t> count{0};
+	};
+
+	RateLimit rateLimits[5];
+
+	// only one thread writes at a time (this also makes it the queue's only consumer)
+	std::mutex outputMutex;
+
+	// the writer thread (which wakes up periodically or when the queue fills up)
+	std::thread writer;
+	std::once_flag writerStarted;
+	std::mutex writerMutex;
+	std::condition_variable writerSignal;
+	std::atomic<bool> writerSleeping{false};
+	bool writerStopping = false;
 };
 
 
@@ -81,5 +166,6 @@ private:
 #define OtLogWarning(...)
 #endif
 
-#define OtLogError(...) OtLogMessage(OtLog::Type::error, __VA_ARGS__)
+#define OtLogError(...) (OtLog::error(__VA_ARGS__))
+#define OtLogCaughtError(...) OtLogMessage(OtLog::Type::error, __VA_ARGS__)
 #define OtLogFatal(...) OtLogMessage(OtLog::Type::fatal, __VA_ARGS__)
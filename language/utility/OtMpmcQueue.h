@@ -0,0 +1,183 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+#pragma once
+
+
+//
+//	Include files
+//
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include <uv.h>
+
+
+//
+//	OtMpmcQueue
+//
+//	Bounded lock-free queue for many producers and many consumers (Vyukov's
+//	design). Every slot has a sequence number that tells producers and
+//	consumers whose turn it is, so they only compete for the positions and
+//	never wait for each other. A push fails when the queue is full and a pop
+//	fails when it's empty (or when the next item's producer is halfway through
+//	its push). Batches don't claim positions in one go but they do wake up a
+//	consumer on a libuv loop only once.
+//
+
+template <typename T>
+class OtMpmcQueue {
+public:
+	// constructor (the capacity is rounded up to a power of two)
+	explicit OtMpmcQueue(size_t capacity) {
+		size_t size = 2;
+
+		while (size < capacity) {
+			size *= 2;
+		}
+
+		mask = size - 1;
+		slots = std::make_unique<Slot[]>(size);
+
+		for (size_t i = 0; i < size; i++) {
+			slots[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	OtMpmcQueue(const OtMpmcQueue&) = delete;
+	OtMpmcQueue& operator=(const OtMpmcQueue&) = delete;
+
+	// wake up a consumer on a libuv loop after every push (the handle must outlive the producers' use of the queue)
+	inline void setWakeup(uv_async_t* handle) { wakeup = handle; }
+
+	// add an item (returns false if the queue is full)
+	inline bool tryPush(T&& value) {
+		if (!pushItem(value)) {
+			return false;
+		}
+
+		wake();
+		return true;
+	}
+
+	inline bool tryPush(const T& value) {
+		T copy = value;
+		return tryPush(std::move(copy));
+	}
+
+	// add items until the queue is full (returns the number added)
+	inline size_t pushN(T* values, size_t count) {
+		size_t pushed = 0;
+
+		while (pushed < count && pushItem(values[pushed])) {
+			pushed++;
+		}
+
+		if (pushed) {
+			wake();
+		}
+
+		return pushed;
+	}
+
+	// take an item (returns false if the queue is empty)
+	inline bool tryPop(T& value) {
+		auto position = tail.load(std::memory_order_relaxed);
+
+		while (true) {
+			auto& slot = slots[position & mask];
+			auto sequence = slot.sequence.load(std::memory_order_acquire);
+			auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+
+			if (difference == 0) {
+				if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+					value = std::move(slot.value);
+					slot.sequence.store(position + mask + 1, std::memory_order_release);
+					return true;
+				}
+
+			} else if (difference < 0) {
+				return false;
+
+			} else {
+				position = tail.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	// take up to the specified number of items (returns the number taken)
+	inline size_t popN(T* values, size_t count) {
+		size_t popped = 0;
+
+		while (popped < count && tryPop(values[popped])) {
+			popped++;
+		}
+
+		return popped;
+	}
+
+	// get the number of queued items (only exact when nobody is pushing or popping)
+	inline size_t size() const {
+		auto h = head.load(std::memory_order_acquire);
+		auto t = tail.load(std::memory_order_acquire);
+		return h > t ? h - t : 0;
+	}
+
+	inline bool empty() const { return size() == 0; }
+	inline size_t getCapacity() const { return mask + 1; }
+
+private:
+	// claim a position and fill its slot
+	inline bool pushItem(T& value) {
+		auto position = head.load(std::memory_order_relaxed);
+
+		while (true) {
+			auto& slot = slots[position & mask];
+			auto sequence = slot.sequence.load(std::memory_order_acquire);
+			auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+			if (difference == 0) {
+				if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+					slot.value = std::move(value);
+					slot.sequence.store(position + 1, std::memory_order_release);
+					return true;
+				}
+
+			} else if (difference < 0) {
+				return false;
+
+			} else {
+				position = head.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	// wake up the consumer (if required)
+	inline void wake() {
+		if (wakeup) {
+			uv_async_send(wakeup);
+		}
+	}
+
+	// queue slots
+	struct Slot {
+		std::atomic<size_t> sequence;
+		T value;
+	};
+
+	std::unique_ptr<Slot[]> slots;
+	size_t mask;
+	uv_async_t* wakeup = nullptr;
+
+	// producers and consumers work on different ends (so keep them on different cache lines)
+	alignas(64) std::atomic<size_t> head{0};
+	alignas(64) std::atomic<size_t> tail{0};
+};
@@ -0,0 +1,81 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+#pragma once
+
+
+//
+//	Include files
+//
+
+#include <atomic>
+#include <utility>
+
+
+//
+//	OtMpscQueue
+//
+//	Unbounded lock-free queue for many producers and a single consumer
+//	(Vyukov's intrusive design). Producers never wait on each other or on the
+//	consumer. A pop can miss an item whose producer is halfway through a push,
+//	so consumers that are woken up by a signal must drain the queue until it
+//	reports empty and rely on the producer signalling again after its push.
+//
+
+template <typename T>
+class OtMpscQueue {
+public:
+	// constructor/destructor
+	OtMpscQueue() {
+		auto stub = new Node;
+		head.store(stub, std::memory_order_relaxed);
+		tail = stub;
+	}
+
+	~OtMpscQueue() {
+		T value;
+		while (pop(value)) {}
+		delete tail;
+	}
+
+	OtMpscQueue(const OtMpscQueue&) = delete;
+	OtMpscQueue& operator=(const OtMpscQueue&) = delete;
+
+	// add an item to the queue (can be called from any thread)
+	void push(T&& value) {
+		auto node = new Node;
+		node->value = std::move(value);
+		auto previous = head.exchange(node, std::memory_order_acq_rel);
+		previous->next.store(node, std::memory_order_release);
+	}
+
+	// take an item from the queue (only called from the consumer thread)
+	bool pop(T& value) {
+		auto next = tail->next.load(std::memory_order_acquire);
+
+		if (!next) {
+			return false;
+		}
+
+		// the next node becomes the new stub
+		value = std::move(next->value);
+		delete tail;
+		tail = next;
+		return true;
+	}
+
+private:
+	// queue nodes (the node at the tail is a stub whose value was already taken)
+	struct Node {
+		T value{};
+		std::atomic<Node*> next{nullptr};
+	};
+
+	// producers and the consumer work on different ends (so keep them on different cache lines)
+	alignas(64) std::atomic<Node*> head;
+	alignas(64) Node* tail;
+};
@@ -0,0 +1,95 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+#pragma once
+
+
+//
+//	Include files
+//
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+
+//
+//	OtParallelSort
+//
+//	Sorts a random access range by sorting slices on separate threads and
+//	merging the results. Small ranges (or single core machines) are sorted on
+//	the calling thread. The comparison must be thread safe which means it
+//	can't call back into the VM.
+//
+
+template <typename Iterator, typename Compare>
+void OtParallelSort(Iterator begin, Iterator end, Compare compare) {
+	static constexpr size_t minimumSlice = 32 * 1024;
+	static constexpr size_t maximumThreads = 8;
+
+	auto size = static_cast<size_t>(end - begin);
+	auto threads = std::min(static_cast<size_t>(std::thread::hardware_concurrency()), maximumThreads);
+	auto slices = std::min(threads, size / minimumSlice);
+
+	if (slices < 2) {
+		std::sort(begin, end, compare);
+		return;
+	}
+
+	// determine slice boundaries
+	std::vector<Iterator> bounds;
+
+	for (size_t i = 0; i <= slices; i++) {
+		bounds.push_back(begin + static_cast<std::ptrdiff_t>(size * i / slices));
+	}
+
+	// sort slices in parallel
+	std::vector<std::thread> workers;
+
+	for (size_t i = 1; i < slices; i++) {
+		workers.emplace_back([&, i]() {
+			std::sort(bounds[i], bounds[i + 1], compare);
+		});
+	}
+
+	std::sort(bounds[0], bounds[1], compare);
+
+	for (auto& worker : workers) {
+		worker.join();
+	}
+
+	// merge neighboring slices (in parallel) until only one is left
+	while (bounds.size() > 2) {
+		std::vector<Iterator> merged;
+		workers.clear();
+
+		for (size_t i = 0; i + 2 < bounds.size(); i += 2) {
+			auto first = bounds[i];
+			auto middle = bounds[i + 1];
+			auto last = bounds[i + 2];
+			merged.push_back(first);
+
+			workers.emplace_back([=]() {
+				std::inplace_merge(first, middle, last, compare);
+			});
+		}
+
+		// an odd slice out is carried to the next round
+		if (bounds.size() % 2 == 0) {
+			merged.push_back(bounds[bounds.size() - 2]);
+		}
+
+		merged.push_back(bounds.back());
+
+		for (auto& worker : workers) {
+			worker.join();
+		}
+
+		bounds.swap(merged);
+	}
+}
@@ -105,6 +105,32 @@ std::string OtPath::getPreferencesDirectory() {
 }
 
 
+//
+//	OtPath::getCacheDirectory
+//
+
+std::string OtPath::getCacheDirectory() {
+#if __APPLE__
+	auto home = getHomeDirectory();
+	return join(join(home, "Library"), "Caches");
+
+#elif _WIN32
+	return getPreferencesDirectory();
+
+#else
+	char buffer[1024];
+	size_t length = 1024;
+
+	if (uv_os_getenv("XDG_CACHE_HOME", buffer, &length) == 0 && length) {
+		return std::string(buffer, length);
+	}
+
+	auto home = getHomeDirectory();
+	return join(home, ".cache");
+#endif
+}
+
+
 //
 //	OtPath::getTmpFilename
 //
@@ -55,6 +55,7 @@ public:
 	static std::string getHomeDirectory();
 	static std::string getDocumentsDirectory();
 	static std::string getPreferencesDirectory();
+	static std::string getCacheDirectory();
 	static inline std::string getTmpDirectory() { return std::filesystem::temp_directory_path().string(); }
 	static std::string getTmpFilename();
 
@@ -29,7 +29,7 @@ void OtPathFollower::follow(const std::string& p, std::function<void()> cb) {
 	fsEventHandle = new uv_fs_event_t;
 	fsEventHandle->data = static_cast<void*>(this);
 
-	int status = uv_fs_event_init(uv_default_loop(), fsEventHandle);
+	int status = uv_fs_event_init(OtLibUv::getLoop(), fsEventHandle);
 	UV_CHECK_ERROR("uv_fs_event_init", status);
 
 	status = uv_fs_event_start(
@@ -0,0 +1,227 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+//
+//	Include files
+//
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+#include "OtSlabAllocator.h"
+
+
+//
+//	Shared allocator state
+//
+//	This is intentionally never destroyed as objects can still be released
+//	while static objects are destructed at program exit.
+//
+
+struct OtSlabAllocatorShared {
+	std::mutex mutex;
+	std::vector<void*> threads;
+	void* orphans[OtSlabAllocator::sizeClasses] = {};
+	int64_t allocations[OtSlabAllocator::sizeClasses] = {};
+	int64_t releases[OtSlabAllocator::sizeClasses] = {};
+	int64_t largeAllocations = 0;
+	int64_t largeReleases = 0;
+	int64_t largeBytes = 0;
+	size_t slabs = 0;
+};
+
+static OtSlabAllocatorShared& getShared() {
+	static auto shared = new OtSlabAllocatorShared;
+	return *shared;
+}
+
+
+//
+//	carveSlab
+//
+
+static void* carveSlab(OtSlabAllocatorShared& shared, size_t sizeClass) {
+	auto blockSize = OtSlabAllocator::getBlockSize(sizeClass);
+	auto slab = static_cast<char*>(::operator new(OtSlabAllocator::slabSize));
+	auto count = OtSlabAllocator::slabSize / blockSize;
+
+	// link all blocks in the slab together
+	for (size_t i = 0; i < count; i++) {
+		auto block = reinterpret_cast<void**>(slab + i * blockSize);
+		*block = (i + 1 < count) ? slab + (i + 1) * blockSize : nullptr;
+	}
+
+	shared.slabs++;
+	return slab;
+}
+
+
+//
+//	OtSlabAllocator::allocateSlow
+//
+
+void* OtSlabAllocator::allocateSlow(size_t sizeClass) {
+	auto& list = state;
+
+	if (!list.registered && !list.closed) {
+		registerThread();
+	}
+
+	auto& shared = getShared();
+	std::lock_guard<std::mutex> lock(shared.mutex);
+
+	// get more blocks (from threads that ended or from a new slab)
+	auto blocks = shared.orphans[sizeClass];
+
+	if (!blocks) {
+		blocks = carveSlab(shared, sizeClass);
+	}
+
+	auto block = static_cast<Block*>(blocks);
+
+	if (list.closed) {
+		// this thread is ending so we leave the remainder in the shared pool
+		shared.orphans[sizeClass] = block->next;
+		shared.allocations[sizeClass]++;
+
+	} else {
+		shared.orphans[sizeClass] = nullptr;
+		auto& entry = list.classes[sizeClass];
+		entry.head = block->next;
+		bump(entry.allocations);
+	}
+
+	return block;
+}
+
+
+//
+//	OtSlabAllocator::releaseSlow
+//
+
+void OtSlabAllocator::releaseSlow(void* pointer, size_t sizeClass) {
+	auto& list = state;
+
+	if (!list.closed) {
+		registerThread();
+		auto& entry = list.classes[sizeClass];
+		auto block = static_cast<Block*>(pointer);
+		block->next = entry.head;
+		entry.head = block;
+		bump(entry.releases);
+
+	} else {
+		auto& shared = getShared();
+		std::lock_guard<std::mutex> lock(shared.mutex);
+		auto block = static_cast<Block*>(pointer);
+		block->next = static_cast<Block*>(shared.orphans[sizeClass]);
+		shared.orphans[sizeClass] = block;
+		shared.releases[sizeClass]++;
+	}
+}
+
+
+//
+//	OtSlabAllocator::registerThread
+//
+
+void OtSlabAllocator::registerThread() {
+	// make sure we get cleaned up when this thread ends
+	(void) &cleanup;
+
+	auto& shared = getShared();
+	std::lock_guard<std::mutex> lock(shared.mutex);
+	shared.threads.push_back(&state);
+	state.registered = true;
+}
+
+
+//
+//	OtSlabAllocator::unregisterThread
+//
+
+void OtSlabAllocator::unregisterThread() {
+	auto& list = state;
+	auto& shared = getShared();
+	std::lock_guard<std::mutex> lock(shared.mutex);
+
+	// hand our free blocks to the shared pool and remember our counters
+	for (size_t i = 0; i < sizeClasses; i++) {
+		auto& entry = list.classes[i];
+
+		if (entry.head) {
+			auto tail = entry.head;
+
+			while (tail->next) {
+				tail = tail->next;
+			}
+
+			tail->next = static_cast<Block*>(shared.orphans[i]);
+			shared.orphans[i] = entry.head;
+			entry.head = nullptr;
+		}
+
+		shared.allocations[i] += entry.allocations.load(std::memory_order_relaxed);
+		shared.releases[i] += entry.releases.load(std::memory_order_relaxed);
+	}
+
+	shared.largeAllocations += list.largeAllocations.load(std::memory_order_relaxed);
+	shared.largeReleases += list.largeReleases.load(std::memory_order_relaxed);
+	shared.largeBytes += list.largeBytes.load(std::memory_order_relaxed);
+
+	shared.threads.erase(std::remove(shared.threads.begin(), shared.threads.end(), &list), shared.threads.end());
+	list.closed = true;
+}
+
+
+//
+//	OtSlabAllocator::getStatistics
+//
+
+OtSlabAllocator::Statistics OtSlabAllocator::getStatistics() {
+	auto& shared = getShared();
+	std::lock_guard<std::mutex> lock(shared.mutex);
+
+	// start with the counters of threads that ended
+	int64_t blocks[sizeClasses];
+	int64_t largeBlocks = shared.largeAllocations - shared.largeReleases;
+	int64_t largeBytes = shared.largeBytes;
+
+	for (size_t i = 0; i < sizeClasses; i++) {
+		blocks[i] = shared.allocations[i] - shared.releases[i];
+	}
+
+	// add the counters of active threads
+	for (auto thread : shared.threads) {
+		auto list = static_cast<State*>(thread);
+
+		for (size_t i = 0; i < sizeClasses; i++) {
+			blocks[i] += list->classes[i].allocations.load(std::memory_order_relaxed);
+			blocks[i] -= list->classes[i].releases.load(std::memory_order_relaxed);
+		}
+
+		largeBlocks += list->largeAllocations.load(std::memory_order_relaxed);
+		largeBlocks -= list->largeReleases.load(std::memory_order_relaxed);
+		largeBytes += list->largeBytes.load(std::memory_order_relaxed);
+	}
+
+	// assemble the statistics
+	Statistics statistics;
+
+	for (size_t i = 0; i < sizeClasses; i++) {
+		statistics.classBlocks[i] = static_cast<size_t>(std::max(blocks[i], int64_t(0)));
+		statistics.liveBlocks += statistics.classBlocks[i];
+		statistics.liveBytes += statistics.classBlocks[i] * getBlockSize(i);
+	}
+
+	statistics.largeBlocks = static_cast<size_t>(std::max(largeBlocks, int64_t(0)));
+	statistics.largeBytes = static_cast<size_t>(std::max(largeBytes, int64_t(0)));
+	statistics.slabs = shared.slabs;
+	statistics.slabBytes = shared.slabs * slabSize;
+	return statistics;
+}
@@ -0,0 +1,152 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+#pragma once
+
+
+//
+//	Include files
+//
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+
+//
+//	OtSlabAllocator
+//
+//	Allocator for small objects. Requests are rounded up to a size class and
+//	served from per-thread free lists that are refilled by carving fixed size
+//	slabs. Blocks may be released on a different thread than the one that
+//	allocated them so slabs are never returned to the heap; free blocks of
+//	threads that end are handed to the next thread that runs out. Requests
+//	larger than the biggest size class go straight to the heap.
+//
+
+class OtSlabAllocator {
+public:
+	// size classes
+	static constexpr size_t granularity = 16;
+	static constexpr size_t maxBlockSize = 256;
+	static constexpr size_t sizeClasses = maxBlockSize / granularity;
+	static constexpr size_t slabSize = 64 * 1024;
+
+	// get a block of memory
+	static inline void* allocate(size_t size) {
+		if (size > maxBlockSize) {
+			auto& list = state;
+			bump(list.largeAllocations);
+			bump(list.largeBytes, size);
+			return ::operator new(size);
+		}
+
+		auto sizeClass = getSizeClass(size);
+		auto& list = state;
+		auto& entry = list.classes[sizeClass];
+
+		if (entry.head && !list.closed) {
+			auto block = entry.head;
+			entry.head = block->next;
+			bump(entry.allocations);
+			return block;
+
+		} else {
+			return allocateSlow(sizeClass);
+		}
+	}
+
+	// return a block of memory
+	static inline void release(void* pointer, size_t size) {
+		auto& list = state;
+
+		if (size > maxBlockSize) {
+			bump(list.largeReleases);
+			bump(list.largeBytes, -static_cast<int64_t>(size));
+			::operator delete(pointer);
+			return;
+		}
+
+		auto sizeClass = getSizeClass(size);
+
+		if (list.registered && !list.closed) {
+			auto& entry = list.classes[sizeClass];
+			auto block = static_cast<Block*>(pointer);
+			block->next = entry.head;
+			entry.head = block;
+			bump(entry.releases);
+
+		} else {
+			releaseSlow(pointer, sizeClass);
+		}
+	}
+
+	// allocator statistics (summed over all threads)
+	struct Statistics {
+		size_t liveBlocks = 0;
+		size_t liveBytes = 0;
+		size_t largeBlocks = 0;
+		size_t largeBytes = 0;
+		size_t slabs = 0;
+		size_t slabBytes = 0;
+		size_t classBlocks[sizeClasses] = {};
+	};
+
+	static Statistics getStatistics();
+
+	// get the size of the blocks in a size class
+	static constexpr size_t getBlockSize(size_t sizeClass) { return (sizeClass + 1) * granularity; }
+
+private:
+	// a block on a free list
+	struct Block {
+		Block* next;
+	};
+
+	// counters are only written by their owning thread but they can be read by others
+	using Counter = std::atomic<int64_t>;
+
+	static inline void bump(Counter& counter, int64_t amount=1) {
+		counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+	}
+
+	// per-thread state (trivially destructible so it is still usable during thread teardown)
+	struct SizeClass {
+		Block* head;
+		Counter allocations;
+		Counter releases;
+	};
+
+	struct State {
+		SizeClass classes[sizeClasses];
+		Counter largeAllocations;
+		Counter largeReleases;
+		Counter largeBytes;
+		bool registered;
+		bool closed;
+	};
+
+	static inline thread_local State state{};
+
+	// determine size class for a request
+	static constexpr size_t getSizeClass(size_t size) { return size ? (size - 1) / granularity : 0; }
+
+	// slow paths
+	static void* allocateSlow(size_t sizeClass);
+	static void releaseSlow(void* pointer, size_t sizeClass);
+
+	// register thread state and clean up when a thread ends
+	static void registerThread();
+	static void unregisterThread();
+
+	struct Cleanup {
+		~Cleanup() { unregisterThread(); }
+	};
+
+	static inline thread_local Cleanup cleanup;
+};
@@ -0,0 +1,147 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+#pragma once
+
+
+//
+//	Include files
+//
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include <uv.h>
+
+
+//
+//	OtSpscQueue
+//
+//	Bounded lock-free ring for a single producer and a single consumer. Both
+//	sides keep a private copy of the other side's position so they only touch
+//	the shared one when the ring looks full or empty. Nothing ever blocks: a
+//	push fails when the ring is full and a pop fails when it's empty. A
+//	consumer that runs on a libuv loop can have producers wake it up through
+//	an async handle (once per push or batch).
+//
+
+template <typename T>
+class OtSpscQueue {
+public:
+	// constructor (the capacity is rounded up to a power of two)
+	explicit OtSpscQueue(size_t capacity) {
+		size_t size = 2;
+
+		while (size < capacity) {
+			size *= 2;
+		}
+
+		mask = size - 1;
+		slots = std::make_unique<T[]>(size);
+	}
+
+	OtSpscQueue(const OtSpscQueue&) = delete;
+	OtSpscQueue& operator=(const OtSpscQueue&) = delete;
+
+	// wake up a consumer on a libuv loop after every push (the handle must outlive the producers' use of the queue)
+	inline void setWakeup(uv_async_t* handle) { wakeup = handle; }
+
+	// add an item (only called by the producer, returns false if the queue is full)
+	inline bool tryPush(T&& value) {
+		if (!pushItems(&value, 1)) {
+			return false;
+		}
+
+		wake();
+		return true;
+	}
+
+	inline bool tryPush(const T& value) {
+		T copy = value;
+		return tryPush(std::move(copy));
+	}
+
+	// add as many of the items as fit (only called by the producer, returns the number added)
+	inline size_t pushN(T* values, size_t count) {
+		auto pushed = pushItems(values, count);
+
+		if (pushed) {
+			wake();
+		}
+
+		return pushed;
+	}
+
+	// take an item (only called by the consumer, returns false if the queue is empty)
+	inline bool tryPop(T& value) {
+		return popN(&value, 1) == 1;
+	}
+
+	// take up to the specified number of items (only called by the consumer, returns the number taken)
+	inline size_t popN(T* values, size_t count) {
+		auto position = tail.load(std::memory_order_relaxed);
+
+		if (cachedHead - position < count) {
+			cachedHead = head.load(std::memory_order_acquire);
+		}
+
+		auto available = std::min(count, cachedHead - position);
+
+		for (size_t i = 0; i < available; i++) {
+			values[i] = std::move(slots[(position + i) & mask]);
+		}
+
+		tail.store(position + available, std::memory_order_release);
+		return available;
+	}
+
+	// get the number of queued items (only exact when both sides are idle)
+	inline size_t size() const { return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire); }
+	inline bool empty() const { return size() == 0; }
+	inline size_t getCapacity() const { return mask + 1; }
+
+private:
+	// add items to the ring
+	inline size_t pushItems(T* values, size_t count) {
+		auto position = head.load(std::memory_order_relaxed);
+		auto capacity = mask + 1;
+
+		if (capacity - (position - cachedTail) < count) {
+			cachedTail = tail.load(std::memory_order_acquire);
+		}
+
+		auto available = std::min(count, capacity - (position - cachedTail));
+
+		for (size_t i = 0; i < available; i++) {
+			slots[(position + i) & mask] = std::move(values[i]);
+		}
+
+		head.store(position + available, std::memory_order_release);
+		return available;
+	}
+
+	// wake up the consumer (if required)
+	inline void wake() {
+		if (wakeup) {
+			uv_async_send(wakeup);
+		}
+	}
+
+	// the ring
+	std::unique_ptr<T[]> slots;
+	size_t mask;
+	uv_async_t* wakeup = nullptr;
+
+	// the producer's and the consumer's positions (on different cache lines, each with a copy of the other)
+	alignas(64) std::atomic<size_t> head{0};
+	size_t cachedTail = 0;
+	alignas(64) std::atomic<size_t> tail{0};
+	size_t cachedHead = 0;
+};
@@ -21,12 +21,21 @@
 //
 
 void OtStderrMultiplexer::multiplex(OtLog::Type type, const std::string& message) {
+	write(encode(type, message));
+}
+
+
+//
+//	OtStderrMultiplexer::encode
+//
+
+std::string OtStderrMultiplexer::encode(OtLog::Type type, const std::string& message) {
 	nlohmann::json json = {
 		{"type", type},
 		{"message", message}
 	};
 
-	send(MessageType::logMessage, json.dump());
+	return frame(MessageType::logMessage, json.dump());
 }
 
 
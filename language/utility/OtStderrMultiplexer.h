@@ -32,6 +32,9 @@ public:
 	static inline void multiplex(const std::string& message) { send(MessageType::debuggerMessage, message); }
 	static inline void multiplex(OtException& exception) { send(MessageType::exceptionMessage, exception.serialize()); }
 
+	// encode a log message (for callers that write to stderr themselves)
+	static std::string encode(OtLog::Type type, const std::string& message);
+
 	// de-multiplex stderr stream
 	static inline void deMultiplex(
 		std::string input,
@@ -55,9 +58,17 @@ private:
 	std::string buffer;
 	bool inMessage = false;
 
-	// send multiplexed line on stderr
-	static void send(MessageType type, const std::string& message) {
-		std::cerr << '\x02' << static_cast<char>(type) << message << '\x03' << std::flush;
+	// frame a message
+	static inline std::string frame(MessageType type, const std::string& message) {
+		return std::string("\x02") + static_cast<char>(type) + message + '\x03';
+	}
+
+	// send multiplexed line on stderr (in a single write so messages from different threads don't get mixed up)
+	static inline void send(MessageType type, const std::string& message) { write(frame(type, message)); }
+
+	static inline void write(const std::string& text) {
+		std::cerr.write(text.data(), static_cast<std::streamsize>(text.size()));
+		std::cerr.flush();
 	}
 
 	// de-multiplex stderr stream
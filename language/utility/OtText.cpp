@@ -9,6 +9,7 @@
 //	Include files
 //
 
+#include <cstdio>
 #include <fstream>
 #include <iomanip>
 #include <string>
@@ -442,34 +443,49 @@ std::string OtText::decodeURL(const std::string& text) {
 //
 
 std::string OtText::toJSON(const std::string& text) {
-	std::ostringstream o;
-	o << '"';
+	std::string output;
+	toJSON(output, text);
+	return output;
+}
+
+void OtText::toJSON(std::string& output, const std::string& text) {
+	output.push_back('"');
 	auto end = text.end();
 
 	for (auto c = text.begin(); c != end; c += OtCodePoint::size(c)) {
 		switch (*c) {
-			case '"': o << "\\\""; break;
-			case '\\': o << "\\\\"; break;
-			case '\b': o << "\\b"; break;
-			case '\f': o << "\\f"; break;
-			case '\n': o << "\\n"; break;
-			case '\r': o << "\\r"; break;
-			case '\t': o << "\\t"; break;
+			case '"': output.append("\\\""); break;
+			case '\\': output.append("\\\\"); break;
+			case '\b': output.append("\\b"); break;
+			case '\f': output.append("\\f"); break;
+			case '\n': output.append("\\n"); break;
+			case '\r': output.append("\\r"); break;
+			case '\t': output.append("\\t"); break;
 
 			default:
 				if (*c & 0x80) {
 					char32_t codepoint;
 					OtCodePoint::read(c, end, &codepoint);
-					o << "\\u" << std::hex << std::setw(4) << std::setfill('0') << codepoint;
+					char hex[16];
+
+					if (codepoint > 0xffff) {
+						// characters outside the basic multilingual plane are written as surrogate pairs
+						auto value = static_cast<unsigned int>(codepoint - 0x10000);
+						std::snprintf(hex, sizeof(hex), "\\u%04x\\u%04x", 0xd800 + (value >> 10), 0xdc00 + (value & 0x3ff));
+
+					} else {
+						std::snprintf(hex, sizeof(hex), "\\u%04x", static_cast<unsigned int>(codepoint));
+					}
+
+					output.append(hex);
 
 				} else {
-					o << *c;
+					output.push_back(*c);
 				}
 		}
 	}
 
-	o << '"';
-	return o.str();
+	output.push_back('"');
 }
 
 
@@ -129,5 +129,6 @@ public:
 
 	//	JSON Conversion Functions
 	static std::string toJSON(const std::string& text);
+	static void toJSON(std::string& output, const std::string& text);
 	static std::string fromJSON(const std::string text);
 };
@@ -0,0 +1,360 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+//
+//	Include files
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+
+#include "OtLog.h"
+#include "OtTrace.h"
+
+
+//
+//	Events
+//
+
+enum class OtTraceEventType : uint8_t {
+	begin,
+	end,
+	counter,
+	flowStart,
+	flowStep,
+	flowEnd
+};
+
+struct OtTraceEvent {
+	const char* name;
+	int64_t time;
+	uint64_t id;
+	double value;
+	OtTraceEventType type;
+	char detail[39];
+};
+
+
+//
+//	Per thread event buffers
+//
+//	A buffer is only written by its own thread. Writers publish how many
+//	events they have written and the exporter uses that to skip events that
+//	were overwritten while it was copying them.
+//
+
+struct OtTraceBuffer {
+	static constexpr size_t capacity = 16384;
+
+	OtTraceBuffer(int64_t t) : thread(t) {}
+
+	// (events are allocated when they are first recorded so naming a thread doesn't cost memory)
+	inline OtTraceEvent& next() {
+		if (!events) {
+			events = std::make_unique<OtTraceEvent[]>(capacity);
+		}
+
+		return events[written.load(std::memory_order_relaxed) % capacity];
+	}
+
+	inline void commit() { written.store(written.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+	std::unique_ptr<OtTraceEvent[]> events;
+	std::atomic<uint64_t> written{0};
+	int64_t thread;
+	std::string name;
+};
+
+
+//
+//	The trace (shared by all threads)
+//
+
+struct OtTraceRegistry {
+	std::mutex mutex;
+	std::vector<std::shared_ptr<OtTraceBuffer>> buffers;
+	std::atomic<int64_t> startTime{0};
+	std::atomic<uint64_t> flows{0};
+	int64_t threads = 0;
+};
+
+static OtTraceRegistry& getRegistry() {
+	// never freed as threads can end during static destruction
+	static OtTraceRegistry* registry = new OtTraceRegistry;
+	return *registry;
+}
+
+static thread_local std::shared_ptr<OtTraceBuffer> threadBuffer;
+
+std::atomic<bool> OtTrace::running{false};
+
+
+//
+//	Helpers
+//
+
+static inline int64_t getTime() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static OtTraceBuffer& getBuffer() {
+	if (!threadBuffer) {
+		auto& registry = getRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		threadBuffer = std::make_shared<OtTraceBuffer>(++registry.threads);
+		registry.buffers.emplace_back(threadBuffer);
+	}
+
+	return *threadBuffer;
+}
+
+static inline void record(OtTraceEventType type, const char* name, uint64_t id=0, double value=0.0, std::string_view detail={}) {
+	auto& buffer = getBuffer();
+	auto& event = buffer.next();
+	event.name = name;
+	event.time = getTime();
+	event.id = id;
+	event.value = value;
+	event.type = type;
+
+	auto size = std::min(detail.size(), sizeof(event.detail) - 1);
+	std::memcpy(event.detail, detail.data(), size);
+	event.detail[size] = 0;
+
+	buffer.commit();
+}
+
+
+//
+//	OtTrace::start
+//
+
+void OtTrace::start() {
+	auto& registry = getRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+
+	// forget the buffers of threads that have ended (events of earlier traces are skipped by their timestamps)
+	registry.buffers.erase(
+		std::remove_if(registry.buffers.begin(), registry.buffers.end(), [](auto& buffer) { return buffer.use_count() == 1; }),
+		registry.buffers.end());
+
+	registry.startTime.store(getTime(), std::memory_order_relaxed);
+	running.store(true, std::memory_order_release);
+}
+
+
+//
+//	OtTrace::stop
+//
+
+void OtTrace::stop() {
+	running.store(false, std::memory_order_release);
+}
+
+
+//
+//	OtTrace::setThreadName
+//
+
+void OtTrace::setThreadName(const std::string& name) {
+	auto& buffer = getBuffer();
+	std::lock_guard<std::mutex> lock(getRegistry().mutex);
+	buffer.name = name;
+}
+
+
+//
+//	OtTrace::beginZone
+//
+
+void OtTrace::beginZone(const char* name, std::string_view detail) {
+	record(OtTraceEventType::begin, name, 0, 0.0, detail);
+}
+
+
+//
+//	OtTrace::endZone
+//
+
+void OtTrace::endZone() {
+	record(OtTraceEventType::end, nullptr);
+}
+
+
+//
+//	OtTrace::counter
+//
+
+void OtTrace::counter(const char* name, double value) {
+	if (isRunning()) {
+		record(OtTraceEventType::counter, name, 0, value);
+	}
+}
+
+
+//
+//	OtTrace::newFlow
+//
+
+uint64_t OtTrace::newFlow() {
+	return getRegistry().flows.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+
+//
+//	OtTrace::flowStart
+//
+
+void OtTrace::flowStart(const char* name, uint64_t id) {
+	if (isRunning()) {
+		record(OtTraceEventType::flowStart, name, id);
+	}
+}
+
+
+//
+//	OtTrace::flowStep
+//
+
+void OtTrace::flowStep(const char* name, uint64_t id) {
+	if (isRunning()) {
+		record(OtTraceEventType::flowStep, name, id);
+	}
+}
+
+
+//
+//	OtTrace::flowEnd
+//
+
+void OtTrace::flowEnd(const char* name, uint64_t id) {
+	if (isRunning()) {
+		record(OtTraceEventType::flowEnd, name, id);
+	}
+}
+
+
+//
+//	OtTrace::writeJSON
+//
+
+void OtTrace::writeJSON(std::ostream& stream) {
+	auto& registry = getRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	auto startTime = registry.startTime.load(std::memory_order_relaxed);
+	auto events = nlohmann::json::array();
+
+	for (auto& buffer : registry.buffers) {
+		auto tid = buffer->thread;
+
+		// name the thread
+		events.push_back({
+			{"ph", "M"},
+			{"name", "thread_name"},
+			{"pid", 1},
+			{"tid", tid},
+			{"args", {{"name", buffer->name.size() ? buffer->name : "thread " + std::to_string(tid)}}}
+		});
+
+		// copy the events (this thread may still be adding events)
+		auto written = buffer->written.load(std::memory_order_acquire);
+
+		if (!written) {
+			continue;
+		}
+
+		auto first = written > OtTraceBuffer::capacity ? written - OtTraceBuffer::capacity : 0;
+		std::vector<OtTraceEvent> copy;
+
+		for (auto i = first; i < written; i++) {
+			copy.emplace_back(buffer->events[i % OtTraceBuffer::capacity]);
+		}
+
+		// skip the events that were overwritten while we were copying them
+		auto now = buffer->written.load(std::memory_order_acquire);
+		auto valid = now > OtTraceBuffer::capacity ? now - OtTraceBuffer::capacity : 0;
+		auto skip = valid > first ? std::min(static_cast<size_t>(valid - first), copy.size()) : 0;
+
+		// ends of zones that started before the oldest event are left out
+		size_t depth = 0;
+
+		for (auto event = copy.begin() + static_cast<std::ptrdiff_t>(skip); event != copy.end(); event++) {
+			if (event->time < startTime) {
+				continue;
+			}
+
+			auto ts = static_cast<double>(event->time - startTime) / 1000.0;
+
+			switch (event->type) {
+				case OtTraceEventType::begin: {
+					nlohmann::json entry = {{"ph", "B"}, {"name", event->name}, {"pid", 1}, {"tid", tid}, {"ts", ts}};
+
+					if (event->detail[0]) {
+						entry["args"] = {{"detail", event->detail}};
+					}
+
+					events.push_back(entry);
+					depth++;
+					break;
+				}
+
+				case OtTraceEventType::end:
+					if (depth) {
+						events.push_back({{"ph", "E"}, {"pid", 1}, {"tid", tid}, {"ts", ts}});
+						depth--;
+					}
+
+					break;
+
+				case OtTraceEventType::counter:
+					events.push_back({{"ph", "C"}, {"name", event->name}, {"pid", 1}, {"tid", tid}, {"ts", ts}, {"args", {{"value", event->value}}}});
+					break;
+
+				case OtTraceEventType::flowStart:
+					events.push_back({{"ph", "s"}, {"name", event->name}, {"cat", "flow"}, {"id", event->id}, {"pid", 1}, {"tid", tid}, {"ts", ts}});
+					break;
+
+				case OtTraceEventType::flowStep:
+					events.push_back({{"ph", "t"}, {"name", event->name}, {"cat", "flow"}, {"id", event->id}, {"pid", 1}, {"tid", tid}, {"ts", ts}});
+					break;
+
+				case OtTraceEventType::flowEnd:
+					events.push_back({{"ph", "f"}, {"bp", "e"}, {"name", event->name}, {"cat", "flow"}, {"id", event->id}, {"pid", 1}, {"tid", tid}, {"ts", ts}});
+					break;
+			}
+		}
+	}
+
+	nlohmann::json data = {
+		{"traceEvents", events},
+		{"displayTimeUnit", "ns"}
+	};
+
+	stream << data.dump() << '\n';
+}
+
+
+//
+//	OtTrace::save
+//
+
+void OtTrace::save(const std::string& path) {
+	std::ofstream stream(path);
+
+	if (!stream) {
+		OtLogError("Can't write trace to [{}]", path);
+	}
+
+	writeJSON(stream);
+}
@@ -0,0 +1,117 @@
+//	ObjectTalk Scripting Language
+//	Copyright (c) 1993-2025 Johan A. Goossens. All rights reserved.
+//
+//	This work is licensed under the terms of the MIT license.
+//	For a copy, see <https://opensource.org/licenses/MIT>.
+
+
+#pragma once
+
+
+//
+//	Include files
+//
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+
+//
+//	OtTrace
+//
+//	Instrumentation for finding out where the time in a frame or a request
+//	goes. Code marks nestable zones (see the OtTraceZone macro), counters and
+//	flow events (which connect work that is handed from one zone to another,
+//	possibly on another thread). Events are recorded with nanosecond
+//	timestamps in a ring buffer per thread so threads never wait for each
+//	other (a thread's oldest events are overwritten when it records a lot).
+//	Tracing is off until it is started and costs a single check per zone
+//	when it's off. Traces are written in the Chrome trace event format that
+//	chrome://tracing and Perfetto can open.
+//
+//	Names must be string literals (or otherwise live forever) as only their
+//	pointers are recorded. Zones can have a short detail text that is copied.
+//
+
+class OtTrace {
+public:
+	// start recording (this discards earlier events)
+	static void start();
+
+	// stop recording
+	static void stop();
+
+	// see if we are recording
+	static inline bool isRunning() { return running.load(std::memory_order_relaxed); }
+
+	// name the calling thread in the trace
+	static void setThreadName(const std::string& name);
+
+	// record zones (use OtTraceZone instead of calling these directly)
+	static void beginZone(const char* name, std::string_view detail={});
+	static void endZone();
+
+	// record the value of a counter
+	static void counter(const char* name, double value);
+
+	// get a new flow identifier and record the start, intermediate steps and end of a flow
+	static uint64_t newFlow();
+	static void flowStart(const char* name, uint64_t id);
+	static void flowStep(const char* name, uint64_t id);
+	static void flowEnd(const char* name, uint64_t id);
+
+	// write the trace in Chrome's trace event format
+	static void writeJSON(std::ostream& stream);
+	static void save(const std::string& path);
+
+private:
+	static std::atomic<bool> running;
+};
+
+
+//
+//	OtTraceScope
+//
+
+class OtTraceScope {
+public:
+	// constructors/destructor
+	inline OtTraceScope(const char* name) : active(OtTrace::isRunning()) {
+		if (active) {
+			OtTrace::beginZone(name);
+		}
+	}
+
+	inline OtTraceScope(const char* name, std::string_view detail) : active(OtTrace::isRunning()) {
+		if (active) {
+			OtTrace::beginZone(name, detail);
+		}
+	}
+
+	inline ~OtTraceScope() {
+		if (active) {
+			OtTrace::endZone();
+		}
+	}
+
+	OtTraceScope(const OtTraceScope&) = delete;
+	OtTraceScope& operator=(const OtTraceScope&) = delete;
+
+private:
+	// a zone that starts while tracing is off never ends either
+	bool active;
+};
+
+
+//
+//	Macros
+//
+
+#define OT_TRACE_CONCAT2(a, b) a##b
+#define OT_TRACE_CONCAT(a, b) OT_TRACE_CONCAT2(a, b)
+
+// trace the rest of the enclosing scope as a zone (with a name and an optional detail)
+#define OtTraceZone(...) OtTraceScope OT_TRACE_CONCAT(otTraceZone, __LINE__)(__VA_ARGS__)
@@ -9,8 +9,11 @@
 //	Include files
 //
 
+#include <algorithm>
 #include <cstring>
+#include <iostream>
 #include <string>
+#include <vector>
 
 #ifndef _WIN32
 #include <signal.h>
@@ -20,10 +23,18 @@
 
 #include "OtConfig.h"
 #include "OtException.h"
+#include "OtJit.h"
+#include "OtJitCompare.h"
 #include "OtLibuv.h"
 #include "OtPath.h"
+#include "OtProfiler.h"
 #include "OtStderrMultiplexer.h"
 #include "OtModule.h"
+#include "OtTrace.h"
+
+#if OT_VM_STATISTICS
+#include "OtVMStatistics.h"
+#endif
 
 #if defined(OT_INCLUDE_UI)
 #include "OtFramework.h"
@@ -77,17 +88,62 @@ int main(int argc, char* argv[]) {
 	// parse all command line parameters
 	argparse::ArgumentParser program(argv[0], "0.4");
 	bool childProcessFlag = false;
+	bool noCacheFlag = false;
+	bool jitFlag = false;
+	bool jitCompareFlag = false;
 	std::string logFile;
+	std::string profileFile;
+	std::string traceFile;
+
+#if OT_VM_STATISTICS
+	std::string statisticsFile;
+#endif
 
 	program.add_argument("-c", "--child")
 		.help("run as an IDE child process")
 		.store_into(childProcessFlag);
 
+	program.add_argument("-n", "--no-cache")
+		.help("don't use the compiled bytecode cache")
+		.store_into(noCacheFlag);
+
+	program.add_argument("-j", "--jit")
+		.help("compile hot functions to native code (on x86-64 only)")
+		.store_into(jitFlag);
+
+	program.add_argument("--jit-threshold")
+		.help("number of calls and loop iterations before a function is compiled")
+		.metavar("count")
+		.default_value(1000)
+		.scan<'i', int>();
+
+	program.add_argument("--jit-compare")
+		.help("run the script with the interpreter and the just-in-time compiler and compare the results")
+		.store_into(jitCompareFlag);
+
 	program.add_argument("-l", "--log")
 		.help("specify a file to send log to")
 		.metavar("filename")
 		.store_into(logFile);
 
+	program.add_argument("-p", "--profile")
+		.help("profile the script and write the samples (in collapsed stack format) to a file")
+		.metavar("filename")
+		.store_into(profileFile);
+
+	program.add_argument("-t", "--trace")
+		.help("record trace zones and write them (in Chrome trace format) to a file at exit")
+		.metavar("filename")
+		.store_into(traceFile);
+
+#if OT_VM_STATISTICS
+	program.add_argument("-s", "--statistics")
+		.help("write the virtual machine's execution statistics (in JSON format) to a file")
+		.metavar("filename")
+		.default_value(std::string("ot-statistics.json"))
+		.store_into(statisticsFile);
+#endif
+
 	program.add_argument("files")
 		.help("files to process")
 		.remaining();
@@ -110,16 +166,64 @@ int main(int argc, char* argv[]) {
 
 	// set configuration
 	OtConfig::setSubprocessMode(childProcessFlag);
+	OtConfig::setByteCodeCache(!noCacheFlag);
+	OtConfig::setJit(jitFlag);
+	OtConfig::setJitThreshold(static_cast<size_t>(std::max(program.get<int>("--jit-threshold"), 0)));
+
+	if (jitFlag && !OtJit::isSupported()) {
+		OtLogWarning("The just-in-time compiler is not available on this platform, the interpreter is used instead");
+	}
+
+	// run the differential test (if required)
+	if (jitCompareFlag) {
+		if (files.size() != 1) {
+			OtLogFatal("Error: the differential test needs exactly one script");
+		}
+
+		return OtJitCompare::run(files[0], noCacheFlag);
+	}
 
 	// log to file (if required)
 	if (logFile.size()) {
 		OtLog::setFileLogging(logFile);
 	}
 
+	// write the profile, the trace and the statistics (if required)
+	auto saveReports = [&]() {
+		if (profileFile.size()) {
+			OtProfiler::stop();
+			OtProfiler::save(profileFile);
+
+			if (!OtConfig::inSubprocessMode()) {
+				OtProfiler::writeSummary(std::cerr);
+			}
+		}
+
+		if (traceFile.size()) {
+			OtTrace::stop();
+			OtTrace::save(traceFile);
+		}
+
+#if OT_VM_STATISTICS
+		OtVMStatistics::save(statisticsFile);
+#endif
+	};
+
 	try {
 		// initialize libuv
 		OtLibUv::init(argc, argv);
 
+		// start the profiler (if required)
+		if (profileFile.size()) {
+			OtProfiler::start();
+		}
+
+		// start tracing (if required)
+		if (traceFile.size()) {
+			OtTrace::setThreadName("main");
+			OtTrace::start();
+		}
+
 #if defined(OT_INCLUDE_UI)
 		//
 		// UI configuration
@@ -133,6 +237,7 @@ int main(int argc, char* argv[]) {
 				// check file extension
 				if (extension == ".ot" || extension == "") {
 					// compile and run script as a module
+					OtTraceZone("run script", file);
 					auto module = OtModule::create();
 					module->load(file);
 					module->unsetAll();
@@ -190,6 +295,7 @@ int main(int argc, char* argv[]) {
 
 			if (extension == ".ot") {
 				// compile and run script as a module
+				OtTraceZone("run script", file);
 				auto module = OtModule::create();
 				module->load(file);
 				module->unsetAll();
@@ -202,8 +308,16 @@ int main(int argc, char* argv[]) {
 
 		// cleanup
 		OtLibUv::end();
+		saveReports();
 
 	} catch (OtException& e) {
+		// a profile of a failing script can still be useful
+		try {
+			saveReports();
+
+		} catch (OtException&) {
+		}
+
 		// send exception back to IDE (if required)
 		if (OtConfig::inSubprocessMode()) {
 			OtStderrMultiplexer::multiplex(e);
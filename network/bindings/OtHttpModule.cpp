@@ -73,7 +73,7 @@ public:
 
 	// get type definition
 	static OtType getMeta() {
-		static OtType type;
+		thread_local OtType type;
 
 		if (!type) {
 			type = OtType::create<OtUrlClass>("URL", OtHttpClass::getMeta());
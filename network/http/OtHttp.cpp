@@ -17,7 +17,7 @@
 //
 
 OtType OtHttpClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtHttpClass>("Http", OtObjectClass::getMeta());
@@ -34,7 +34,7 @@ public:
 
 	// get type definition
 	static OtType getMeta() {
-		static OtType type;
+		thread_local OtType type;
 
 		if (!type) {
 			type = OtType::create<OtHttpNextClass>("HttpNext", OtInternalClass::getMeta());
@@ -44,6 +44,10 @@ public:
 		return type;
 	}
 
+	// cycle collector support
+	inline void traverse(OtObjectTraverser& traverser) override { OtInternalClass::traverse(traverser); traverser(req); traverser(res); traverser(next); }
+	inline void clearReferences() override { OtInternalClass::clearReferences(); req = nullptr; res = nullptr; next = nullptr; }
+
 protected:
 	// constructors
 	friend class OtObjectPointer<OtHttpNextClass>;
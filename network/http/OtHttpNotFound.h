@@ -34,7 +34,7 @@ public:
 
 	// get type definition
 	static OtType getMeta() {
-		static OtType type;
+		thread_local OtType type;
 
 		if (!type) {
 			type = OtType::create<OtHttpNotFoundClass>("HttpNotFound", OtInternalClass::getMeta());
@@ -44,6 +44,10 @@ public:
 		return type;
 	}
 
+	// cycle collector support
+	inline void traverse(OtObjectTraverser& traverser) override { OtInternalClass::traverse(traverser); traverser(res); }
+	inline void clearReferences() override { OtInternalClass::clearReferences(); res = nullptr; }
+
 protected:
 	// constructors
 	friend class OtObjectPointer<OtHttpNotFoundClass>;
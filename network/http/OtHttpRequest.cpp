@@ -281,7 +281,7 @@ void OtHttpRequestClass::onMultipartHeadersComplete() {
 					std::string tmpl = OtPath::join(OtPath::getTmpDirectory(), "ot-XXXXXX");
 
 					uv_fs_t req;
-					uv_fs_mkstemp(uv_default_loop(), &req, tmpl.c_str(), 0);
+					uv_fs_mkstemp(OtLibUv::getLoop(), &req, tmpl.c_str(), 0);
 					multipartFile = req.path;
 					multipartFD = (uv_file) req.result;
 					uv_fs_req_cleanup(&req);
@@ -568,7 +568,7 @@ std::string OtHttpRequestClass::debug() {
 //
 
 OtType OtHttpRequestClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtHttpRequestClass>("HttpRequest", OtHttpClass::getMeta());
@@ -16,6 +16,7 @@
 #include "OtLog.h"
 #include "OtMimeTypes.h"
 #include "OtPath.h"
+#include "OtTrace.h"
 
 
 //
@@ -32,6 +33,7 @@ void OtHttpResponseClass::setStream(uv_stream_t* s) {
 //
 
 void OtHttpResponseClass::clear() {
+	traceFlow = OtTrace::newFlow();
 	responseState = ResponseState::start;
 	setStatus(404);
 	headers.clear();
@@ -220,6 +222,9 @@ OtObject OtHttpResponseClass::write(const std::string& data) {
 //
 
 OtObject OtHttpResponseClass::end() {
+	OtTraceZone("http response end");
+	OtTrace::flowEnd("http response", traceFlow);
+
 	if (responseState == ResponseState::start) {
 		headers.emplace("Content-Type", "text/plain");
 		headers.emplace("Content-Length", std::to_string(explanation.size()));
@@ -286,7 +291,7 @@ OtObject OtHttpResponseClass::sendFile(const std::string& name) {
 
 		// open file
 		uv_fs_t open_req;
-		auto status = uv_fs_open(uv_default_loop(), &open_req, name.c_str(), O_RDONLY, 0, nullptr);
+		auto status = uv_fs_open(OtLibUv::getLoop(), &open_req, name.c_str(), O_RDONLY, 0, nullptr);
 		UV_CHECK_ERROR("uv_fs_open", status);
 		uv_fs_req_cleanup(&open_req);
 		uv_read_fd = (uv_file) open_req.result;
@@ -295,7 +300,7 @@ OtObject OtHttpResponseClass::sendFile(const std::string& name) {
 		uv_read_buffer = (char*) malloc(64 * 1024);
 		uv_buf_t buffer = uv_buf_init(uv_read_buffer, 64 * 1024);
 
-		status = uv_fs_read(uv_default_loop(), &uv_read_req, uv_read_fd, &buffer, 1, -1, [](uv_fs_t* req) {
+		status = uv_fs_read(OtLibUv::getLoop(), &uv_read_req, uv_read_fd, &buffer, 1, -1, [](uv_fs_t* req) {
 			uv_fs_req_cleanup(req);
 			((OtHttpResponseClass*)(req->data))->onFileRead(req->result);
 		});
@@ -312,6 +317,9 @@ OtObject OtHttpResponseClass::sendFile(const std::string& name) {
 //
 
 void OtHttpResponseClass::onFileRead(ssize_t size) {
+	OtTraceZone("http send file");
+	OtTrace::flowStep("http response", traceFlow);
+
 	if (size > 0) {
 		// write file to socket
 		write(uv_read_buffer, size);
@@ -319,7 +327,7 @@ void OtHttpResponseClass::onFileRead(ssize_t size) {
 		// continue reading
 		uv_buf_t buffer = uv_buf_init(uv_read_buffer, 64 * 1024);
 
-		auto status = uv_fs_read(uv_default_loop(), &uv_read_req, uv_read_fd, &buffer, 1, -1, [](uv_fs_t* req) {
+		auto status = uv_fs_read(OtLibUv::getLoop(), &uv_read_req, uv_read_fd, &buffer, 1, -1, [](uv_fs_t* req) {
 			uv_fs_req_cleanup(req);
 			((OtHttpResponseClass*)(req->data))->onFileRead(req->result);
 		});
@@ -328,7 +336,7 @@ void OtHttpResponseClass::onFileRead(ssize_t size) {
 
 	} else if (size == 0) {
 		uv_fs_t close_req;
-		uv_fs_close(uv_default_loop(), &close_req, uv_read_fd, nullptr);
+		uv_fs_close(OtLibUv::getLoop(), &close_req, uv_read_fd, nullptr);
 		uv_fs_req_cleanup(&close_req);
 		free(uv_read_buffer);
 		end();
@@ -354,7 +362,7 @@ OtObject OtHttpResponseClass::sendFileToDownload(const std::string& name) {
 //
 
 OtType OtHttpResponseClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtHttpResponseClass>("HttpResponse", OtHttpClass::getMeta());
@@ -12,6 +12,7 @@
 //	Include files
 //
 
+#include <cstdint>
 #include <string>
 
 #include "OtHttp.h"
@@ -64,6 +65,9 @@ public:
 	// send a file as the response
 	OtObject sendFileToDownload(const std::string& name);
 
+	// get the identifier of the trace flow that follows the response
+	inline uint64_t getTraceFlow() { return traceFlow; }
+
 	// get type definition
 	static OtType getMeta();
 
@@ -89,4 +93,6 @@ private:
 	uv_file uv_read_fd;
 	uv_fs_t uv_read_req;
 	char* uv_read_buffer;
+
+	uint64_t traceFlow = 0;
 };
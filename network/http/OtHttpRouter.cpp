@@ -76,9 +76,11 @@ public:
 
 					if (regex_match(requestedPath, values, pattern)) {
 						for (size_t i = 1; i < values.size(); i++) {
-							req->setParam(names[i], values[i]);
+							req->setParam(names[i - 1], values[i]);
 						}
 
+						return true;
+
 					} else {
 						return false;
 					}
@@ -104,6 +106,9 @@ public:
 		}
 	}
 
+	void traverse(OtObjectTraverser& traverser) override { traverser(callback); }
+	void clearReferences() override { callback = nullptr; }
+
 private:
 	enum OtHttpHandlerType {
 		USE = 1,
@@ -257,12 +262,38 @@ OtObject OtHttpRouterClass::timer(int64_t interval, OtObject callback) {
 }
 
 
+//
+//	OtHttpRouterClass::traverse
+//
+
+void OtHttpRouterClass::traverse(OtObjectTraverser& traverser) {
+	OtHttpClass::traverse(traverser);
+
+	for (auto& handler : handlers) {
+		handler->traverse(traverser);
+	}
+}
+
+
+//
+//	OtHttpRouterClass::clearReferences
+//
+
+void OtHttpRouterClass::clearReferences() {
+	OtHttpClass::clearReferences();
+
+	for (auto& handler : handlers) {
+		handler->clearReferences();
+	}
+}
+
+
 //
 //	OtHttpRouterClass::getMeta
 //
 
 OtType OtHttpRouterClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtHttpRouterClass>("HttpRouter", OtHttpClass::getMeta());
@@ -44,6 +44,10 @@ public:
 	// set a timer
 	OtObject timer(int64_t interval, OtObject callback);
 
+	// cycle collector support (handlers often capture the server or the router)
+	void traverse(OtObjectTraverser& traverser) override;
+	void clearReferences() override;
+
 	// get type definition
 	static OtType getMeta();
 
@@ -68,6 +72,10 @@ private:
 
 		// run as a the handler
 		virtual void run([[maybe_unused]] OtHttpRequest req, [[maybe_unused]] OtHttpResponse res, [[maybe_unused]] OtObject next) {}
+
+		// report and clear the objects the handler holds
+		virtual void traverse([[maybe_unused]] OtObjectTraverser& traverser) {}
+		virtual void clearReferences() {}
 	};
 
 	// manage handlers
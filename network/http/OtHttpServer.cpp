@@ -16,28 +16,15 @@
 #include "OtHttpSession.h"
 
 
-//
-//	OtHttpServerClass::OtHttpServerClass
-//
-
-OtHttpServerClass::OtHttpServerClass() {
-	// setup our session watchdog
-	uv_timer_init(uv_default_loop(), &uv_watchdog);
-	uv_watchdog.data = this;
-
-	uv_timer_start(&uv_watchdog, [](uv_timer_t* handle) {
-		((OtHttpServerClass*) (handle->data))->cleanup();
-	}, 0, 60 * 1000);
-}
-
-
 //
 //	OtHttpServerClass::~OtHttpServerClass
 //
 
 OtHttpServerClass::~OtHttpServerClass() {
 	// stop the watchdog
-	uv_timer_stop(&uv_watchdog);
+	if (listening) {
+		uv_timer_stop(&uv_watchdog);
+	}
 }
 
 
@@ -67,7 +54,7 @@ void OtHttpServerClass::onConnect() {
 //
 
 OtObject OtHttpServerClass::listen(const std::string& ip, int port) {
-	uv_tcp_init(uv_default_loop(), &uv_server);
+	uv_tcp_init(OtLibUv::getLoop(), &uv_server);
 	uv_server.data = (void*) this;
 
 	int status;
@@ -85,6 +72,16 @@ OtObject OtHttpServerClass::listen(const std::string& ip, int port) {
 	});
 
 	UV_CHECK_ERROR("uv_listen", status);
+
+	// setup our session watchdog (servers that never listen don't need one)
+	uv_timer_init(OtLibUv::getLoop(), &uv_watchdog);
+	uv_watchdog.data = this;
+
+	uv_timer_start(&uv_watchdog, [](uv_timer_t* handle) {
+		((OtHttpServerClass*) (handle->data))->cleanup();
+	}, 0, 60 * 1000);
+
+	listening = true;
 	return OtHttpServer(this);
 }
 
@@ -106,7 +103,7 @@ void OtHttpServerClass::cleanup() {
 //
 
 OtType OtHttpServerClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtHttpServerClass>("HttpServer", OtHttpClass::getMeta());
@@ -41,19 +41,31 @@ public:
 	// cleanup connections
 	void cleanup();
 
+	// cycle collector support (a listening server is kept alive by libuv so its references are only reported before it listens)
+	inline void traverse(OtObjectTraverser& traverser) override {
+		OtHttpClass::traverse(traverser);
+
+		if (!listening) {
+			traverser(router);
+		}
+	}
+
+	inline void clearReferences() override { OtHttpClass::clearReferences(); router = nullptr; }
+
 	// get type definition
 	static OtType getMeta();
 
 protected:
 	// constructor/destructor
 	friend class OtObjectPointer<OtHttpServerClass>;
-	OtHttpServerClass();
+	OtHttpServerClass() = default;
 	~OtHttpServerClass();
 
 private:
 	// properties
 	uv_tcp_t uv_server;
 	uv_timer_t uv_watchdog;
+	bool listening = false;
 
 	OtHttpRouter router;
 	std::vector<OtHttpSession> sessions;
@@ -16,6 +16,7 @@
 #include "OtHttpSession.h"
 #include "OtLibuv.h"
 #include "OtLog.h"
+#include "OtTrace.h"
 
 
 //
@@ -80,7 +81,7 @@ OtHttpSessionClass::OtHttpSessionClass(uv_stream_t* stream, OtHttpRouter r) : ro
 	parser.data = this;
 
 	// setup client socket
-	uv_tcp_init(uv_default_loop(), &uv_client);
+	uv_tcp_init(OtLibUv::getLoop(), &uv_client);
 	uv_client.data = this;
 
 	int status = uv_accept(stream, (uv_stream_t*) &uv_client);
@@ -103,7 +104,7 @@ OtHttpSessionClass::OtHttpSessionClass(uv_stream_t* stream, OtHttpRouter r) : ro
 
 	// set session status
 	active = true;
-	lastRequest = uv_now(uv_default_loop());
+	lastRequest = uv_now(OtLibUv::getLoop());
 }
 
 
@@ -133,7 +134,7 @@ bool OtHttpSessionClass::isAlive() {
 		active = false;
 		return false;
 
-	} else if (uv_now(uv_default_loop()) - lastRequest > 60 * 1000) {
+	} else if (uv_now(OtLibUv::getLoop()) - lastRequest > 60 * 1000) {
 		close();
 	}
 
@@ -156,6 +157,8 @@ void OtHttpSessionClass::onBegin() {
 //
 
 void OtHttpSessionClass::onMessageComplete() {
+	OtTraceZone("http request", request->getPath());
+
 	// finish request
 	request->onMessageComplete();
 
@@ -167,11 +170,12 @@ void OtHttpSessionClass::onMessageComplete() {
 		response->setHeader("Keep-Alive","timeout=5, max=5");
 	}
 
-	// dispatch request
+	// dispatch request (the trace follows the response until it ends)
+	OtTrace::flowStart("http response", response->getTraceFlow());
 	router->call(request, response, OtHttpNotFound::create(response));
 
 	// track last request time
-	lastRequest = uv_now(uv_default_loop());
+	lastRequest = uv_now(OtLibUv::getLoop());
 }
 
 
@@ -209,7 +213,7 @@ void OtHttpSessionClass::onRead(const uv_buf_t* buffer, ssize_t nread) {
 //
 
 OtType OtHttpSessionClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtHttpResponseClass>("HttpSession", OtInternalClass::getMeta());
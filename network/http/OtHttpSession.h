@@ -43,6 +43,19 @@ public:
 	void onMessageComplete();
 	void onRead(const uv_buf_t* buffer, ssize_t nread);
 
+	// cycle collector support (references are only reported once the connection is closed)
+	inline void traverse(OtObjectTraverser& traverser) override {
+		OtHttpClass::traverse(traverser);
+
+		if (!active) {
+			traverser(request);
+			traverser(response);
+			traverser(router);
+		}
+	}
+
+	inline void clearReferences() override { OtHttpClass::clearReferences(); request = nullptr; response = nullptr; router = nullptr; }
+
 	// get type definition
 	static OtType getMeta();
 
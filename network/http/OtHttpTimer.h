@@ -29,7 +29,7 @@ class OtHttpTimerClass : public OtInternalClass {
 public:
 	// get type definition
 	static OtType getMeta() {
-		static OtType type;
+		thread_local OtType type;
 
 		if (!type) {
 			type = OtType::create<OtHttpTimerClass>("HttpTimer", OtInternalClass::getMeta());
@@ -38,6 +38,17 @@ public:
 		return type;
 	}
 
+	// cycle collector support (an active timer is kept alive by libuv)
+	inline void traverse(OtObjectTraverser& traverser) override {
+		OtInternalClass::traverse(traverser);
+
+		if (!uv_is_active((uv_handle_t*) &uv_timer)) {
+			traverser(callback);
+		}
+	}
+
+	inline void clearReferences() override { OtInternalClass::clearReferences(); callback = nullptr; }
+
 protected:
 	// constructor
 	friend class OtObjectPointer<OtHttpTimerClass>;
@@ -46,7 +57,7 @@ protected:
 		// sanity check
 		OtCallbackValidate(callback, 0);
 
-		uv_timer_init(uv_default_loop(), &uv_timer);
+		uv_timer_init(OtLibUv::getLoop(), &uv_timer);
 		uv_timer.data = this;
 
 		uv_timer_start(&uv_timer, [](uv_timer_t* handle) {
@@ -14,6 +14,7 @@
 #include "nlohmann/json.hpp"
 
 #include "OtException.h"
+#include "OtLog.h"
 
 #include "OtNode.h"
 
@@ -134,6 +135,7 @@ void OtNodeClass::evaluateVariableInputs(OtNodeVaryingContext& context, bool top
 
 		} catch (OtException& e) {
 			error = e.getShortErrorMessage();
+			OtLogCaughtError("Node [{}] failed: {}", title, e.what());
 		}
 	}
 }
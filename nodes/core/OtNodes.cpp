@@ -21,6 +21,7 @@
 #include "OtNodesUtils.h"
 #include "OtPath.h"
 #include "OtText.h"
+#include "OtTrace.h"
 
 
 //
@@ -716,6 +717,8 @@ void OtNodes::classifyLinks() {
 //
 
 void OtNodes::evaluate() {
+	OtTraceZone("evaluate nodes");
+
 	// see if resorting is required
 	if (needsSorting) {
 		sortNodesTopologically();
@@ -741,6 +744,8 @@ void OtNodes::evaluate() {
 		});
 
 		if (node->needsEvaluating) {
+			OtTraceZone(node->type, node->title);
+
 			try {
 				node->error.clear();
 				node->onValidate();
@@ -748,6 +753,7 @@ void OtNodes::evaluate() {
 
 			} catch (OtException& e) {
 				node->error = e.getShortErrorMessage();
+				OtLogCaughtError("Node [{}] failed: {}", node->title, e.what());
 			}
 		}
 	}
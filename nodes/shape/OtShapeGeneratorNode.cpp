@@ -157,6 +157,7 @@ public:
 		instance = nullptr;
 		hasRenderMethod = false;
 		error = e.what();
+		OtLogCaughtError("Node [{}] failed: {}", title, error);
 
 		if (e.getModule().size()) {
 			OtMessageBus::send(fmt::format("highlight {}", e.serialize()));
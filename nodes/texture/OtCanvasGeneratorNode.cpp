@@ -168,6 +168,7 @@ public:
 		instance = nullptr;
 		hasRenderMethod = false;
 		error = e.what();
+		OtLogCaughtError("Node [{}] failed: {}", title, error);
 
 		if (e.getModule().size()) {
 			OtMessageBus::send(fmt::format("highlight {}", e.serialize()));
@@ -166,7 +166,7 @@ void OtBodyClass::setBody(b2Body* b) {
 //
 
 OtType OtBodyClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtBodyClass>("Body", OtPhysics2DClass::getMeta());
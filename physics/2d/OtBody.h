@@ -53,6 +53,7 @@ public:
 
 	// get information
 	OtObject get(OtID id) override;
+	inline bool isMemberCacheable(OtID id) override { return id != xID && id != yID && id != vxID && id != vyID; }
 
 	inline float getX() { return body->GetPosition().x; }
 	inline float getY() { return body->GetPosition().y; }
@@ -40,7 +40,7 @@ void OtDynamicBodyClass::init(OtObject w) {
 //
 
 OtType OtDynamicBodyClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtDynamicBodyClass>("DynamicBody", OtBodyClass::getMeta());
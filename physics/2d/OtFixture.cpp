@@ -52,7 +52,7 @@ OtObject OtFixtureClass::setRestitution(float restitution) {
 //
 
 OtType OtFixtureClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtFixtureClass>("Fixture", OtPhysics2DClass::getMeta());
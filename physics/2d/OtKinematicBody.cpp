@@ -36,7 +36,7 @@ void OtKinematicBodyClass::init(OtObject w) {
 //
 
 OtType OtKinematicBodyClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtKinematicBodyClass>("KinematicBody", OtBodyClass::getMeta());
@@ -17,7 +17,7 @@
 //
 
 OtType OtPhysics2DClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtPhysics2DClass>("Physics2D", OtObjectClass::getMeta());
@@ -36,7 +36,7 @@ void OtStaticBodyClass::init(OtObject w) {
 //
 
 OtType OtStaticBodyClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtStaticBodyClass>("StaticBody", OtBodyClass::getMeta());
@@ -184,7 +184,7 @@ void OtWorldClass::EndContact(b2Contact* contact) {
 //
 
 OtType OtWorldClass::getMeta() {
-	static OtType type;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtWorldClass>("World", OtPhysics2DClass::getMeta());
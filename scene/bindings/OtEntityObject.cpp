@@ -116,7 +116,7 @@ OtObject OtEntityObjectClass::getMessageComponent() {
 //
 
 OtType OtEntityObjectClass::getMeta() {
-	static OtType type = nullptr;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtEntityObjectClass>("Entity", OtObjectClass::getMeta());
@@ -21,7 +21,7 @@
 //
 
 OtType OtMaterialComponentObjectClass::getMeta() {
-	static OtType type = nullptr;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtMaterialComponentObjectClass>("MaterialComponent", OtObjectClass::getMeta());
@@ -19,7 +19,7 @@
 //
 
 OtType OtMessageComponentObjectClass::getMeta() {
-	static OtType type = nullptr;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtMessageComponentObjectClass>("MessageComponent", OtObjectClass::getMeta());
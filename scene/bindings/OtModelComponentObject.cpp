@@ -168,7 +168,7 @@ float OtModelComponentObjectClass::getAnimationSpeed() {
 //
 
 OtType OtModelComponentObjectClass::getMeta() {
-	static OtType type = nullptr;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtModelComponentObjectClass>("ModelComponent", OtObjectClass::getMeta());
@@ -50,7 +50,7 @@ OtObject OtSceneObjectClass::getEntity(const std::string& tag) {
 
 OtType OtSceneObjectClass::getMeta()
 {
-	static OtType type = nullptr;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtSceneObjectClass>("Scene", OtObjectClass::getMeta());
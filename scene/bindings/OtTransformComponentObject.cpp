@@ -21,7 +21,7 @@
 //
 
 OtType OtTransformComponentObjectClass::getMeta() {
-	static OtType type = nullptr;
+	thread_local OtType type;
 
 	if (!type) {
 		type = OtType::create<OtTransformComponentObjectClass>("TransformComponent", OtObjectClass::getMeta());
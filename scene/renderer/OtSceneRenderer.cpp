@@ -10,6 +10,7 @@
 //
 
 #include "OtMeasure.h"
+#include "OtTrace.h"
 
 #include "OtSceneRenderer.h"
 
@@ -28,12 +29,15 @@ OtSceneRenderer::OtSceneRenderer() {
 //
 
 ImTextureID OtSceneRenderer::render(OtCamera& camera, OtScene* scene) {
+	OtTraceZone("render scene");
+
 	// reset rendering context
 	ctx.initialize(camera, scene, &ibl, &csm);
 	OtMeasureStopWatch stopwatch;
 
 	// update image based lighting (if required)
 	if (ctx.hasImageBasedLighting) {
+		OtTraceZone("image based lighting");
 		ibl.update(ctx.scene->getComponent<OtIblComponent>(ctx.iblEntity));
 	}
 
@@ -41,18 +45,24 @@ ImTextureID OtSceneRenderer::render(OtCamera& camera, OtScene* scene) {
 
 	// generate shadow maps (if required)
 	if (ctx.castShadow) {
+		OtTraceZone("shadow pass");
 		shadowPass.render(ctx);
 	}
 
 	shadowPassTime = stopwatch.lap();
 
 	// render background items
-	compositeBuffer.update(camera.width, camera.height);
-	backgroundPass.render(ctx);
+	{
+		OtTraceZone("background pass");
+		compositeBuffer.update(camera.width, camera.height);
+		backgroundPass.render(ctx);
+	}
+
 	backgroundPassTime = stopwatch.lap();
 
 	// render opaque entities
 	if (ctx.hasOpaqueEntities) {
+		OtTraceZone("deferred pass");
 		deferredRenderingBuffer.update(camera.width, camera.height);
 		deferredPass.render(ctx);
 	}
@@ -61,6 +71,7 @@ ImTextureID OtSceneRenderer::render(OtCamera& camera, OtScene* scene) {
 
 	// render transparent entities
 	if (ctx.hasTransparentEntities) {
+		OtTraceZone("forward pass");
 		forwardPass.render(ctx);
 	}
 
@@ -102,7 +113,13 @@ ImTextureID OtSceneRenderer::render(OtCamera& camera, OtScene* scene) {
 	editorPassTime = stopwatch.lap();
 
 	// post process frame
-	auto textureID = postProcessingPass.render(ctx);
+	ImTextureID textureID;
+
+	{
+		OtTraceZone("post processing pass");
+		textureID = postProcessingPass.render(ctx);
+	}
+
 	postProcessingTime = stopwatch.lap();
 	return textureID;
 }